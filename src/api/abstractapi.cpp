@@ -1,16 +1,89 @@
 // abstractapi.cpp
 #include "abstractapi.h"
+#include "apimetrics.h"
+#include "apitransport.h"
+#include "circuitbreaker.h"
+#include "latencytracker.h"
+#include "responsecache.h"
+#include <QCborValue>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QRandomGenerator>
+#include <QThread>
+#include <QUuid>
 #include <QUrlQuery>
 
 namespace NetworkApi {
 
+static const char *const CacheKeyProperty = "dim_cacheKey";
+static const char *const BodyProperty = "dim_body";
+static const char *const RawProperty = "dim_raw";
+static const char *const SubscribersProperty = "dim_subscribers";
+static const char *const StartedProperty = "dim_startedAt";
+static const char *const TimedOutProperty = "dim_timedOut";
+static const char *const FirstByteProperty = "dim_firstByteAt";
+static const char *const BytesInProperty = "dim_bytesIn";
+static const char *const BytesOutProperty = "dim_bytesOut";
+static const char *const StaleValidatorsProperty = "dim_staleValidators";
+static const char *const HedgeProperty = "dim_hedge";
+
+static qint64 monotonicMs()
+{
+    static QElapsedTimer clock = [] {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.elapsed();
+}
+
+// Identical GETs that are still on the wire, shared by every API instance
+static QHash<QString, QPointer<QNetworkReply>> s_inFlightGets;
+
 AbstractApi::AbstractApi(QNetworkAccessManager *netManager, QObject *parent)
     : QObject(parent)
     , m_netManager(netManager)
     , m_apiHost(QStringLiteral(DIM_API_BASE_URL))
   // , m_apiHost(QStringLiteral("http://localhost:8000"))
     , m_token(QStringLiteral(""))
+    , m_io(new QObject())
 {
+    NetworkThread::adopt(netManager);
+    m_io->moveToThread(NetworkThread::instance());
+}
+
+AbstractApi::~AbstractApi()
+{
+    // Tear down on the network thread, where the pipeline could be running
+    // right now. Deleting m_io drops this instance's connections, timers and
+    // queued calls; its requests on the wire are given up.
+    auto teardown = [this]() {
+        for (const std::shared_ptr<Attempt> &attempt : std::as_const(m_attempts)) {
+            attempt->settled = true;
+            for (QNetworkReply *reply : {attempt->primary.data(), attempt->hedge.data()}) {
+                if (!reply)
+                    continue;
+                // A coalesced reply is left to the other callers attached to it
+                const int subscribers = reply->property(SubscribersProperty).toInt();
+                if (subscribers > 1) {
+                    reply->setProperty(SubscribersProperty, subscribers - 1);
+                    continue;
+                }
+                reply->abort();
+                reply->deleteLater();
+            }
+            if (attempt->scheduled)
+                RequestScheduler::instance()->release(attempt->priority);
+            // Never collected: frees the probe if this was one
+            CircuitBreaker::instance()->recordAbandoned(attempt->host);
+        }
+        m_attempts.clear();
+        delete m_io;
+    };
+    if (NetworkThread::isCurrent() || !NetworkThread::instance()->isRunning())
+        teardown();
+    else
+        QMetaObject::invokeMethod(NetworkThread::context(), teardown, Qt::BlockingQueuedConnection);
 }
 
 void AbstractApi::setApiHost(const QString &host) {
@@ -25,6 +98,29 @@ void AbstractApi::setApiHost(const QString &host) {
 QString AbstractApi::apiHost() const {
     return m_apiHost;
 }
+void AbstractApi::batch(const std::function<void()> &calls)
+{
+    // Batches are opened from the GUI thread
+    static int depth = 0;
+    if (depth > 0) {
+        calls();
+        return;
+    }
+
+    // The calls reach the network thread in order, between these two
+    auto batch = std::make_shared<RequestBatch *>(nullptr);
+    NetworkThread::post([batch, network = m_netManager, host = m_apiHost]() {
+        *batch = new RequestBatch(network, host);
+    });
+    ++depth;
+    calls();
+    --depth;
+    NetworkThread::post([batch]() {
+        if (*batch)
+            (*batch)->submit();
+    });
+}
+
 QUrl AbstractApi::apiUrl(const QString &path) const {
     QString fullPath = path.startsWith(QStringLiteral("/"))
         ? path
@@ -49,7 +145,428 @@ QNetworkRequest AbstractApi::createRequest(const QString &path) const {
             QStringLiteral("Bearer %1").arg(m_token).toUtf8());
     }
 
+    request.setRawHeader(QByteArrayLiteral("Idempotency-Key"),
+                         QUuid::createUuid().toByteArray(QUuid::WithoutBraces));
+
+    // HTTP/2 and the resumable TLS session of the shared connection
+    ApiTransport::instance()->configure(request);
+
     return request;
 }
 
+void AbstractApi::acceptCbor(QNetworkRequest &request)
+{
+    if (ApiTransport::instance()->preferCbor())
+        request.setRawHeader(QByteArrayLiteral("Accept"), QByteArrayLiteral("application/cbor, application/json;q=0.9"));
+}
+
+QNetworkReply *AbstractApi::sendGet(QNetworkAccessManager *network, QNetworkRequest request)
+{
+    ResponseCache *cache = ResponseCache::instance();
+    const QString key = cache->cacheKey(request);
+
+    // Attach to an identical request that has not finished yet: every caller
+    // gets its own future, but the round trip and the JSON parse happen once.
+    const QPointer<QNetworkReply> pending = s_inFlightGets.value(key);
+    if (pending && !pending->isFinished()) {
+        pending->setProperty(SubscribersProperty, pending->property(SubscribersProperty).toInt() + 1);
+        return pending;
+    }
+
+    cache->applyValidators(key, request);
+
+    QNetworkReply *reply = network->get(request);
+    reply->setProperty(CacheKeyProperty, key);
+    reply->setProperty(SubscribersProperty, 1);
+    s_inFlightGets.insert(key, reply);
+    connect(reply, &QNetworkReply::finished, reply, [reply, key]() {
+        if (s_inFlightGets.value(key) == reply)
+            s_inFlightGets.remove(key);
+    });
+    return reply;
+}
+
+QNetworkReply *AbstractApi::sendPatch(QNetworkAccessManager *network, const QNetworkRequest &request,
+                                      const QJsonObject &body)
+{
+    return network->sendCustomRequest(request, QByteArrayLiteral("PATCH"),
+                                      QJsonDocument(body).toJson(QJsonDocument::Compact));
+}
+
+QJsonObject AbstractApi::changedMembers(const QJsonObject &before, const QJsonObject &after)
+{
+    QJsonObject changes;
+    for (auto it = after.constBegin(); it != after.constEnd(); ++it) {
+        const auto previous = before.constFind(it.key());
+        if (previous == before.constEnd() || previous.value() != it.value())
+            changes.insert(it.key(), it.value());
+    }
+    return changes;
+}
+
+void AbstractApi::claimSlot(const QString &slot, QNetworkReply *reply, const void *owner, std::function<void()> cancel)
+{
+    auto it = m_slots.find(slot);
+    // The request holding the slot was sent, or is being sent again
+    if (it != m_slots.end() && it->owner == owner) {
+        it->reply = reply;
+        return;
+    }
+
+    const RequestSlot previous = it != m_slots.end() ? *it : RequestSlot();
+    m_slots.insert(slot, {reply, owner, std::move(cancel)});
+
+    if (previous.cancel)
+        previous.cancel();
+    // Queued or between two attempts: there is no transfer to stop
+    if (!previous.reply || previous.reply->isFinished())
+        return;
+
+    releaseReply(previous.reply);
+}
+
+void AbstractApi::releaseReply(QNetworkReply *reply)
+{
+    // Only abort the transfer when no other caller is attached to it
+    const int subscribers = reply->property(SubscribersProperty).toInt();
+    if (subscribers > 1) {
+        reply->setProperty(SubscribersProperty, subscribers - 1);
+    } else {
+        reply->abort();
+    }
+}
+
+void AbstractApi::parkSlot(const QString &slot, const void *owner)
+{
+    auto it = m_slots.find(slot);
+    if (it != m_slots.end() && it->owner == owner)
+        it->reply = nullptr;
+}
+
+void AbstractApi::releaseSlot(const QString &slot, const void *owner)
+{
+    auto it = m_slots.find(slot);
+    if (it != m_slots.end() && it->owner == owner)
+        m_slots.erase(it);
+}
+
+bool AbstractApi::isTransientFailure(QNetworkReply::NetworkError error, int httpStatus)
+{
+    switch (error) {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::ProxyConnectionRefusedError:
+    case QNetworkReply::ProxyTimeoutError:
+        return true;
+    default:
+        break;
+    }
+    return httpStatus == 429 || httpStatus == 502 || httpStatus == 503 || httpStatus == 504;
+}
+
+int AbstractApi::retryDelay(QNetworkReply *reply, const RawResponse &raw, int retries) const
+{
+    constexpr int MaxRetries = 3;
+    constexpr int BaseDelay = 400;
+    constexpr int MaxDelay = 8000;
+
+    // A 304 for a body the cache no longer has: ask again right away, this
+    // time without validators, rather than hand the empty body to a decoder
+    if (reply->property(StaleValidatorsProperty).toBool())
+        return retries < MaxRetries ? 0 : -1;
+
+    if (retries >= MaxRetries || !isTransientFailure(raw.networkError, raw.httpStatus))
+        return -1;
+
+    const QNetworkRequest request = reply->request();
+    const QNetworkAccessManager::Operation operation = reply->operation();
+    if (operation != QNetworkAccessManager::GetOperation && operation != QNetworkAccessManager::HeadOperation) {
+        if (!request.hasRawHeader("Idempotency-Key") || request.attribute(NoRetryAttribute).toBool())
+            return -1;
+    }
+
+    // Honour Retry-After (in seconds) on 429 and 503
+    bool ok = false;
+    const int retryAfter = reply->rawHeader("Retry-After").toInt(&ok);
+    if (ok && retryAfter >= 0)
+        return qMin(retryAfter * 1000, MaxDelay * 4);
+
+    // Jitter keeps the tills of a shop from retrying in lockstep; if the
+    // breaker opens meanwhile, the next attempt fails fast
+    const int ceiling = qMin(BaseDelay << retries, MaxDelay);
+    return ceiling / 2 + int(QRandomGenerator::global()->bounded(ceiling / 2 + 1));
+}
+
+QString AbstractApi::circuitKey() const
+{
+    return CircuitBreaker::hostKey(QUrl(m_apiHost));
+}
+
+bool AbstractApi::circuitAllowsRequest(const QString &host)
+{
+    return CircuitBreaker::instance()->allowRequest(host);
+}
+
+void AbstractApi::circuitRequestAbandoned(const QString &host)
+{
+    CircuitBreaker::instance()->recordAbandoned(host);
+}
+
+ApiError AbstractApi::circuitOpenError()
+{
+    ApiError error;
+    error.status = ApiStatus::NetworkError;
+    error.message = tr("The server is not responding. Please try again in a few seconds.");
+    return error;
+}
+
+void AbstractApi::watchReply(QNetworkReply *reply) const
+{
+    // Coalesced callers share the reply, its timer and its metrics
+    if (reply->property(StartedProperty).isValid())
+        return;
+    reply->setProperty(StartedProperty, monotonicMs());
+
+    connect(reply, &QNetworkReply::metaDataChanged, reply, [reply]() {
+        if (!reply->property(FirstByteProperty).isValid())
+            reply->setProperty(FirstByteProperty, monotonicMs());
+    });
+
+    auto *timer = new QTimer(reply);
+    timer->setSingleShot(true);
+    timer->setInterval(LatencyTracker::instance()->timeoutFor(endpointOf(reply)));
+    connect(timer, &QTimer::timeout, reply, [reply]() {
+        qWarning() << "Request timed out:" << reply->url().path();
+        reply->setProperty(TimedOutProperty, true);
+        reply->abort();
+    });
+    // The timeout covers stalls, not slow but steady transfers of big pages
+    connect(reply, &QNetworkReply::downloadProgress, timer, [reply, timer](qint64 received) {
+        reply->setProperty(BytesInProperty, received);
+        timer->start();
+    });
+    connect(reply, &QNetworkReply::uploadProgress, timer, [reply, timer](qint64 sent) {
+        reply->setProperty(BytesOutProperty, sent);
+        timer->start();
+    });
+    timer->start();
+}
+
+QString AbstractApi::endpointOf(QNetworkReply *reply)
+{
+    return LatencyTracker::endpointKey(reply->operation(), reply->url());
+}
+
+void AbstractApi::recordDecodeTime(const QString &endpoint, qint64 microseconds)
+{
+    ApiMetrics::instance()->recordDecode(endpoint, microseconds);
+}
+
+void AbstractApi::traceReply(TraceExchange &exchange, QNetworkReply *reply, const RawResponse &raw)
+{
+    exchange.endpoint = endpointOf(reply);
+    exchange.method = exchange.endpoint.section(QLatin1Char(' '), 0, 0).toLatin1();
+    exchange.url = reply->url().toString(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::FullyEncoded);
+    exchange.status = raw.httpStatus; // 0 for transport failures
+    // The body is stored decoded; transfer headers would no longer match it
+    for (const QNetworkReply::RawHeaderPair &header : raw.headers) {
+        const QByteArray name = header.first.toLower();
+        if (name != "content-encoding" && name != "content-length" && name != "transfer-encoding"
+            && name != "connection" && name != "set-cookie")
+            exchange.headers.append(header);
+    }
+    exchange.body = raw.body;
+    const QVariant startedAt = reply->property(StartedProperty);
+    if (startedAt.isValid())
+        exchange.wireMs = monotonicMs() - startedAt.toLongLong();
+}
+
+std::optional<int> AbstractApi::hedgeDelay(QNetworkReply *reply) const
+{
+    return LatencyTracker::instance()->hedgeDelayFor(endpointOf(reply));
+}
+
+QNetworkReply *AbstractApi::sendHedge(QNetworkReply *primary)
+{
+    // Callers coalesced onto the primary share its hedge, so a request on
+    // the wire is hedged once however many callers wait for it
+    const QVariant sent = primary->property(HedgeProperty);
+    if (sent.isValid()) {
+        QNetworkReply *hedge = sent.value<QPointer<QNetworkReply>>();
+        if (!hedge || hedge->isFinished())
+            return nullptr;
+        hedge->setProperty(SubscribersProperty, hedge->property(SubscribersProperty).toInt() + 1);
+        return hedge;
+    }
+
+    // Straight to the manager: sendGet() would coalesce onto the primary
+    QNetworkReply *hedge = m_netManager->get(primary->request());
+    hedge->setProperty(CacheKeyProperty, primary->property(CacheKeyProperty));
+    hedge->setProperty(SubscribersProperty, 1);
+    primary->setProperty(HedgeProperty, QVariant::fromValue(QPointer<QNetworkReply>(hedge)));
+    watchReply(hedge);
+    qDebug() << "Hedging" << primary->url().path();
+    return hedge;
+}
+
+void AbstractApi::abandonOtherReply(const std::shared_ptr<Attempt> &attempt, QNetworkReply *winner)
+{
+    // Other callers coalesced onto either side still wait for it
+    QNetworkReply *other = winner != attempt->primary ? attempt->primary.data() : attempt->hedge.data();
+    if (other && !other->isFinished())
+        releaseReply(other);
+}
+
+QByteArray AbstractApi::readReplyBody(QNetworkReply *reply) const
+{
+    // A coalesced reply is read by several handlers; only the first drains it
+    const QVariant stored = reply->property(BodyProperty);
+    if (stored.isValid())
+        return stored.toByteArray();
+
+    QByteArray body = reply->readAll();
+    const QString key = reply->property(CacheKeyProperty).toString();
+    if (!key.isEmpty() && reply->error() == QNetworkReply::NoError)
+        body = validateCachedBody(reply, key, body);
+
+    reply->setProperty(BodyProperty, body);
+    return body;
+}
+
+const QJsonObject &RawResponse::json() const
+{
+    std::call_once(m_parsed->once, [this]() {
+        if (cbor)
+            m_parsed->object = QCborValue::fromCbor(body).toMap().toJsonObject();
+        else
+            m_parsed->object = QJsonDocument::fromJson(body).object();
+    });
+    return m_parsed->object;
+}
+
+QByteArray RawResponse::header(QByteArrayView name) const
+{
+    for (const QNetworkReply::RawHeaderPair &header : headers) {
+        if (name.compare(header.first, Qt::CaseInsensitive) == 0)
+            return header.second;
+    }
+    return QByteArray();
+}
+
+QByteArray RawResponse::jsonBody() const
+{
+    if (!cbor)
+        return body;
+    return QJsonDocument(json()).toJson(QJsonDocument::Compact);
+}
+
+// Content-Type decides; a 304 served from the cache has none, so the body
+// is sniffed: JSON objects and arrays start with a bracket or whitespace
+static bool isCborBody(QNetworkReply *reply, const QByteArray &body)
+{
+    const QByteArray contentType = reply->rawHeader("Content-Type");
+    if (!contentType.isEmpty())
+        return contentType.startsWith("application/cbor");
+    if (body.isEmpty())
+        return false;
+    const char first = body.front();
+    return first != '{' && first != '[' && first != ' ' && first != '\n' && first != '\r' && first != '\t';
+}
+
+RawResponse AbstractApi::collectReply(QNetworkReply *reply) const
+{
+    const QVariant stored = reply->property(RawProperty);
+    if (stored.isValid())
+        return stored.value<RawResponse>();
+
+    RawResponse raw;
+    raw.networkError = reply->error();
+    raw.errorString = reply->errorString();
+    raw.httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    raw.body = readReplyBody(reply);
+    raw.headers = reply->rawHeaderPairs();
+    raw.cbor = isCborBody(reply, raw.body);
+
+    if (raw.networkError == QNetworkReply::OperationCanceledError && reply->property(TimedOutProperty).toBool()) {
+        raw.networkError = QNetworkReply::TimeoutError;
+        raw.errorString = tr("The server took too long to respond.");
+    }
+
+    // Done once per reply, however many callers are attached to it
+    const QVariant startedAt = reply->property(StartedProperty);
+    if (startedAt.isValid()) {
+        const QString endpoint = endpointOf(reply);
+        const qint64 latency = monotonicMs() - startedAt.toLongLong();
+        const QVariant firstByteAt = reply->property(FirstByteProperty);
+        const qint64 timeToFirstByte = firstByteAt.isValid() ? firstByteAt.toLongLong() - startedAt.toLongLong() : -1;
+        ApiMetrics::instance()->recordReply(endpoint, raw.networkError != QNetworkReply::NoError,
+                                            reply->property(BytesInProperty).toLongLong(),
+                                            reply->property(BytesOutProperty).toLongLong(),
+                                            timeToFirstByte, latency);
+        if (raw.networkError == QNetworkReply::NoError)
+            LatencyTracker::instance()->record(endpoint, latency);
+
+        // Qt advertises gzip/deflate (and br/zstd where built in) itself and
+        // inflates transparently; Content-Length is then the wire size
+        if (raw.networkError == QNetworkReply::NoError && raw.httpStatus != 304) {
+            bool known = false;
+            const qint64 length = reply->rawHeader("Content-Length").toLongLong(&known);
+            const bool compressed = !reply->rawHeader("Content-Encoding").isEmpty();
+            ApiMetrics::instance()->recordPayload(endpoint, compressed && known ? length : raw.body.size(),
+                                                  raw.body.size(), raw.cbor);
+        }
+    }
+    CircuitBreaker *breaker = CircuitBreaker::instance();
+    const QString host = CircuitBreaker::hostKey(reply->url());
+    if (raw.networkError == QNetworkReply::OperationCanceledError)
+        breaker->recordAbandoned(host);
+    else if (isTransientFailure(raw.networkError, raw.httpStatus) && raw.httpStatus != 429)
+        breaker->recordFailure(host);
+    else
+        breaker->recordSuccess(host);
+
+    reply->setProperty(RawProperty, QVariant::fromValue(raw));
+    return raw;
+}
+
+QThreadPool *AbstractApi::decodePool()
+{
+    // Kept apart from the global pool so large pages never wait behind
+    // unrelated QtConcurrent work (PDF rendering, image scaling, ...)
+    static QThreadPool *pool = [] {
+        auto *p = new QThreadPool();
+        p->setObjectName(QStringLiteral("ApiDecodePool"));
+        p->setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+        return p;
+    }();
+    return pool;
+}
+
+QByteArray AbstractApi::validateCachedBody(QNetworkReply *reply, const QString &key, const QByteArray &body) const
+{
+    ResponseCache *cache = ResponseCache::instance();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 304) {
+        if (const std::optional<QByteArray> cached = cache->body(key))
+            return *cached;
+        qDebug() << "ResponseCache: 304 for an evicted entry, fetching it again" << reply->url();
+        cache->remove(key);
+        reply->setProperty(StaleValidatorsProperty, true);
+        return body;
+    }
+
+    if (status == 200) {
+        ResponseCache::Entry entry;
+        entry.etag = reply->rawHeader("ETag");
+        entry.lastModified = reply->rawHeader("Last-Modified");
+        entry.body = body;
+        cache->store(key, entry);
+    }
+    return body;
+}
+
 } // namespace NetworkApi
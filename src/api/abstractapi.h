@@ -3,16 +3,31 @@
 #ifndef ABSTRACTAPI_H
 #define ABSTRACTAPI_H
 
+#include <QElapsedTimer>
 #include <QObject>
+#include <QPointer>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QFuture>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QJsonObject>
+#include <QHash>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <variant>
 #include <optional>
+#include <utility>
 #include <QJsonDocument>
 #include <QJsonArray>
+#include "apitrace.h"
 #include "config.h"
+#include "networkthread.h"
+#include "requestbatch.h"
+#include "requestscheduler.h"
 namespace NetworkApi {
 
 // Keep your existing enums and structs as they are
@@ -42,26 +57,103 @@ using JsonResponse = ApiResponse<QJsonObject>;
 using TokenResponse = ApiResponse<QString>;
 using VoidResponse = ApiResponse<std::monostate>;
 
+// Outcome of a finished reply, detached from the QNetworkReply so that it can
+// be parsed and decoded on a worker thread.
+struct RawResponse {
+    QNetworkReply::NetworkError networkError = QNetworkReply::NoError;
+    QString errorString;
+    int httpStatus = 0;
+    QByteArray body;
+    QList<QNetworkReply::RawHeaderPair> headers;
+    bool cbor = false; // body is application/cbor rather than JSON
+
+    // Case-insensitive header lookup
+    QByteArray header(QByteArrayView name) const;
+
+    // The body as a JSON object, built on first use. Copies share the parse,
+    // so handlers attached to one coalesced reply build the tree at most once
+    // and streaming decoders never build it at all. CBOR bodies are read
+    // with QCborValue, so decoders get the same object either way.
+    const QJsonObject &json() const;
+    // The body as JSON text, for the streaming decoders. Their endpoints do
+    // not ask for CBOR, so the conversion only runs for a server that sends
+    // it anyway.
+    QByteArray jsonBody() const;
+
+private:
+    struct ParsedJson {
+        std::once_flag once;
+        QJsonObject object;
+    };
+    std::shared_ptr<ParsedJson> m_parsed = std::make_shared<ParsedJson>();
+};
+
 class AbstractApi : public QObject {
     Q_OBJECT
         Q_PROPERTY(QString apiHost READ apiHost NOTIFY apiHostChanged)
 public:
     explicit AbstractApi(QNetworkAccessManager *netManager, QObject *parent = nullptr);
+    ~AbstractApi() override;
     void setApiHost(const QString &host);
     QString apiHost() const;
 
+    // Runs calls() and sends the GETs it starts, from any API instance, as
+    // one batch request (see RequestBatch). Results still arrive through
+    // each API's own futures and signals. Nested calls join the outer batch.
+    void batch(const std::function<void()> &calls);
+
 protected:
     QNetworkAccessManager *m_netManager;
     QString m_apiHost;
     QString m_token;
     void setNetworkManager(QNetworkAccessManager *manager) {
+        NetworkThread::adopt(manager);
         m_netManager = manager;
     }
 
+    // Marks a request whose body cannot be sent twice (multipart uploads),
+    // so it is never retried even though it carries an Idempotency-Key.
+    static constexpr auto NoRetryAttribute = QNetworkRequest::Attribute(QNetworkRequest::User + 1);
+
     // Helper methods that need implementation
+    // Every request gets a fresh Idempotency-Key. Callers build the request
+    // once per operation and send that same copy on every attempt, so the
+    // backend can recognise a retried mutation and not apply it twice.
     QNetworkRequest createRequest(const QString &path) const;
     QUrl apiUrl(const QString &path) const;
-    QString getErrorMessages(const QJsonObject &errorDetails) const{
+    // Lets the server answer in CBOR when ApiTransport::preferCbor() is set.
+    // Only for GETs decoded from the tree with makeDecodedRequest(): the
+    // field tables of makeStreamDecodedRequest() read JSON text.
+    static void acceptCbor(QNetworkRequest &request);
+
+    // The request factories passed to makeRequest() and friends run on the
+    // NetworkThread, like everything else that touches a QNetworkReply. They
+    // should only send the request they were given, through the manager they
+    // are handed: this API's, or the collector of a RequestBatch.
+    using RequestFactory = std::function<QNetworkReply *(QNetworkAccessManager *network)>;
+
+    // Issues a GET through the shared response cache: known pages are
+    // revalidated with If-None-Match / If-Modified-Since, and a GET that is
+    // identical to one still in flight reuses that reply.
+    QNetworkReply *sendGet(QNetworkAccessManager *network, QNetworkRequest request);
+    // Sends body, compact, as a PATCH
+    QNetworkReply *sendPatch(QNetworkAccessManager *network, const QNetworkRequest &request, const QJsonObject &body);
+    // The members of after that before lacks or holds another value for: the
+    // PATCH body that turns before into after. Nested objects and arrays are
+    // compared, and sent, whole.
+    static QJsonObject changedMembers(const QJsonObject &before, const QJsonObject &after);
+    // Reads the reply payload, serving 304 Not Modified from the cache
+    // and storing fresh validated bodies for the next round trip. A 304 whose
+    // body is gone drops the entry and has the request retried without
+    // validators. Safe to call from every handler attached to a coalesced
+    // reply.
+    QByteArray readReplyBody(QNetworkReply *reply) const;
+    // Snapshots the reply on the GUI thread. Every handler attached to the
+    // same reply gets the same snapshot, and with it the same JSON parse.
+    RawResponse collectReply(QNetworkReply *reply) const;
+    static QThreadPool *decodePool();
+
+    static QString getErrorMessages(const QJsonObject &errorDetails) {
         QStringList messagesList;
 
         // Iterate through each field (email, password, etc.)
@@ -81,7 +173,7 @@ protected:
     }
 
     // 1. ERROR STATUS DETERMINATION
-    ApiStatus determineErrorStatus(const QNetworkReply *reply, const QJsonObject &jsonResponse = QJsonObject()) const {
+    static ApiStatus determineErrorStatus(QNetworkReply::NetworkError networkError, const QJsonObject &jsonResponse = QJsonObject()) {
         // First priority: Check API-level errors in JSON response
         if (!jsonResponse.isEmpty()) {
             if (jsonResponse.value(QStringLiteral("error")).toBool() || jsonResponse.contains(QStringLiteral("errors"))) {
@@ -94,8 +186,8 @@ protected:
         }
 
         // Second priority: Check network-level errors
-        if (reply->error() != QNetworkReply::NoError) {
-            switch (reply->error()) {
+        if (networkError != QNetworkReply::NoError) {
+            switch (networkError) {
             case QNetworkReply::ConnectionRefusedError:
             case QNetworkReply::RemoteHostClosedError:
             case QNetworkReply::HostNotFoundError:
@@ -122,7 +214,7 @@ protected:
     }
 
     // 2. ERROR MESSAGE GENERATION
-    QString getErrorMessage(ApiStatus status, const QString& originalMessage, const QJsonObject &jsonResponse = QJsonObject()) const {
+    static QString getErrorMessage(ApiStatus status, const QString& originalMessage, const QJsonObject &jsonResponse = QJsonObject()) {
         // First priority: Use API-provided messages for certain errors
         if (!jsonResponse.isEmpty() && jsonResponse.contains(QStringLiteral("message"))) {
             QString apiMessage = jsonResponse[QStringLiteral("message")].toString();
@@ -154,58 +246,414 @@ protected:
     }
 
     // 3. MAIN RESPONSE HANDLER
+    // Runs on the decode pool: it must only touch its arguments.
     template<typename T>
-    ApiResponse<T> handleResponse(QNetworkReply *reply) {
-        // Step 1: Read and parse response
-        QByteArray responseData = reply->readAll();
-        QJsonDocument jsonDoc = QJsonDocument::fromJson(responseData);
-        QJsonObject jsonObject = jsonDoc.object();
+    static ApiResponse<T> handleResponse(const RawResponse &raw, const std::function<T(const QJsonObject &)> &decode) {
+        // Step 1: Determine error status
+        ApiStatus status = determineErrorStatus(raw.networkError, raw.json());
 
-        // Step 2: Determine error status
-        ApiStatus status = determineErrorStatus(reply, jsonObject);
+        // Step 2: Handle success case
+        if (status == ApiStatus::Success) {
+            return {true, decode(raw.json()), std::nullopt};
+        }
+
+        // Step 3: Handle error case
+        return {false, std::nullopt, makeError(status, raw)};
+    }
+
+    // Same contract for decoders that read the body directly. They return
+    // nullopt for anything that is not a well-formed success payload, which
+    // then goes through the regular JSON error handling.
+    template<typename T>
+    static ApiResponse<T> handleStreamedResponse(const RawResponse &raw, const std::function<std::optional<T>(QByteArrayView)> &decode) {
+        if (raw.networkError == QNetworkReply::NoError) {
+            if (std::optional<T> data = decode(raw.jsonBody()))
+                return {true, std::move(data), std::nullopt};
+        }
 
-        // Step 3: Handle success case
+        ApiStatus status = determineErrorStatus(raw.networkError, raw.json());
         if (status == ApiStatus::Success) {
-            if constexpr (std::is_same_v<T, QJsonObject>) {
-                return {true, jsonObject, std::nullopt};
-            } else if constexpr (std::is_same_v<T, QString>) {
-                return {true, jsonObject[QStringLiteral("accessToken")].toString(), std::nullopt};
-            } else if constexpr (std::is_same_v<T, std::monostate>) {
-                return {true, std::monostate{}, std::nullopt};
-            }
+            // Valid JSON, but not the shape the decoder expects
+            status = ApiStatus::UnknownError;
         }
+        return {false, std::nullopt, makeError(status, raw)};
+    }
 
-        // Step 4: Handle error case
+    static ApiError makeError(ApiStatus status, const RawResponse &raw) {
         ApiError error;
         error.status = status;
-        error.message = getErrorMessage(status, reply->errorString(), jsonObject);
-        if (jsonObject.contains(QStringLiteral("errors"))) {
-            error.details = jsonObject[QStringLiteral("errors")].toObject();
+        error.message = getErrorMessage(status, raw.errorString, raw.json());
+        if (raw.json().contains(QStringLiteral("errors"))) {
+            error.details = raw.json()[QStringLiteral("errors")].toObject();
         }
 
-        // Step 5: Debug output
         qDebug() << "Error Status:" << static_cast<int>(status);
         qDebug() << "Error Message:" << error.message;
         qDebug() << "Error Details:" << error.details;
 
-        return {false, std::nullopt, error};
+        return error;
+    }
+
+    template<typename T>
+    static T decodeDefault(const QJsonObject &json) {
+        if constexpr (std::is_same_v<T, QJsonObject>) {
+            return json;
+        } else if constexpr (std::is_same_v<T, QString>) {
+            return json[QStringLiteral("accessToken")].toString();
+        } else {
+            static_assert(std::is_same_v<T, std::monostate>, "use makeDecodedRequest for typed results");
+            return std::monostate{};
+        }
+    }
+
+    template<typename T>
+    QFuture<ApiResponse<T>> makeRequest(RequestFactory request,
+                                        const QString &slot = QString(),
+                                        std::optional<RequestPriority> priority = std::nullopt) {
+        return makeDecodedRequest<T>(std::move(request), &AbstractApi::decodeDefault<T>, slot, priority);
+    }
+
+    // Like makeRequest, but converts the JSON into a typed result with
+    // decode() on the decode pool, so only the finished struct reaches the
+    // GUI thread. decode must be pure: it may not touch mutable API state.
+    //
+    // A non-empty slot names the logical query a request answers (for example
+    // the product list of this API instance). Starting a new request in the
+    // same slot supersedes the previous one: its reply is aborted and its
+    // result dropped before parsing, so a slow stale page cannot overwrite a
+    // newer one.
+    //
+    // The request is only sent once the RequestScheduler has a free slot for
+    // its priority, which defaults to the one of this API (see
+    // setDefaultPriority).
+    template<typename T>
+    QFuture<ApiResponse<T>> makeDecodedRequest(RequestFactory request,
+                                               std::function<T(const QJsonObject &)> decode,
+                                               const QString &slot = QString(),
+                                               std::optional<RequestPriority> priority = std::nullopt) {
+        return dispatchRequest<T>(std::move(request), [decode](const RawResponse &raw) {
+            return handleResponse<T>(raw, decode);
+        }, slot, priority.value_or(m_defaultPriority));
+    }
+
+    // Like makeDecodedRequest, for decoders that read the response body
+    // straight into T (see jsondecoders.h) instead of walking a QJsonObject.
+    template<typename T>
+    QFuture<ApiResponse<T>> makeStreamDecodedRequest(RequestFactory request,
+                                                     std::function<std::optional<T>(QByteArrayView)> decode,
+                                                     const QString &slot = QString(),
+                                                     std::optional<RequestPriority> priority = std::nullopt) {
+        return dispatchRequest<T>(std::move(request), [decode](const RawResponse &raw) {
+            return handleStreamedResponse<T>(raw, decode);
+        }, slot, priority.value_or(m_defaultPriority));
+    }
+
+    // For replies that are not JSON, like generated PDF documents: the
+    // response as received, headers included, through the same pipeline.
+    QFuture<RawResponse> makeRawRequest(RequestFactory request,
+                                        const QString &slot = QString(),
+                                        std::optional<RequestPriority> priority = std::nullopt) {
+        return dispatchRequest<RawResponse>(std::move(request), [](const RawResponse &raw) {
+            return ApiResponse<RawResponse>{raw.networkError == QNetworkReply::NoError, raw, std::nullopt};
+        }, slot, priority.value_or(m_defaultPriority)).then([](const ApiResponse<RawResponse> &response) {
+            if (response.data)
+                return *response.data;
+            // Never sent, the circuit breaker is open
+            RawResponse raw;
+            raw.networkError = QNetworkReply::UnknownNetworkError;
+            raw.errorString = response.error ? response.error->message : QString();
+            return raw;
+        });
+    }
+
+    void setDefaultPriority(RequestPriority priority) { m_defaultPriority = priority; }
+
+    // Idempotent reads of this API are hedged: when a GET has not answered
+    // by its endpoint's p95 latency, an identical request is sent and the
+    // first reply wins. Trades a little extra load for a shorter tail.
+    void setHedgedReads(bool enabled) { m_hedgeReads = enabled; }
+
+private:
+    // The replies sent for one attempt: the request, and maybe its hedge
+    struct Attempt {
+        QPointer<QNetworkReply> primary;
+        QPointer<QNetworkReply> hedge;
+        int open = 1;
+        bool settled = false;
+        bool scheduled = false; // holds a RequestScheduler slot
+        RequestPriority priority = RequestPriority::Visible;
+        QString host; // circuit breaker key
+    };
+
+    // One logical request across its attempts
+    template<typename T>
+    struct PendingRequest {
+        RequestFactory send;
+        std::function<ApiResponse<T>(const RawResponse &)> handle;
+        QString slot;
+        QString host; // circuit breaker key
+        RequestPriority priority = RequestPriority::Visible;
+        QFutureInterface<ApiResponse<T>> interface{QFutureInterfaceBase::Started};
+        int retries = 0;
+        bool hedge = false;
+        quint64 ticket = 0; // while queued in the scheduler
+        QPointer<RequestBatch> batch; // first attempt only
+        bool batched = false; // current attempt bypassed the scheduler
+        std::shared_ptr<Attempt> attempt; // while on the wire
+        std::shared_ptr<TraceExchange> trace; // while ApiTrace records or replays
+    };
+
+
+    template<typename T>
+    QFuture<ApiResponse<T>> dispatchRequest(RequestFactory request,
+                                            std::function<ApiResponse<T>(const RawResponse &)> handle,
+                                            const QString &slot,
+                                            RequestPriority priority) {
+        auto pending = std::make_shared<PendingRequest<T>>();
+        pending->send = std::move(request);
+        pending->handle = std::move(handle);
+        pending->slot = slot;
+        pending->priority = priority;
+        pending->hedge = m_hedgeReads;
+        pending->host = circuitKey();
+        pending->trace = ApiTrace::begin();
+        // The rest of the pipeline runs on the network thread; only the
+        // finished result comes back through the future
+        QMetaObject::invokeMethod(m_io, [this, pending]() {
+            pending->batch = RequestBatch::current();
+            startAttempt(pending);
+        }, Qt::QueuedConnection);
+        return pending->interface.future();
+    }
+
+    template<typename T>
+    void startAttempt(const std::shared_ptr<PendingRequest<T>> &pending) {
+        // Superseded while waiting for a retry
+        if (pending->interface.isCanceled())
+            return;
+
+        // Hold the slot while queued, so a newer request supersedes this one
+        // before it is even sent
+        if (!pending->slot.isEmpty()) {
+            claimSlot(pending->slot, nullptr, pending.get(), [pending]() {
+                pending->interface.cancel();
+                RequestScheduler::instance()->cancel(pending->ticket);
+                if (pending->attempt && pending->attempt->hedge && !pending->attempt->hedge->isFinished())
+                    releaseReply(pending->attempt->hedge);
+            });
+        }
+
+        // A batch goes out as one request once collected, so its calls do not
+        // queue for the scheduler; retries are sent on their own
+        pending->batched = pending->batch && pending->batch == RequestBatch::current();
+        if (pending->batched) {
+            sendAttempt(pending);
+            return;
+        }
+        pending->batch = nullptr;
+
+        // m_io goes away on the network thread before this object does
+        QPointer<QObject> io(m_io);
+        pending->ticket = RequestScheduler::instance()->schedule(pending->priority, [this, io, pending]() {
+            return io && sendAttempt(pending);
+        });
+    }
+
+    template<typename T>
+    bool sendAttempt(const std::shared_ptr<PendingRequest<T>> &pending) {
+        pending->ticket = 0;
+        if (pending->interface.isCanceled())
+            return false;
+
+        if (!circuitAllowsRequest(pending->host)) {
+            if (!pending->slot.isEmpty())
+                releaseSlot(pending->slot, pending.get());
+            finishRequest(pending, ApiResponse<T>{false, std::nullopt, circuitOpenError()});
+            return false;
+        }
+
+        QNetworkReply *reply = pending->send(pending->batched ? pending->batch->collector() : m_netManager);
+        if (!pending->slot.isEmpty())
+            claimSlot(pending->slot, reply, pending.get(), {});
+        watchReply(reply);
+
+        auto attempt = std::make_shared<Attempt>();
+        attempt->primary = reply;
+        attempt->scheduled = !pending->batched;
+        attempt->priority = pending->priority;
+        attempt->host = pending->host;
+        pending->attempt = attempt;
+        m_attempts.insert(attempt.get(), attempt);
+        connect(reply, &QNetworkReply::finished, m_io, [this, pending, attempt, reply]() {
+            attemptFinished(pending, attempt, reply);
+        });
+
+        // Hedged read: if the answer is later than usual, ask again on a
+        // second connection and keep whichever reply lands first
+        if (pending->hedge && reply->operation() == QNetworkAccessManager::GetOperation) {
+            if (const std::optional<int> delay = hedgeDelay(reply)) {
+                QTimer::singleShot(*delay, reply, [this, pending, attempt, reply]() {
+                    if (reply->isFinished() || attempt->settled || pending->interface.isCanceled())
+                        return;
+                    QNetworkReply *hedge = sendHedge(reply);
+                    if (!hedge)
+                        return;
+                    attempt->hedge = hedge;
+                    ++attempt->open;
+                    connect(hedge, &QNetworkReply::finished, m_io, [this, pending, attempt, hedge]() {
+                        attemptFinished(pending, attempt, hedge);
+                    });
+                });
+            }
+        }
+        return true;
     }
+
     template<typename T>
-    QFuture<ApiResponse<T>> makeRequest(std::function<QNetworkReply*(void)> request) {
-        // Keep your existing implementation
-        auto interface = std::make_shared<QFutureInterface<ApiResponse<T>>>(QFutureInterfaceBase::Started);
-        QNetworkReply *reply = request();
-
-        connect(reply, &QNetworkReply::finished, this, [=]() {
-            if (!interface->isCanceled()) {
-                interface->reportResult(handleResponse<T>(reply));
-                interface->reportFinished();
+    void attemptFinished(const std::shared_ptr<PendingRequest<T>> &pending,
+                         const std::shared_ptr<Attempt> &attempt, QNetworkReply *reply) {
+        --attempt->open;
+        reply->deleteLater();
+        // The slower side of a hedged read, aborted once the other answered
+        if (attempt->settled)
+            return;
+
+        const bool canceled = pending->interface.isCanceled();
+        RawResponse raw;
+        if (!canceled) {
+            raw = collectReply(reply);
+            // Give the other side of a hedged read its chance
+            if (attempt->open > 0 && isTransientFailure(raw.networkError, raw.httpStatus)) {
+                if (!pending->slot.isEmpty() && reply == attempt->primary)
+                    claimSlot(pending->slot, attempt->hedge, pending.get(), {});
+                return;
             }
-            reply->deleteLater();
+        }
+
+        attempt->settled = true;
+        pending->attempt.reset();
+        m_attempts.remove(attempt.get());
+        abandonOtherReply(attempt, reply);
+        if (attempt->scheduled)
+            RequestScheduler::instance()->release(attempt->priority);
+
+        if (canceled) {
+            if (!pending->slot.isEmpty())
+                releaseSlot(pending->slot, pending.get());
+            // The reply was not collected, so its outcome was not recorded:
+            // if it was the half-open probe, let the next request probe
+            circuitRequestAbandoned(pending->host);
+            return;
+        }
+
+        const int delay = retryDelay(reply, raw, pending->retries);
+        if (delay >= 0) {
+            // Keep the slot so a newer request still supersedes this one
+            if (!pending->slot.isEmpty())
+                parkSlot(pending->slot, pending.get());
+            ++pending->retries;
+            qDebug() << "Retrying" << reply->url().path() << "in" << delay << "ms, attempt" << pending->retries;
+            QTimer::singleShot(delay, m_io, [this, pending]() {
+                startAttempt(pending);
+            });
+            return;
+        }
+
+        if (!pending->slot.isEmpty())
+            releaseSlot(pending->slot, pending.get());
+        const auto handle = pending->handle;
+        const QString endpoint = endpointOf(reply);
+        const std::shared_ptr<TraceExchange> trace = pending->trace;
+        if (trace)
+            traceReply(*trace, reply, raw);
+        QtConcurrent::run(decodePool(), [handle, raw, endpoint, trace]() {
+            QElapsedTimer timer;
+            timer.start();
+            ApiResponse<T> response = handle(raw);
+            const qint64 microseconds = timer.nsecsElapsed() / 1000;
+            recordDecodeTime(endpoint, microseconds);
+            if (trace)
+                trace->parseUs = microseconds;
+            return response;
+        }).then(this, [this, pending](ApiResponse<T> response) {
+            finishRequest(pending, response);
         });
+    }
 
-        return interface->future();
+    template<typename T>
+    void finishRequest(const std::shared_ptr<PendingRequest<T>> &pending, const ApiResponse<T> &response) {
+        // Results are delivered on the thread of the API object, where its
+        // continuations and the models listening to its signals live
+        if (QThread::currentThread() != thread()) {
+            QMetaObject::invokeMethod(this, [this, pending, response]() {
+                finishRequest(pending, response);
+            }, Qt::QueuedConnection);
+            return;
+        }
+        if (pending->interface.isCanceled())
+            return;
+        // Continuations without a context run right here, so this also times
+        // the API's handlers and the models updated from its signals
+        QElapsedTimer delivery;
+        delivery.start();
+        pending->interface.reportResult(response);
+        pending->interface.reportFinished();
+        if (pending->trace) {
+            pending->trace->modelUs = delivery.nsecsElapsed() / 1000;
+            pending->trace->totalMs = pending->trace->started.elapsed();
+            ApiTrace::instance()->finish(pending->trace);
+        }
     }
+
+    // Retry policy: transient failures (transport errors, 429, 502-504) are
+    // retried with exponentially growing, jittered delays. GETs are always
+    // eligible; other methods only when they carry an Idempotency-Key and
+    // their body can be sent again. Returns -1 when the reply is final.
+    int retryDelay(QNetworkReply *reply, const RawResponse &raw, int retries) const;
+    QString circuitKey() const;
+    static bool circuitAllowsRequest(const QString &host);
+    // A request sent to host that ended without a collected reply
+    static void circuitRequestAbandoned(const QString &host);
+    static ApiError circuitOpenError();
+    static bool isTransientFailure(QNetworkReply::NetworkError error, int httpStatus);
+
+    // Starts the clock on a freshly sent reply: byte counts and time to first
+    // byte for ApiMetrics, and a timeout that aborts the reply if it stalls
+    // for longer than its endpoint usually takes (see LatencyTracker); it
+    // then fails with TimeoutError.
+    void watchReply(QNetworkReply *reply) const;
+    static QString endpointOf(QNetworkReply *reply);
+    static void recordDecodeTime(const QString &endpoint, qint64 microseconds);
+    // Fills in the request and response of a traced exchange
+    static void traceReply(TraceExchange &exchange, QNetworkReply *reply, const RawResponse &raw);
+    std::optional<int> hedgeDelay(QNetworkReply *reply) const;
+    // The hedge of primary, sent on first use and shared by every caller
+    // coalesced onto primary; nullptr once it has already answered
+    QNetworkReply *sendHedge(QNetworkReply *primary);
+    void abandonOtherReply(const std::shared_ptr<Attempt> &attempt, QNetworkReply *winner);
+
+    struct RequestSlot {
+        QNetworkReply *reply = nullptr;
+        const void *owner = nullptr;
+        std::function<void()> cancel;
+    };
+
+    void claimSlot(const QString &slot, QNetworkReply *reply, const void *owner, std::function<void()> cancel);
+    void parkSlot(const QString &slot, const void *owner);
+    void releaseSlot(const QString &slot, const void *owner);
+    // Detaches a caller from a reply, aborting it once nobody waits for it
+    static void releaseReply(QNetworkReply *reply);
+
+    // Network thread state: an object to bind the pipeline's connections,
+    // timers and queued calls to, the slots, and the attempts on the wire
+    QObject *m_io;
+    QHash<QString, RequestSlot> m_slots;
+    QHash<Attempt *, std::shared_ptr<Attempt>> m_attempts;
+    RequestPriority m_defaultPriority = RequestPriority::Visible;
+    bool m_hedgeReads = false;
+
+    QByteArray validateCachedBody(QNetworkReply *reply, const QString &key, const QByteArray &body) const;
+
 Q_SIGNALS:
     void apiHostChanged();
     void errorOccurred(const ApiError &error);
@@ -1,5 +1,6 @@
 // activitylogapi.cpp
 #include "activitylogapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -7,6 +8,8 @@
 
 namespace NetworkApi {
 
+using namespace Qt::StringLiterals;
+
 ActivityLogApi::ActivityLogApi(QNetworkAccessManager *netManager, QObject *parent)
     : AbstractApi(netManager, parent)
     , m_settings(QStringLiteral("Dervox"), QStringLiteral("DGest"))
@@ -16,43 +19,32 @@ ActivityLogApi::ActivityLogApi(QNetworkAccessManager *netManager, QObject *paren
 QFuture<void> ActivityLogApi::getLogs(const QString &logType, const QString &modelType,
                                       const QString &modelIdentifier, const QString &userIdentifier,
                                       const QDate &startDate, const QDate &endDate,
-                                      const QString &sortBy, const QString &sortDirection, int page)
+                                      const QString &sortBy, const QString &sortDirection, int page,
+                                      const std::optional<QString> &cursor)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/activity-logs");
 
-    QStringList queryParts;
-    if (!logType.isEmpty())
-        queryParts << QStringLiteral("log_type=%1").arg(logType);
-    if (!modelType.isEmpty())
-        queryParts << QStringLiteral("model_type=%1").arg(modelType);
-    if (!modelIdentifier.isEmpty())
-        queryParts << QStringLiteral("model_identifier=%1").arg(modelIdentifier);
-    if (!userIdentifier.isEmpty())
-        queryParts << QStringLiteral("user_identifier=%1").arg(userIdentifier);
-    if (startDate.isValid())
-        queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(Qt::ISODate));
-    if (endDate.isValid())
-        queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(Qt::ISODate));
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-
-    if (!queryParts.isEmpty()) {
-            path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .add("log_type"_L1, logType)
+               .add("model_type"_L1, modelType)
+               .add("model_identifier"_L1, modelIdentifier)
+               .add("user_identifier"_L1, userIdentifier)
+               .add("start_date"_L1, startDate)
+               .add("end_date"_L1, endDate)
+               .sort(sortBy, sortDirection)
+               .pagination(page, cursor)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedLogs>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedLogsFromJson, QStringLiteral("logs")).then([=](ApiResponse<PaginatedLogs> response) {
         if (response.success) {
-            PaginatedLogs paginatedLogs = paginatedLogsFromJson(*response.data);
+            const PaginatedLogs &paginatedLogs = *response.data;
             Q_EMIT logsReceived(paginatedLogs);
         } else {
             Q_EMIT logError(response.error->message, response.error->status,
@@ -70,8 +62,8 @@ QFuture<void> ActivityLogApi::getLog(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/activity-logs/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             ActivityLog log = logFromJson(response.data->value(QStringLiteral("log")).toObject());
@@ -92,12 +84,13 @@ QFuture<void> ActivityLogApi::getStatistics(int days)
     QString path = QStringLiteral("/api/v1/activity-logs/statistics?days=%1").arg(days);
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<LogStatistics>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &statisticsFromJson).then([=](ApiResponse<LogStatistics> response) {
         if (response.success) {
-            LogStatistics stats = statisticsFromJson(*response.data);
+            const LogStatistics &stats = *response.data;
             Q_EMIT statisticsReceived(stats);
         } else {
             Q_EMIT logError(response.error->message, response.error->status,
@@ -115,8 +108,8 @@ QFuture<void> ActivityLogApi::getFilterOptions()
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/activity-logs/filter-options"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QStringList logTypes, modelTypes;
@@ -151,8 +144,8 @@ QFuture<void> ActivityLogApi::cleanup(int days)
     QJsonObject jsonData;
     jsonData[QStringLiteral("days")] = days;
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             int deletedCount = response.data->value(QStringLiteral("deleted_logs_count")).toInt();
@@ -167,7 +160,7 @@ QFuture<void> ActivityLogApi::cleanup(int days)
     return future.then([=]() {});
 }
 
-ActivityLog ActivityLogApi::logFromJson(const QJsonObject &json) const
+ActivityLog ActivityLogApi::logFromJson(const QJsonObject &json)
 {
     ActivityLog log;
     log.id = json[QStringLiteral("id")].toInt();
@@ -180,7 +173,7 @@ ActivityLog ActivityLogApi::logFromJson(const QJsonObject &json) const
     return log;
 }
 
-PaginatedLogs ActivityLogApi::paginatedLogsFromJson(const QJsonObject &json) const
+PaginatedLogs ActivityLogApi::paginatedLogsFromJson(const QJsonObject &json)
 {
     PaginatedLogs result;
     const QJsonObject &meta = json[QStringLiteral("logs")].toObject();
@@ -188,6 +181,7 @@ PaginatedLogs ActivityLogApi::paginatedLogsFromJson(const QJsonObject &json) con
     result.lastPage = meta[QStringLiteral("last_page")].toInt();
     result.perPage = meta[QStringLiteral("per_page")].toInt();
     result.total = meta[QStringLiteral("total")].toInt();
+    result.nextCursor = meta[QStringLiteral("next_cursor")].toString();
 
     const QJsonArray &dataArray = meta[QStringLiteral("data")].toArray();
     for (const QJsonValue &value : dataArray) {
@@ -197,7 +191,7 @@ PaginatedLogs ActivityLogApi::paginatedLogsFromJson(const QJsonObject &json) con
     return result;
 }
 
-LogStatistics ActivityLogApi::statisticsFromJson(const QJsonObject &json) const
+LogStatistics ActivityLogApi::statisticsFromJson(const QJsonObject &json)
 {
     LogStatistics stats;
     stats.totalLogs = json[QStringLiteral("total_logs")].toInt();
@@ -24,6 +24,7 @@ struct PaginatedLogs {
     int lastPage;
     int perPage;
     int total;
+    QString nextCursor; // keyset pagination; empty after the last page
 };
 
 struct LogStatistics {
@@ -49,7 +50,8 @@ public:
                                      const QDate &endDate = QDate(),
                                      const QString &sortBy = QStringLiteral("created_at"),
                                      const QString &sortDirection = QStringLiteral("desc"),
-                                     int page = 1);
+                                     int page = 1,
+                                     const std::optional<QString> &cursor = std::nullopt);
 
     Q_INVOKABLE QFuture<void> getLog(int id);
     Q_INVOKABLE QFuture<void> getStatistics(int days = 30);
@@ -71,9 +73,9 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    ActivityLog logFromJson(const QJsonObject &json) const;
-    PaginatedLogs paginatedLogsFromJson(const QJsonObject &json) const;
-    LogStatistics statisticsFromJson(const QJsonObject &json) const;
+    static ActivityLog logFromJson(const QJsonObject &json);
+    static PaginatedLogs paginatedLogsFromJson(const QJsonObject &json);
+    static LogStatistics statisticsFromJson(const QJsonObject &json);
     QSettings m_settings;
 
     bool m_isLoading = false;
@@ -0,0 +1,214 @@
+// apimetrics.cpp
+#include "apimetrics.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace NetworkApi {
+using namespace Qt::StringLiterals;
+
+ApiMetrics *ApiMetrics::instance()
+{
+    static ApiMetrics *metrics = new ApiMetrics();
+    return metrics;
+}
+
+ApiMetrics::ApiMetrics()
+    : m_updateTimer(this)
+{
+    // The first caller may be the network thread; updated() is for the UI
+    if (QCoreApplication::instance())
+        moveToThread(QCoreApplication::instance()->thread());
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(1000);
+    connect(&m_updateTimer, &QTimer::timeout, this, &ApiMetrics::updated);
+}
+
+void ApiMetrics::recordReply(const QString &endpoint, bool failed, qint64 bytesIn, qint64 bytesOut,
+                             qint64 timeToFirstByte, qint64 latency)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        Endpoint &entry = m_endpoints[endpoint];
+        ++entry.requests;
+        if (failed)
+            ++entry.failures;
+        entry.bytesIn += bytesIn;
+        entry.bytesOut += bytesOut;
+        if (timeToFirstByte >= 0) {
+            ++entry.ttfbSamples;
+            entry.ttfbTotal += timeToFirstByte;
+            entry.ttfbMax = qMax(entry.ttfbMax, timeToFirstByte);
+        }
+        entry.latencyTotal += latency;
+        entry.latencyMax = qMax(entry.latencyMax, latency);
+        const auto bucket = std::lower_bound(LatencyBuckets.begin(), LatencyBuckets.end(), latency);
+        ++entry.histogram[std::distance(LatencyBuckets.begin(), bucket)];
+    }
+    scheduleUpdate();
+}
+
+void ApiMetrics::recordDecode(const QString &endpoint, qint64 microseconds)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        Endpoint &entry = m_endpoints[endpoint];
+        ++entry.decodes;
+        entry.decodeTotalUs += microseconds;
+        entry.decodeMaxUs = qMax(entry.decodeMaxUs, microseconds);
+    }
+    scheduleUpdate();
+}
+
+void ApiMetrics::recordPayload(const QString &endpoint, qint64 wireBytes, qint64 payloadBytes, bool cbor)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        Endpoint &entry = m_endpoints[endpoint];
+        entry.wireBytes += wireBytes;
+        entry.payloadBytes += payloadBytes;
+        if (cbor) {
+            ++entry.cborReplies;
+            entry.cborPayloadBytes += payloadBytes;
+        } else {
+            ++entry.jsonReplies;
+            entry.jsonPayloadBytes += payloadBytes;
+        }
+    }
+    scheduleUpdate();
+}
+
+void ApiMetrics::recordColdStart(qint64 firstDataMs, bool prewarmed, bool http2)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_coldStart["firstDataMs"_L1] = firstDataMs;
+        m_coldStart["prewarmed"_L1] = prewarmed;
+        m_coldStart["http2"_L1] = http2;
+    }
+    scheduleUpdate();
+}
+
+QVariantMap ApiMetrics::coldStart() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_coldStart;
+}
+
+void ApiMetrics::scheduleUpdate()
+{
+    QMetaObject::invokeMethod(this, [this]() {
+        if (!m_updateTimer.isActive())
+            m_updateTimer.start();
+    });
+}
+
+QVariantMap ApiMetrics::toVariantMap(const QString &name, const Endpoint &endpoint)
+{
+    QVariantList histogram;
+    for (qsizetype i = 0; i < qsizetype(endpoint.histogram.size()); ++i) {
+        QVariantMap bucket;
+        bucket["le"_L1] = i < qsizetype(LatencyBuckets.size()) ? QVariant(LatencyBuckets[i]) : QVariant(QStringLiteral("inf"));
+        bucket["count"_L1] = endpoint.histogram[i];
+        histogram.append(bucket);
+    }
+
+    QVariantMap map;
+    map["endpoint"_L1] = name;
+    map["requests"_L1] = endpoint.requests;
+    map["failures"_L1] = endpoint.failures;
+    map["bytesIn"_L1] = endpoint.bytesIn;
+    map["bytesOut"_L1] = endpoint.bytesOut;
+    map["avgTtfbMs"_L1] = endpoint.ttfbSamples ? double(endpoint.ttfbTotal) / endpoint.ttfbSamples : 0.0;
+    map["maxTtfbMs"_L1] = endpoint.ttfbMax;
+    map["avgLatencyMs"_L1] = endpoint.requests ? double(endpoint.latencyTotal) / endpoint.requests : 0.0;
+    map["maxLatencyMs"_L1] = endpoint.latencyMax;
+    map["latencyHistogram"_L1] = histogram;
+    map["decodes"_L1] = endpoint.decodes;
+    map["avgDecodeMs"_L1] = endpoint.decodes ? endpoint.decodeTotalUs / 1000.0 / endpoint.decodes : 0.0;
+    map["maxDecodeMs"_L1] = endpoint.decodeMaxUs / 1000.0;
+    // Share of the payload that compression kept off the wire
+    map["wireBytes"_L1] = endpoint.wireBytes;
+    map["payloadBytes"_L1] = endpoint.payloadBytes;
+    map["compressionSavings"_L1] = endpoint.payloadBytes ? 1.0 - double(endpoint.wireBytes) / endpoint.payloadBytes : 0.0;
+    // Average body per format; once both were seen (say, before and after
+    // enabling CBOR) their ratio is what the binary format saves
+    const double jsonAverage = endpoint.jsonReplies ? double(endpoint.jsonPayloadBytes) / endpoint.jsonReplies : 0.0;
+    const double cborAverage = endpoint.cborReplies ? double(endpoint.cborPayloadBytes) / endpoint.cborReplies : 0.0;
+    map["avgJsonBytes"_L1] = jsonAverage;
+    map["avgCborBytes"_L1] = cborAverage;
+    map["cborSavings"_L1] = jsonAverage > 0 && cborAverage > 0 ? 1.0 - cborAverage / jsonAverage : 0.0;
+    return map;
+}
+
+QVariantList ApiMetrics::endpoints() const
+{
+    QVariantList list;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_endpoints.constBegin(); it != m_endpoints.constEnd(); ++it)
+            list.append(toVariantMap(it.key(), it.value()));
+    }
+    std::sort(list.begin(), list.end(), [](const QVariant &a, const QVariant &b) {
+        return a.toMap().value("avgLatencyMs"_L1).toDouble() > b.toMap().value("avgLatencyMs"_L1).toDouble();
+    });
+    return list;
+}
+
+QVariantMap ApiMetrics::endpoint(const QString &endpoint) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_endpoints.constFind(endpoint);
+    if (it == m_endpoints.constEnd())
+        return QVariantMap();
+    return toVariantMap(it.key(), it.value());
+}
+
+QByteArray ApiMetrics::toJson() const
+{
+    QJsonObject root;
+    root["generatedAt"_L1] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    root["coldStart"_L1] = QJsonObject::fromVariantMap(coldStart());
+    root["endpoints"_L1] = QJsonArray::fromVariantList(endpoints());
+    return QJsonDocument(root).toJson();
+}
+
+QString ApiMetrics::dumpToFile(const QString &path) const
+{
+    QString target = path;
+    if (target.isEmpty()) {
+        const QString directory = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+        QDir().mkpath(directory);
+        target = directory + QStringLiteral("/metrics-%1.json")
+                                 .arg(QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss")));
+    }
+
+    QSaveFile file(target);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ApiMetrics: cannot write" << target << file.errorString();
+        return QString();
+    }
+    file.write(toJson());
+    if (!file.commit()) {
+        qWarning() << "ApiMetrics: cannot commit" << target << file.errorString();
+        return QString();
+    }
+    return target;
+}
+
+void ApiMetrics::reset()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_endpoints.clear();
+    }
+    Q_EMIT updated();
+}
+
+} // namespace NetworkApi
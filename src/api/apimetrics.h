@@ -0,0 +1,90 @@
+// apimetrics.h
+#ifndef APIMETRICS_H
+#define APIMETRICS_H
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QTimer>
+#include <QVariantList>
+#include <array>
+
+namespace NetworkApi {
+
+// Per-endpoint request statistics collected by AbstractApi, keyed like
+// LatencyTracker ("GET /api/v1/products/{id}"). Exposed to QML as
+// "apiMetrics" and dumpable to JSON to attach real numbers to a report.
+// Recording is thread-safe: decode times arrive from the decode pool.
+class ApiMetrics : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(QVariantList endpoints READ endpoints NOTIFY updated)
+    Q_PROPERTY(QVariantMap coldStart READ coldStart NOTIFY updated)
+
+public:
+    static ApiMetrics *instance();
+
+    // Upper bounds of the latency histogram buckets, in milliseconds; the
+    // last bucket collects everything slower
+    static constexpr std::array<int, 9> LatencyBuckets{50, 100, 200, 400, 800, 1600, 3200, 6400, 12800};
+
+    void recordReply(const QString &endpoint, bool failed, qint64 bytesIn, qint64 bytesOut,
+                     qint64 timeToFirstByte, qint64 latency);
+    void recordDecode(const QString &endpoint, qint64 microseconds);
+    // Body size on the wire (compressed) and once decoded, for one 2xx reply
+    void recordPayload(const QString &endpoint, qint64 wireBytes, qint64 payloadBytes, bool cbor);
+    // Time from startup to the first successful reply, once per process
+    void recordColdStart(qint64 firstDataMs, bool prewarmed, bool http2);
+
+    // One map per endpoint, slowest average first
+    QVariantList endpoints() const;
+    Q_INVOKABLE QVariantMap endpoint(const QString &endpoint) const;
+    QVariantMap coldStart() const;
+
+    Q_INVOKABLE QByteArray toJson() const;
+    // An empty path writes metrics-<timestamp>.json to the app data folder.
+    // Returns the path written, or an empty string on failure.
+    Q_INVOKABLE QString dumpToFile(const QString &path = QString()) const;
+    Q_INVOKABLE void reset();
+
+Q_SIGNALS:
+    // Throttled to once a second
+    void updated();
+
+private:
+    ApiMetrics();
+
+    struct Endpoint {
+        qint64 requests = 0;
+        qint64 failures = 0;
+        qint64 bytesIn = 0;
+        qint64 bytesOut = 0;
+        qint64 ttfbSamples = 0;
+        qint64 ttfbTotal = 0;
+        qint64 ttfbMax = 0;
+        qint64 latencyTotal = 0;
+        qint64 latencyMax = 0;
+        std::array<qint64, LatencyBuckets.size() + 1> histogram{};
+        qint64 decodes = 0;
+        qint64 decodeTotalUs = 0;
+        qint64 decodeMaxUs = 0;
+        qint64 wireBytes = 0;
+        qint64 payloadBytes = 0;
+        qint64 jsonReplies = 0;
+        qint64 jsonPayloadBytes = 0;
+        qint64 cborReplies = 0;
+        qint64 cborPayloadBytes = 0;
+    };
+
+    static QVariantMap toVariantMap(const QString &name, const Endpoint &endpoint);
+    void scheduleUpdate();
+
+    mutable QMutex m_mutex;
+    QHash<QString, Endpoint> m_endpoints;
+    QVariantMap m_coldStart;
+    QTimer m_updateTimer;
+};
+
+} // namespace NetworkApi
+
+#endif // APIMETRICS_H
@@ -0,0 +1,332 @@
+// apitrace.cpp
+#include "apitrace.h"
+#include "bufferedreply.h"
+#include "latencytracker.h"
+#include <QCborArray>
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTimer>
+#include <algorithm>
+
+using namespace Qt::StringLiterals;
+
+namespace NetworkApi {
+
+QCborMap TraceExchange::toCbor() const
+{
+    QCborArray headerArray;
+    for (const QNetworkReply::RawHeaderPair &header : headers)
+        headerArray.append(QCborArray{header.first, header.second});
+    return QCborMap{
+        {QStringLiteral("t"), offsetMs},
+        {QStringLiteral("m"), QString::fromLatin1(method)},
+        {QStringLiteral("u"), url},
+        {QStringLiteral("e"), endpoint},
+        {QStringLiteral("s"), status},
+        {QStringLiteral("h"), headerArray},
+        {QStringLiteral("b"), body},
+        {QStringLiteral("w"), wireMs},
+        {QStringLiteral("p"), parseUs},
+        {QStringLiteral("d"), modelUs},
+        {QStringLiteral("T"), totalMs},
+    };
+}
+
+TraceExchange TraceExchange::fromCbor(const QCborMap &map)
+{
+    TraceExchange exchange;
+    exchange.offsetMs = map.value(QStringLiteral("t")).toInteger();
+    exchange.method = map.value(QStringLiteral("m")).toString().toLatin1();
+    exchange.url = map.value(QStringLiteral("u")).toString();
+    exchange.endpoint = map.value(QStringLiteral("e")).toString();
+    exchange.status = int(map.value(QStringLiteral("s")).toInteger());
+    const QCborArray headerArray = map.value(QStringLiteral("h")).toArray();
+    for (const QCborValue &header : headerArray) {
+        const QCborArray pair = header.toArray();
+        exchange.headers.append({pair.at(0).toByteArray(), pair.at(1).toByteArray()});
+    }
+    exchange.body = map.value(QStringLiteral("b")).toByteArray();
+    exchange.wireMs = map.value(QStringLiteral("w")).toInteger(-1);
+    exchange.parseUs = map.value(QStringLiteral("p")).toInteger();
+    exchange.modelUs = map.value(QStringLiteral("d")).toInteger();
+    exchange.totalMs = map.value(QStringLiteral("T")).toInteger();
+    return exchange;
+}
+
+// Answers every request from a trace. Lives on the network thread like the
+// manager it replaces. Requests are matched on method and URL, then on the
+// endpoint; each match hands out the recorded responses in order and keeps
+// repeating the last one.
+class TraceReplayManager : public QNetworkAccessManager
+{
+public:
+    TraceReplayManager(const QList<TraceExchange> &exchanges, bool timed)
+        : m_exchanges(exchanges)
+        , m_timed(timed)
+    {
+        for (qsizetype i = 0; i < m_exchanges.size(); ++i) {
+            const TraceExchange &exchange = m_exchanges.at(i);
+            m_byUrl[QString::fromLatin1(exchange.method) + QLatin1Char(' ') + exchange.url].indices.append(i);
+            m_byEndpoint[exchange.endpoint].indices.append(i);
+        }
+    }
+
+protected:
+    QNetworkReply *createRequest(Operation operation, const QNetworkRequest &request,
+                                 QIODevice *outgoingData) override
+    {
+        Q_UNUSED(outgoingData)
+        const QString endpoint = LatencyTracker::endpointKey(operation, request.url());
+        const QString target = request.url().toString(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::FullyEncoded);
+        auto *reply = new BufferedReply(operation, request, this);
+
+        const TraceExchange *match = next(m_byUrl, endpoint.section(QLatin1Char(' '), 0, 0) + QLatin1Char(' ') + target);
+        if (!match)
+            match = next(m_byEndpoint, endpoint);
+        if (!match) {
+            qWarning() << "ApiTrace: not in the trace:" << endpoint;
+            QTimer::singleShot(0, reply, [reply]() {
+                reply->fulfil(404, {{"Content-Type", "application/json"}}, R"({"message":"Not in the trace"})");
+            });
+            return reply;
+        }
+
+        // A 304 was served from the cache when recorded; its body is the page
+        const int status = match->status == 304 ? 200 : match->status;
+        const QList<QNetworkReply::RawHeaderPair> headers = match->headers;
+        const QByteArray body = match->body;
+        QTimer::singleShot(m_timed ? int(qMax<qint64>(0, match->wireMs)) : 0, reply, [reply, status, headers, body]() {
+            if (status == 0)
+                reply->fail(QNetworkReply::UnknownNetworkError, QStringLiteral("Recorded transport failure"));
+            else
+                reply->fulfil(status, headers, body);
+        });
+        return reply;
+    }
+
+private:
+    struct Queue {
+        QList<qsizetype> indices;
+        qsizetype next = 0;
+    };
+
+    const TraceExchange *next(QHash<QString, Queue> &queues, const QString &key) const
+    {
+        auto it = queues.find(key);
+        if (it == queues.end())
+            return nullptr;
+        const qsizetype index = it->indices.at(qMin(it->next, it->indices.size() - 1));
+        ++it->next;
+        return &m_exchanges.at(index);
+    }
+
+    const QList<TraceExchange> m_exchanges;
+    const bool m_timed;
+    QHash<QString, Queue> m_byUrl;
+    QHash<QString, Queue> m_byEndpoint;
+};
+
+ApiTrace *ApiTrace::instance()
+{
+    static ApiTrace *trace = new ApiTrace();
+    return trace;
+}
+
+ApiTrace::ApiTrace()
+{
+    m_clock.start();
+    const QString replay = qEnvironmentVariable("DIM_TRACE_REPLAY");
+    const QString record = qEnvironmentVariable("DIM_TRACE_RECORD");
+
+    if (!replay.isEmpty()) {
+        m_path = replay;
+        load(replay);
+        m_replaying = true;
+        if (QCoreApplication::instance()) {
+            connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &ApiTrace::writeReport);
+        }
+    } else if (!record.isEmpty()) {
+        m_path = record;
+        m_file.setFileName(record);
+        if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qWarning() << "ApiTrace: cannot write" << record << m_file.errorString();
+            return;
+        }
+        m_recording = true;
+        const QCborMap header{{QStringLiteral("format"), QStringLiteral("dim-trace")},
+                              {QStringLiteral("version"), 1},
+                              {QStringLiteral("recorded"), QDateTime::currentDateTimeUtc().toString(Qt::ISODate)}};
+        m_file.write(QCborValue(header).toCbor());
+        qInfo() << "ApiTrace: recording to" << record;
+    }
+}
+
+std::shared_ptr<TraceExchange> ApiTrace::begin()
+{
+    ApiTrace *trace = instance();
+    if (!trace->m_recording && !trace->m_replaying)
+        return nullptr;
+    auto exchange = std::make_shared<TraceExchange>();
+    exchange->started.start();
+    exchange->offsetMs = trace->m_clock.elapsed();
+    return exchange;
+}
+
+void ApiTrace::finish(const std::shared_ptr<TraceExchange> &exchange)
+{
+    // Never got an answer, e.g. refused by the circuit breaker
+    if (!exchange || exchange->method.isEmpty())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    if (m_recording) {
+        m_file.write(QCborValue(exchange->toCbor()).toCbor());
+        m_file.flush();
+    } else if (m_replaying) {
+        m_after[exchange->endpoint].add(*exchange);
+    }
+}
+
+QNetworkAccessManager *ApiTrace::createReplayManager()
+{
+    const bool timed = qEnvironmentVariable("DIM_TRACE_REPLAY_TIMING") != "none"_L1;
+    qInfo() << "ApiTrace: replaying" << m_recorded.size() << "requests from" << m_path
+            << (timed ? "with recorded timing" : "without delays");
+    return new TraceReplayManager(m_recorded, timed);
+}
+
+void ApiTrace::Totals::add(const TraceExchange &exchange)
+{
+    ++requests;
+    totalMs += exchange.totalMs;
+    parseUs += exchange.parseUs;
+    modelUs += exchange.modelUs;
+    firstMs = firstMs < 0 ? exchange.offsetMs : qMin(firstMs, exchange.offsetMs);
+    lastMs = qMax(lastMs, exchange.offsetMs + exchange.totalMs);
+}
+
+void ApiTrace::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "ApiTrace: cannot read" << path << file.errorString();
+        return;
+    }
+
+    const QByteArray data = file.readAll();
+    QCborStreamReader reader(data);
+    while (reader.isValid()) {
+        const QCborMap map = QCborValue::fromCbor(reader).toMap();
+        if (reader.lastError() != QCborError::NoError)
+            break;
+        if (map.contains(QStringLiteral("format")))
+            continue;
+        TraceExchange exchange = TraceExchange::fromCbor(map);
+        m_before[exchange.endpoint].add(exchange);
+        m_recorded.append(std::move(exchange));
+    }
+}
+
+static QJsonObject averages(qint64 requests, qint64 totalMs, qint64 parseUs, qint64 modelUs)
+{
+    const double n = qMax<qint64>(1, requests);
+    return QJsonObject{
+        {"requests"_L1, requests},
+        {"avgTotalMs"_L1, totalMs / n},
+        {"avgParseMs"_L1, parseUs / n / 1000.0},
+        {"avgModelUpdateMs"_L1, modelUs / n / 1000.0},
+    };
+}
+
+// Per request averages, so a replay that stops early still compares fairly
+static QJsonObject difference(const QJsonObject &before, const QJsonObject &after)
+{
+    QJsonObject result;
+    for (const QString &key : {QStringLiteral("avgTotalMs"), QStringLiteral("avgParseMs"), QStringLiteral("avgModelUpdateMs")})
+        result.insert(key, after.value(key).toDouble() - before.value(key).toDouble());
+    return result;
+}
+
+QByteArray ApiTrace::report() const
+{
+    QMutexLocker locker(&m_mutex);
+
+    Totals before;
+    Totals after;
+    QList<QJsonObject> endpoints;
+    for (auto it = m_before.cbegin(); it != m_before.cend(); ++it) {
+        const Totals &recorded = it.value();
+        const Totals replayed = m_after.value(it.key());
+        const QJsonObject was = averages(recorded.requests, recorded.totalMs, recorded.parseUs, recorded.modelUs);
+        const QJsonObject now = averages(replayed.requests, replayed.totalMs, replayed.parseUs, replayed.modelUs);
+        endpoints.append(QJsonObject{{"endpoint"_L1, it.key()},
+                                     {"recorded"_L1, was},
+                                     {"replayed"_L1, now},
+                                     {"difference"_L1, replayed.requests ? difference(was, now) : QJsonObject()}});
+
+        before.requests += recorded.requests;
+        before.totalMs += recorded.totalMs;
+        before.parseUs += recorded.parseUs;
+        before.modelUs += recorded.modelUs;
+        before.firstMs = before.firstMs < 0 ? recorded.firstMs : qMin(before.firstMs, recorded.firstMs);
+        before.lastMs = qMax(before.lastMs, recorded.lastMs);
+    }
+    for (const Totals &replayed : m_after) {
+        after.requests += replayed.requests;
+        after.totalMs += replayed.totalMs;
+        after.parseUs += replayed.parseUs;
+        after.modelUs += replayed.modelUs;
+        after.firstMs = after.firstMs < 0 ? replayed.firstMs : qMin(after.firstMs, replayed.firstMs);
+        after.lastMs = qMax(after.lastMs, replayed.lastMs);
+    }
+
+    // Biggest regressions first
+    std::sort(endpoints.begin(), endpoints.end(), [](const QJsonObject &a, const QJsonObject &b) {
+        return a["difference"_L1]["avgTotalMs"_L1].toDouble() > b["difference"_L1]["avgTotalMs"_L1].toDouble();
+    });
+    QJsonArray endpointArray;
+    for (const QJsonObject &endpoint : std::as_const(endpoints))
+        endpointArray.append(endpoint);
+
+    QJsonObject was = averages(before.requests, before.totalMs, before.parseUs, before.modelUs);
+    was.insert("wallMs"_L1, before.lastMs - qMax<qint64>(0, before.firstMs));
+    QJsonObject now = averages(after.requests, after.totalMs, after.parseUs, after.modelUs);
+    now.insert("wallMs"_L1, after.lastMs - qMax<qint64>(0, after.firstMs));
+
+    const QJsonObject report{
+        {"trace"_L1, m_path},
+        {"recorded"_L1, was},
+        {"replayed"_L1, now},
+        {"difference"_L1, difference(was, now)},
+        {"endpoints"_L1, endpointArray},
+    };
+    return QJsonDocument(report).toJson();
+}
+
+void ApiTrace::writeReport()
+{
+    const QByteArray json = report();
+    const QJsonObject summary = QJsonDocument::fromJson(json).object();
+    const QJsonObject was = summary["recorded"_L1].toObject();
+    const QJsonObject now = summary["replayed"_L1].toObject();
+    qInfo().nospace() << "ApiTrace: per request total " << now["avgTotalMs"_L1].toDouble() << " ms (recorded "
+                      << was["avgTotalMs"_L1].toDouble() << "), parse " << now["avgParseMs"_L1].toDouble()
+                      << " ms (" << was["avgParseMs"_L1].toDouble() << "), model update "
+                      << now["avgModelUpdateMs"_L1].toDouble() << " ms (" << was["avgModelUpdateMs"_L1].toDouble()
+                      << ")";
+
+    QFile file(m_path + QStringLiteral(".report.json"));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "ApiTrace: cannot write" << file.fileName() << file.errorString();
+        return;
+    }
+    file.write(json);
+    qInfo() << "ApiTrace: report written to" << file.fileName();
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,98 @@
+// apitrace.h
+#ifndef APITRACE_H
+#define APITRACE_H
+
+#include <QCborMap>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QObject>
+#include <memory>
+
+namespace NetworkApi {
+
+// One request through AbstractApi, and where its time went
+struct TraceExchange {
+    QElapsedTimer started;  // dispatched by the API
+    qint64 offsetMs = 0;    // from the start of the trace
+    QByteArray method;
+    QString url;            // path and query
+    QString endpoint;       // LatencyTracker key
+    int status = 0;
+    QList<QNetworkReply::RawHeaderPair> headers;
+    QByteArray body;
+    qint64 wireMs = -1;     // sent to last byte received
+    qint64 parseUs = 0;     // decoding on the decode pool
+    qint64 modelUs = 0;     // delivering the result: API handlers and the models they update
+    qint64 totalMs = 0;     // dispatched to delivered
+
+    QCborMap toCbor() const;
+    static TraceExchange fromCbor(const QCborMap &map);
+};
+
+// Record and replay of real API traffic.
+//
+// DIM_TRACE_RECORD=<file> appends every request AbstractApi completes,
+// with its response and timings, to a trace (a CBOR sequence). Traces hold
+// customer data: treat them like a database dump.
+//
+// DIM_TRACE_REPLAY=<file> swaps the network for the trace: requests are
+// answered from it through the regular pipeline, after the recorded wire
+// time (DIM_TRACE_REPLAY_TIMING=none answers at once). On exit, total,
+// parse and model update times of the run are compared with the recorded
+// ones and written to <file>.report.json.
+class ApiTrace : public QObject
+{
+    Q_OBJECT
+public:
+    static ApiTrace *instance();
+
+    bool isRecording() const { return m_recording; }
+    bool isReplaying() const { return m_replaying; }
+
+    // A new exchange to fill in, or nullptr when neither mode is on
+    static std::shared_ptr<TraceExchange> begin();
+    // Called once the result has been delivered
+    void finish(const std::shared_ptr<TraceExchange> &exchange);
+
+    // The manager to give the APIs while replaying; it answers from the trace
+    QNetworkAccessManager *createReplayManager();
+
+    // The comparison of this run with the trace
+    QByteArray report() const;
+
+private:
+    ApiTrace();
+
+    struct Totals {
+        qint64 requests = 0;
+        qint64 totalMs = 0;
+        qint64 parseUs = 0;
+        qint64 modelUs = 0;
+        qint64 firstMs = -1;
+        qint64 lastMs = 0;
+
+        void add(const TraceExchange &exchange);
+    };
+
+    void load(const QString &path);
+    void writeReport();
+
+    bool m_recording = false;
+    bool m_replaying = false;
+    QString m_path;
+    QElapsedTimer m_clock;
+    QFile m_file;
+    QList<TraceExchange> m_recorded; // replay source
+
+    mutable QMutex m_mutex;
+    QHash<QString, Totals> m_before;
+    QHash<QString, Totals> m_after;
+};
+
+} // namespace NetworkApi
+
+#endif // APITRACE_H
@@ -0,0 +1,151 @@
+// apitransport.cpp
+#include "apitransport.h"
+#include "apimetrics.h"
+#include "networkthread.h"
+#include <QDateTime>
+#include <QNetworkReply>
+#include <QSettings>
+
+namespace NetworkApi {
+
+static const QString SettingsGroup = QStringLiteral("Transport");
+
+ApiTransport *ApiTransport::instance()
+{
+    static ApiTransport *transport = new ApiTransport();
+    return transport;
+}
+
+ApiTransport::ApiTransport()
+    : m_enabled(qEnvironmentVariableIntValue("DIM_TRANSPORT_BASELINE") == 0)
+{
+    QSettings settings(QStringLiteral("Dervox"), QStringLiteral("DGest"));
+    m_preferCbor = settings.value(SettingsGroup + QStringLiteral("/preferCbor"), true).toBool();
+
+#if QT_CONFIG(ssl)
+    m_sslConfiguration = QSslConfiguration::defaultConfiguration();
+    if (m_enabled) {
+        m_sslConfiguration.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+        m_sslConfiguration.setAllowedNextProtocols({QSslConfiguration::ALPNProtocolHTTP2,
+                                                    QSslConfiguration::NextProtocolHttp1_1});
+        restoreSessionTicket();
+    }
+#endif
+}
+
+void ApiTransport::attach(QNetworkAccessManager *manager)
+{
+    m_manager = manager;
+    m_sinceAttach.start();
+    // Handled where the replies live, before they can be deleted
+    connect(manager, &QNetworkAccessManager::finished, manager, [this](QNetworkReply *reply) {
+        replyFinished(reply);
+    });
+    if (!m_enabled)
+        qInfo() << "ApiTransport: baseline mode, no prewarming, session reuse or HTTP/2";
+}
+
+void ApiTransport::prewarm(const QUrl &host)
+{
+    if (!m_enabled || !m_manager || host.host().isEmpty())
+        return;
+
+    // Resolves the name and opens (for HTTPS, negotiates) the connection
+    // the first API requests will then pick up from the manager's pool
+    m_prewarmed = true;
+    QPointer<QNetworkAccessManager> manager = m_manager;
+#if QT_CONFIG(ssl)
+    if (host.scheme() == QLatin1String("https")) {
+        const QSslConfiguration configuration = sslConfiguration();
+        NetworkThread::post([manager, host, configuration]() {
+            if (manager)
+                manager->connectToHostEncrypted(host.host(), quint16(host.port(443)), configuration);
+        });
+        return;
+    }
+#endif
+    NetworkThread::post([manager, host]() {
+        if (manager)
+            manager->connectToHost(host.host(), quint16(host.port(80)));
+    });
+}
+
+void ApiTransport::setPreferCbor(bool prefer)
+{
+    if (m_preferCbor == prefer)
+        return;
+    m_preferCbor = prefer;
+    QSettings settings(QStringLiteral("Dervox"), QStringLiteral("DGest"));
+    settings.setValue(SettingsGroup + QStringLiteral("/preferCbor"), prefer);
+}
+
+void ApiTransport::configure(QNetworkRequest &request) const
+{
+    // Accept-Encoding is left to Qt: setting it by hand turns off the
+    // transparent decompression
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, m_enabled);
+#if QT_CONFIG(ssl)
+    if (request.url().scheme() == QLatin1String("https"))
+        request.setSslConfiguration(sslConfiguration());
+#endif
+}
+
+void ApiTransport::replyFinished(QNetworkReply *reply)
+{
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (!m_coldStartRecorded && reply->error() == QNetworkReply::NoError && status >= 200 && status < 400) {
+        m_coldStartRecorded = true;
+        const qint64 elapsed = m_sinceAttach.elapsed();
+        const bool http2 = reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+        qInfo() << "ApiTransport: first data after" << elapsed << "ms, prewarmed" << m_prewarmed << "HTTP/2" << http2;
+        ApiMetrics::instance()->recordColdStart(elapsed, m_prewarmed, http2);
+    }
+
+#if QT_CONFIG(ssl)
+    if (!m_enabled || reply->url().scheme() != QLatin1String("https"))
+        return;
+    const QSslConfiguration negotiated = reply->sslConfiguration();
+    const QByteArray ticket = negotiated.sessionTicket();
+    if (ticket.isEmpty())
+        return;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (ticket == m_sslConfiguration.sessionTicket())
+            return;
+        m_sslConfiguration.setSessionTicket(ticket);
+    }
+    storeSessionTicket(ticket, negotiated.sessionTicketLifeTimeHint());
+#endif
+}
+
+#if QT_CONFIG(ssl)
+QSslConfiguration ApiTransport::sslConfiguration() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_sslConfiguration;
+}
+#endif
+
+void ApiTransport::restoreSessionTicket()
+{
+#if QT_CONFIG(ssl)
+    QSettings settings(QStringLiteral("Dervox"), QStringLiteral("DGest"));
+    settings.beginGroup(SettingsGroup);
+    const QByteArray ticket = settings.value(QStringLiteral("sessionTicket")).toByteArray();
+    const QDateTime expires = settings.value(QStringLiteral("sessionTicketExpires")).toDateTime();
+    if (!ticket.isEmpty() && expires.isValid() && expires > QDateTime::currentDateTimeUtc())
+        m_sslConfiguration.setSessionTicket(ticket);
+#endif
+}
+
+void ApiTransport::storeSessionTicket(const QByteArray &ticket, int lifetimeHint)
+{
+    // Servers that send no hint still expire tickets; a day is the usual cap
+    const int lifetime = lifetimeHint > 0 ? lifetimeHint : 24 * 60 * 60;
+    QSettings settings(QStringLiteral("Dervox"), QStringLiteral("DGest"));
+    settings.beginGroup(SettingsGroup);
+    settings.setValue(QStringLiteral("sessionTicket"), ticket);
+    settings.setValue(QStringLiteral("sessionTicketExpires"), QDateTime::currentDateTimeUtc().addSecs(lifetime));
+}
+
+} // namespace NetworkApi
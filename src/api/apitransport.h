@@ -0,0 +1,73 @@
+// apitransport.h
+#ifndef APITRANSPORT_H
+#define APITRANSPORT_H
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QObject>
+#include <QPointer>
+#include <QUrl>
+#if QT_CONFIG(ssl)
+#include <QSslConfiguration>
+#endif
+
+namespace NetworkApi {
+
+// Connection setup for the shared QNetworkAccessManager:
+//
+// - every API request allows HTTP/2, so parallel list and analytics calls
+//   are multiplexed over one connection instead of opening up to six;
+// - the connection to the API host is opened while the UI loads, so the
+//   first request after login does not pay for DNS, TCP and TLS;
+// - the TLS session ticket is kept in the settings and offered again on the
+//   next start, which turns the first handshake into a resumption.
+//
+// The time from attach() to the first successful reply is reported to
+// ApiMetrics as the cold start. Setting DIM_TRANSPORT_BASELINE=1 disables
+// all of the above, to measure the difference.
+class ApiTransport : public QObject
+{
+    Q_OBJECT
+public:
+    static ApiTransport *instance();
+
+    void attach(QNetworkAccessManager *manager);
+    void prewarm(const QUrl &host);
+
+    // Applied by AbstractApi::createRequest() to every API request; safe to
+    // call from any thread
+    void configure(QNetworkRequest &request) const;
+
+    // Whether AbstractApi::acceptCbor() asks for application/cbor bodies
+    // (JSON stays acceptable). On by default; persisted in the settings.
+    bool preferCbor() const { return m_preferCbor; }
+    void setPreferCbor(bool prefer);
+
+private:
+    ApiTransport();
+
+    void replyFinished(QNetworkReply *reply);
+#if QT_CONFIG(ssl)
+    QSslConfiguration sslConfiguration() const;
+#endif
+    void restoreSessionTicket();
+    void storeSessionTicket(const QByteArray &ticket, int lifetimeHint);
+
+    QPointer<QNetworkAccessManager> m_manager;
+    bool m_enabled = true;
+    bool m_prewarmed = false;
+    bool m_coldStartRecorded = false;
+    bool m_preferCbor = true;
+    QElapsedTimer m_sinceAttach;
+#if QT_CONFIG(ssl)
+    // Updated on the network thread as tickets arrive
+    mutable QMutex m_mutex;
+    QSslConfiguration m_sslConfiguration;
+#endif
+};
+
+} // namespace NetworkApi
+
+#endif // APITRANSPORT_H
@@ -0,0 +1,116 @@
+// bufferedreply.cpp
+#include "bufferedreply.h"
+
+namespace NetworkApi {
+
+BufferedReply::BufferedReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request,
+                             QObject *parent)
+    : QNetworkReply(parent)
+{
+    setOperation(operation);
+    setRequest(request);
+    setUrl(request.url());
+    open(QIODevice::ReadOnly);
+}
+
+static QNetworkReply::NetworkError errorForStatus(int status)
+{
+    switch (status) {
+    case 400: return QNetworkReply::ProtocolInvalidOperationError;
+    case 401: return QNetworkReply::AuthenticationRequiredError;
+    case 403: return QNetworkReply::ContentAccessDenied;
+    case 404: return QNetworkReply::ContentNotFoundError;
+    case 405: return QNetworkReply::ContentOperationNotPermittedError;
+    case 409: return QNetworkReply::ContentConflictError;
+    case 410: return QNetworkReply::ContentGoneError;
+    case 500: return QNetworkReply::InternalServerError;
+    case 501: return QNetworkReply::OperationNotImplementedError;
+    case 503: return QNetworkReply::ServiceUnavailableError;
+    default:
+        break;
+    }
+    if (status >= 400 && status < 500)
+        return QNetworkReply::UnknownContentError;
+    if (status >= 500)
+        return QNetworkReply::UnknownServerError;
+    return QNetworkReply::NoError;
+}
+
+void BufferedReply::fulfil(int httpStatus, const QList<RawHeaderPair> &headers, const QByteArray &body)
+{
+    if (isFinished())
+        return;
+
+    setAttribute(QNetworkRequest::HttpStatusCodeAttribute, httpStatus);
+    for (const RawHeaderPair &header : headers)
+        setRawHeader(header.first, header.second);
+    m_body = body;
+
+    const NetworkError error = errorForStatus(httpStatus);
+    QString message;
+    if (error != NoError)
+        message = QStringLiteral("Error transferring %1 - server replied: %2").arg(url().toString()).arg(httpStatus);
+    finish(error, message);
+}
+
+void BufferedReply::fulfilFrom(QNetworkReply *source)
+{
+    if (isFinished())
+        return;
+
+    for (const auto attribute : {QNetworkRequest::HttpStatusCodeAttribute, QNetworkRequest::HttpReasonPhraseAttribute,
+                                 QNetworkRequest::Http2WasUsedAttribute}) {
+        setAttribute(attribute, source->attribute(attribute));
+    }
+    for (const RawHeaderPair &header : source->rawHeaderPairs())
+        setRawHeader(header.first, header.second);
+    m_body = source->readAll();
+    finish(source->error(), source->error() != NoError ? source->errorString() : QString());
+}
+
+void BufferedReply::fail(NetworkError error, const QString &message)
+{
+    if (isFinished())
+        return;
+    finish(error, message);
+}
+
+void BufferedReply::abort()
+{
+    if (isFinished())
+        return;
+    m_body.clear();
+    finish(OperationCanceledError, QStringLiteral("Operation canceled"));
+}
+
+void BufferedReply::finish(NetworkError error, const QString &message)
+{
+    if (error != NoError)
+        setError(error, message);
+    setFinished(true);
+
+    Q_EMIT metaDataChanged();
+    Q_EMIT downloadProgress(m_body.size(), m_body.size());
+    if (!m_body.isEmpty())
+        Q_EMIT readyRead();
+    if (error != NoError)
+        Q_EMIT errorOccurred(error);
+    Q_EMIT finished();
+}
+
+qint64 BufferedReply::bytesAvailable() const
+{
+    return m_body.size() - m_offset + QNetworkReply::bytesAvailable();
+}
+
+qint64 BufferedReply::readData(char *data, qint64 maxSize)
+{
+    if (m_offset >= m_body.size())
+        return isFinished() ? -1 : 0;
+    const qint64 count = qMin(maxSize, m_body.size() - m_offset);
+    memcpy(data, m_body.constData() + m_offset, size_t(count));
+    m_offset += count;
+    return count;
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,44 @@
+// bufferedreply.h
+#ifndef BUFFEREDREPLY_H
+#define BUFFEREDREPLY_H
+
+#include <QNetworkReply>
+
+namespace NetworkApi {
+
+// A QNetworkReply whose outcome is supplied by the application instead of a
+// socket: the answer to one call of a batch, or a recorded response. To the
+// request pipeline it looks like any other reply, so status codes, headers,
+// the response cache and the retry policy all work on it unchanged.
+class BufferedReply : public QNetworkReply
+{
+    Q_OBJECT
+public:
+    BufferedReply(QNetworkAccessManager::Operation operation, const QNetworkRequest &request,
+                  QObject *parent = nullptr);
+
+    // Completes the reply with an HTTP response. Error statuses map to the
+    // NetworkError Qt would report for them.
+    void fulfil(int httpStatus, const QList<RawHeaderPair> &headers, const QByteArray &body);
+    // Completes the reply with the outcome of a real one
+    void fulfilFrom(QNetworkReply *source);
+    // Completes the reply with a transport error
+    void fail(NetworkError error, const QString &message);
+
+    void abort() override;
+    qint64 bytesAvailable() const override;
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+
+private:
+    void finish(NetworkError error, const QString &message);
+
+    QByteArray m_body;
+    qint64 m_offset = 0;
+};
+
+} // namespace NetworkApi
+
+#endif // BUFFEREDREPLY_H
@@ -1,12 +1,13 @@
 // cashsourceapi.cpp (complete implementation)
 #include "cashsourceapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
-CashSource CashSourceApi::cashSourceFromJson(const QJsonObject &json) const
+CashSource CashSourceApi::cashSourceFromJson(const QJsonObject &json)
 {
     CashSource source;
     source.id = json["id"_L1].toInt();
@@ -66,7 +67,7 @@ QJsonObject CashSourceApi::cashSourceToJson(const CashSource &source) const
 
 
 
-PaginatedCashSources CashSourceApi::paginatedCashSourcesFromJson(const QJsonObject &json) const
+PaginatedCashSources CashSourceApi::paginatedCashSourcesFromJson(const QJsonObject &json)
 {
     PaginatedCashSources result;
     const QJsonObject &meta = json["cash_sources"_L1].toObject();
@@ -74,6 +75,7 @@ PaginatedCashSources CashSourceApi::paginatedCashSourcesFromJson(const QJsonObje
     result.lastPage = meta["last_page"_L1].toInt();
     result.perPage = meta["per_page"_L1].toInt();
     result.total = meta["total"_L1].toInt();
+    result.nextCursor = meta["next_cursor"_L1].toString();
 
     const QJsonArray &dataArray = meta["data"_L1].toArray();
     for (const QJsonValue &value : dataArray) {
@@ -139,33 +141,27 @@ CashSourceApi::CashSourceApi(QNetworkAccessManager *netManager, QObject *parent)
 }
 
 QFuture<void> CashSourceApi::getCashSources(const QString &search, const QString &sortBy,
-                                            const QString &sortDirection, int page)
+                                            const QString &sortDirection, int page,
+                                            const std::optional<QString> &cursor)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/cash-sources");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-
-    if (!queryParts.isEmpty()) {
-         path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .pagination(page, cursor)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedCashSources>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedCashSourcesFromJson, QStringLiteral("cashSources")).then([=](ApiResponse<PaginatedCashSources> response) {
         if (response.success) {
-            PaginatedCashSources paginatedSources = paginatedCashSourcesFromJson(*response.data);
+            const PaginatedCashSources &paginatedSources = *response.data;
             Q_EMIT cashSourcesReceived(paginatedSources);
         } else {
             Q_EMIT errorCashSourcesReceived(response.error->message, response.error->status,
@@ -183,8 +179,8 @@ QFuture<void> CashSourceApi::getCashSource(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/cash-sources/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             CashSource source = cashSourceFromJson(response.data->value("cash_source"_L1).toObject());
@@ -211,8 +207,8 @@ QFuture<void> CashSourceApi::createCashSource(const CashSource &source)
 
     QJsonObject jsonData = cashSourceToJson(source);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             CashSource createdSource = cashSourceFromJson(response.data->value("cash_source"_L1).toObject());
@@ -242,8 +238,8 @@ QFuture<void> CashSourceApi::updateCashSource(int id, const CashSource &source)
     qDebug() << "Updating cash source. URL:" << request.url().toString();
  //   qDebug() << "Request data:" << QStringLiteral(jsonString);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, jsonString);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, jsonString);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "Update success response:" << *response.data;
@@ -268,8 +264,8 @@ QFuture<void> CashSourceApi::deleteCashSource(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/cash-sources/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT cashSourceDeleted(id);
@@ -299,8 +295,8 @@ QFuture<void> CashSourceApi::deposit(int id, double amount, const QString &notes
     qDebug() << "Sending deposit request to:" << request.url().toString();
     //qDebug() << "Request data:" << QStringLiteral(jsonString);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, jsonString);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, jsonString);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "Deposit success response:" << *response.data;
@@ -342,8 +338,8 @@ QFuture<void> CashSourceApi::withdraw(int id, double amount, const QString &note
     qDebug() << "Sending withdrawal request to:" << request.url().toString();
   //  qDebug() << "Request data:" << QStringLiteral(jsonString);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, jsonString);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, jsonString);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "Withdrawal success response:" << *response.data;
@@ -385,8 +381,8 @@ QFuture<void> CashSourceApi::transfer(const TransferData &transferData)
     qDebug() << "Sending transfer request to:" << request.url().toString();
    // qDebug() << "Request data:" << QStringLiteral(jsonString);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, jsonString);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, jsonString);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "Transfer success response:" << *response.data;
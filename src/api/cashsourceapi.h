@@ -19,7 +19,6 @@ struct CashSource {
     QString bank_name;      // Add this field
     QString status;
     bool is_default;
-    bool checked = false;
 };
 
 struct PaginatedCashSources {
@@ -28,6 +27,7 @@ struct PaginatedCashSources {
     int lastPage;
     int perPage;
     int total;
+    QString nextCursor; // keyset pagination; empty after the last page
 };
 
 struct TransferData {
@@ -48,7 +48,8 @@ public:
     Q_INVOKABLE QFuture<void> getCashSources(const QString &search = QString(),
                                             const QString &sortBy = QStringLiteral("created_at"),
                                             const QString &sortDirection = QStringLiteral("desc"),
-                                            int page = 1);
+                                            int page = 1,
+                                            const std::optional<QString> &cursor = std::nullopt);
     Q_INVOKABLE QFuture<void> getCashSource(int id);
     Q_INVOKABLE QFuture<void> createCashSource(const CashSource &cashSource);
     Q_INVOKABLE QFuture<void> updateCashSource(int id, const CashSource &cashSource);
@@ -90,9 +91,9 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    CashSource cashSourceFromJson(const QJsonObject &json) const;
+    static CashSource cashSourceFromJson(const QJsonObject &json);
     QJsonObject cashSourceToJson(const CashSource &cashSource) const;
-    PaginatedCashSources paginatedCashSourcesFromJson(const QJsonObject &json) const;
+    static PaginatedCashSources paginatedCashSourcesFromJson(const QJsonObject &json);
     QVariantMap cashSourceToVariantMap(const CashSource &cashSource) const;
     QVariantMap transactionToVariantMap(const QJsonObject &json) const;
 
@@ -1,5 +1,6 @@
 // cashtransactionapi.cpp
 #include "cashtransactionapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
@@ -28,40 +29,31 @@ QFuture<void> CashTransactionApi::getTransactions(
     setLoading(true);
     QString path = QStringLiteral("/api/v1/transactions");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-    if (!type.isEmpty())
-        queryParts << QStringLiteral("type=%1").arg(type);
+    ListQuery query;
+    query.search(search)
+        .sort(sortBy, sortDirection)
+        .page(page)
+        .add("type"_L1, type)
+        .add("start_date"_L1, startDate)
+        .add("end_date"_L1, endDate);
     if (cashSourceId > 0)
-        queryParts << QStringLiteral("cash_source_id=%1").arg(cashSourceId);
+        query.add("cash_source_id"_L1, cashSourceId);
     if (minAmount > 0)
-        queryParts << QStringLiteral("min_amount=%1").arg(minAmount);
+        query.add("min_amount"_L1, minAmount);
     if (maxAmount > 0)
-        queryParts << QStringLiteral("max_amount=%1").arg(maxAmount);
-    if (startDate.isValid())
-        queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(Qt::ISODate));
-    if (endDate.isValid())
-        queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(Qt::ISODate));
-
-    if (!queryParts.isEmpty()) {
-      path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+        query.add("max_amount"_L1, maxAmount);
+    path = query.path(path);
+
     qDebug()<<"path : "<<path;
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedCashTransactions>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedTransactionsFromJson, QStringLiteral("transactions")).then([=](ApiResponse<PaginatedCashTransactions> response) {
         if (response.success) {
-            PaginatedCashTransactions paginatedTransactions = paginatedTransactionsFromJson(*response.data);
+            const PaginatedCashTransactions &paginatedTransactions = *response.data;
             Q_EMIT transactionsReceived(paginatedTransactions);
         } else {
             Q_EMIT errorTransactionsReceived(response.error->message, response.error->status,
@@ -79,8 +71,8 @@ QFuture<void> CashTransactionApi::getTransaction(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/transactions/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             CashTransaction transaction = transactionFromJson(response.data->value("transaction"_L1).toObject());
@@ -100,18 +92,17 @@ QFuture<void> CashTransactionApi::getTransactionsBySource(int sourceId, int page
     setLoading(true);
     QString path = QStringLiteral("/api/v1/transactions/by-source/%1").arg(sourceId);
 
-    if (page > 0) {
-        path += QStringLiteral("?page=%1").arg(page);
-    }
+    path = ListQuery().page(page).path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedCashTransactions>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedTransactionsFromJson, QStringLiteral("transactionsBySource")).then([=](ApiResponse<PaginatedCashTransactions> response) {
         if (response.success) {
-            PaginatedCashTransactions paginatedTransactions = paginatedTransactionsFromJson(*response.data);
+            const PaginatedCashTransactions &paginatedTransactions = *response.data;
             Q_EMIT transactionsBySourceReceived(paginatedTransactions);
         } else {
             Q_EMIT errorTransactionsBySourceReceived(response.error->message, response.error->status,
@@ -128,20 +119,15 @@ QFuture<void> CashTransactionApi::getSummary(const QDateTime &startDate, const Q
     setLoading(true);
     QString path = QStringLiteral("/api/v1/transactions/summary");
 
-    QStringList queryParts;
-    if (startDate.isValid())
-        queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(Qt::ISODate));
-    if (endDate.isValid())
-        queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(Qt::ISODate));
-
-    if (!queryParts.isEmpty()) {
-         path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .add("start_date"_L1, startDate)
+               .add("end_date"_L1, endDate)
+               .path(path);
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT summaryReceived(response.data->value("summary"_L1).toObject().toVariantMap());
@@ -156,7 +142,7 @@ QFuture<void> CashTransactionApi::getSummary(const QDateTime &startDate, const Q
 }
 
 // Helper Methods
-CashTransaction CashTransactionApi::transactionFromJson(const QJsonObject &json) const
+CashTransaction CashTransactionApi::transactionFromJson(const QJsonObject &json)
 {
     CashTransaction transaction;
     transaction.id = json["id"_L1].toInt();
@@ -180,7 +166,7 @@ CashTransaction CashTransactionApi::transactionFromJson(const QJsonObject &json)
     return transaction;
 }
 
-PaginatedCashTransactions CashTransactionApi::paginatedTransactionsFromJson(const QJsonObject &json) const
+PaginatedCashTransactions CashTransactionApi::paginatedTransactionsFromJson(const QJsonObject &json)
 {
     PaginatedCashTransactions result;
     const QJsonObject &meta = json["transactions"_L1].toObject();
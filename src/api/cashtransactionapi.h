@@ -20,7 +20,6 @@ struct CashTransaction {
     QString description;
     QVariantMap cash_source;
     QVariantMap transfer_destination;  // Changed from related_document to match backend
-    bool checked = false;
 };
 
 struct PaginatedCashTransactions {
@@ -81,9 +80,9 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    CashTransaction transactionFromJson(const QJsonObject &json) const;
+    static CashTransaction transactionFromJson(const QJsonObject &json);
     QVariantMap transactionToVariantMap(const CashTransaction &transaction) const;
-    PaginatedCashTransactions paginatedTransactionsFromJson(const QJsonObject &json) const;
+    static PaginatedCashTransactions paginatedTransactionsFromJson(const QJsonObject &json);
 
     QSettings m_settings;
     bool m_isLoading = false;
@@ -0,0 +1,95 @@
+// circuitbreaker.cpp
+#include "circuitbreaker.h"
+#include <QDebug>
+
+namespace NetworkApi {
+
+namespace {
+constexpr int FailureThreshold = 5;
+constexpr qint64 InitialOpenTime = 5 * 1000;
+constexpr qint64 MaximumOpenTime = 2 * 60 * 1000;
+// The longest a reply may stall before it times out (see LatencyTracker)
+constexpr qint64 ProbeTimeout = 60 * 1000;
+}
+
+CircuitBreaker::CircuitBreaker()
+    : m_initialOpenTime(InitialOpenTime)
+    , m_probeTimeout(ProbeTimeout)
+{
+}
+
+CircuitBreaker *CircuitBreaker::instance()
+{
+    static CircuitBreaker breaker;
+    return &breaker;
+}
+
+QString CircuitBreaker::hostKey(const QUrl &url)
+{
+    return url.adjusted(QUrl::RemoveUserInfo | QUrl::RemovePath | QUrl::RemoveQuery | QUrl::RemoveFragment)
+        .toString();
+}
+
+bool CircuitBreaker::allowRequest(const QString &host)
+{
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end())
+        return true;
+
+    switch (it->state) {
+    case State::Closed:
+        return true;
+    case State::HalfOpen:
+        // A probe whose outcome was never recorded must not lock the host out
+        if (it->openedAt.isValid() && it->openedAt.elapsed() < m_probeTimeout)
+            return false;
+        qDebug() << "CircuitBreaker: probe overdue for" << host;
+        it->openedAt.start();
+        return true;
+    case State::Open:
+        if (it->openedAt.isValid() && it->openedAt.elapsed() < it->openFor)
+            return false;
+        it->state = State::HalfOpen;
+        it->openedAt.start();
+        return true;
+    }
+    return true;
+}
+
+void CircuitBreaker::recordSuccess(const QString &host)
+{
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end())
+        return;
+    if (it->state != State::Closed)
+        qDebug() << "CircuitBreaker: closed for" << host;
+    m_hosts.erase(it);
+}
+
+void CircuitBreaker::recordFailure(const QString &host)
+{
+    Host &entry = m_hosts[host];
+    if (entry.state == State::HalfOpen) {
+        entry.openFor = qMin(entry.openFor * 2, MaximumOpenTime);
+    } else if (entry.state == State::Closed && ++entry.failures >= FailureThreshold) {
+        entry.openFor = m_initialOpenTime;
+    } else {
+        return;
+    }
+
+    entry.state = State::Open;
+    entry.openedAt.start();
+    qDebug() << "CircuitBreaker: open for" << host << "during" << entry.openFor << "ms";
+}
+
+void CircuitBreaker::recordAbandoned(const QString &host)
+{
+    auto it = m_hosts.find(host);
+    if (it == m_hosts.end() || it->state != State::HalfOpen)
+        return;
+    // Let the next request probe right away
+    it->state = State::Open;
+    it->openedAt.invalidate();
+}
+
+} // namespace NetworkApi
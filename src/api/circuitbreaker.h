@@ -0,0 +1,56 @@
+// circuitbreaker.h
+#ifndef CIRCUITBREAKER_H
+#define CIRCUITBREAKER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QString>
+#include <QUrl>
+
+class CircuitBreakerTest;
+
+namespace NetworkApi {
+
+// Per-host circuit breaker shared by every API instance. After a run of
+// transport failures the host is considered down and requests fail fast
+// instead of piling up; once the cool-down has passed a single probe is let
+// through, and its outcome closes the circuit or re-opens it for longer. A
+// probe that never reports back is given up after the longest reply timeout.
+// Only used from the thread that owns the network manager.
+class CircuitBreaker
+{
+    friend class ::CircuitBreakerTest;
+
+public:
+    static CircuitBreaker *instance();
+
+    static QString hostKey(const QUrl &url);
+
+    // False while the host is open, or half-open with a probe in flight that
+    // is not overdue
+    bool allowRequest(const QString &host);
+    void recordSuccess(const QString &host);
+    void recordFailure(const QString &host);
+    // A request that ended without an outcome (aborted); frees the probe
+    void recordAbandoned(const QString &host);
+
+private:
+    CircuitBreaker();
+
+    enum class State { Closed, Open, HalfOpen };
+
+    struct Host {
+        State state = State::Closed;
+        int failures = 0;
+        qint64 openFor = 0;
+        QElapsedTimer openedAt; // or, half-open, when the probe was let through
+    };
+
+    QHash<QString, Host> m_hosts;
+    qint64 m_initialOpenTime;
+    qint64 m_probeTimeout;
+};
+
+} // namespace NetworkApi
+
+#endif // CIRCUITBREAKER_H
@@ -1,5 +1,7 @@
 // clientapi.cpp
 #include "clientapi.h"
+#include "listquery.h"
+#include "jsondecoders.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
@@ -13,7 +15,7 @@ ClientApi::ClientApi(QNetworkAccessManager *netManager, QObject *parent)
 }
 
 // Helper Methods
-Client ClientApi::clientFromJson(const QJsonObject &json) const
+Client ClientApi::clientFromJson(const QJsonObject &json)
 {
     Client client;
     client.id = json["id"_L1].toInt();
@@ -59,22 +61,6 @@ QJsonObject ClientApi::clientToJson(const Client &client) const
 }
 
 
-PaginatedClients ClientApi::paginatedClientsFromJson(const QJsonObject &json) const
-{
-    PaginatedClients result;
-    const QJsonObject &meta = json["clients"_L1].toObject();
-    result.currentPage = meta["current_page"_L1].toInt();
-    result.lastPage = meta["last_page"_L1].toInt();
-    result.perPage = meta["per_page"_L1].toInt();
-    result.total = meta["total"_L1].toInt();
-
-    const QJsonArray &dataArray = meta["data"_L1].toArray();
-    for (const QJsonValue &value : dataArray) {
-        result.data.append(clientFromJson(value.toObject()));
-    }
-
-    return result;
-}
 
 QVariantMap ClientApi::clientToVariantMap(const Client &client) const
 {
@@ -103,35 +89,27 @@ QVariantMap ClientApi::clientToVariantMap(const Client &client) const
 // API Methods
 QFuture<void> ClientApi::getClients(const QString &search, const QString &sortBy,
                                    const QString &sortDirection, int page,
-                                   const QString &status)
+                                   const QString &status,
+                                   const std::optional<QString> &cursor)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/clients");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-    if (!status.isEmpty())
-        queryParts << QStringLiteral("status=%1").arg(status);
-
-    if (!queryParts.isEmpty()) {
-       path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .pagination(page, cursor)
+               .add("status"_L1, status)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeStreamDecodedRequest<PaginatedClients>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &decodePaginatedClients, QStringLiteral("clients")).then([=](ApiResponse<PaginatedClients> response) {
         if (response.success) {
-            PaginatedClients paginatedClients = paginatedClientsFromJson(*response.data);
+            const PaginatedClients &paginatedClients = *response.data;
             Q_EMIT clientsReceived(paginatedClients);
         } else {
             Q_EMIT errorClientsReceived(response.error->message, response.error->status,
@@ -149,12 +127,13 @@ QFuture<void> ClientApi::getClient(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/clients/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Client client = clientFromJson(response.data->value("client"_L1).toObject());
             Q_EMIT clientReceived(clientToVariantMap(client));
+            Q_EMIT clientDetailsReceived(client);
         } else {
             Q_EMIT errorClientReceived(response.error->message, response.error->status,
                                    QJsonDocument(response.error->details).toJson());
@@ -174,8 +153,8 @@ QFuture<void> ClientApi::createClient(const Client &client)
 
     QJsonObject jsonData = clientToJson(client);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Client createdClient = clientFromJson(response.data->value("client"_L1).toObject());
@@ -199,8 +178,8 @@ QFuture<void> ClientApi::updateClient(int id, const Client &client)
 
     QJsonObject jsonData = clientToJson(client);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Client updatedClient = clientFromJson(response.data->value("client"_L1).toObject());
@@ -215,14 +194,59 @@ QFuture<void> ClientApi::updateClient(int id, const Client &client)
     return future.then([=]() {});
 }
 
+// base with the members clientToJson() sends taken from edit: the client
+// the server holds once a patch applies
+static Client applyClientEdit(const Client &base, const Client &edit)
+{
+    Client client = edit;
+    client.id = base.id;
+    client.balance = base.balance;
+    return client;
+}
+
+QFuture<void> ClientApi::patchClient(const Client &base, const Client &client)
+{
+    const QJsonObject changes = changedMembers(clientToJson(base), clientToJson(client));
+    if (changes.isEmpty()) {
+        Q_EMIT clientUpdated(base);
+        return QtFuture::makeReadyVoidFuture();
+    }
+
+    setLoading(true);
+    QNetworkRequest request = createRequest(QStringLiteral("/api/v1/clients/%1").arg(base.id));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+    request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+
+    // What the server holds once the patch applies, should its reply leave
+    // some of the changed members out
+    const Client patched = applyClientEdit(base, client);
+
+    auto future = makeStreamDecodedRequest<Client>([=](QNetworkAccessManager *network) {
+        return sendPatch(network, request, changes);
+    }, [patched](QByteArrayView body) {
+        // 204 No Content: the patch applied as sent
+        return body.isEmpty() ? std::optional<Client>(patched) : decodeClient(body, patched);
+    }).then([=](ApiResponse<Client> response) {
+        if (response.success) {
+            Q_EMIT clientUpdated(*response.data);
+        } else {
+            Q_EMIT errorClientUpdated(response.error->message, response.error->status,
+                                    QJsonDocument(response.error->details).toJson());
+        }
+        setLoading(false);
+    });
+
+    return future.then([=]() {});
+}
+
 QFuture<void> ClientApi::deleteClient(int id)
 {
     setLoading(true);
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/clients/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT clientDeleted(id);
@@ -240,15 +264,13 @@ QFuture<void> ClientApi::getSales(int id, int page)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/clients/%1/sales").arg(id);
-    if (page > 0) {
-        path += QStringLiteral("?page=%1").arg(page);
-    }
+    path = ListQuery().page(page).path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QJsonObject salesObj = response.data->value("sales"_L1).toObject();
@@ -296,15 +318,13 @@ QFuture<void> ClientApi::getPayments(int id, int page)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/clients/%1/transactions").arg(id);
-    if (page > 0) {
-        path += QStringLiteral("?page=%1").arg(page);
-    }
+    path = ListQuery().page(page).path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QVariantMap result;
@@ -355,8 +375,8 @@ QFuture<void> ClientApi::getStatistics(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/clients/%1/statement").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             // Just pass the whole response data
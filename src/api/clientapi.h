@@ -26,7 +26,6 @@ struct Client {
     QString notes;
     QString status;
     double balance;
-    bool checked = false;
 };
 
 
@@ -36,6 +35,7 @@ struct PaginatedClients {
     int lastPage;
     int perPage;
     int total;
+    QString nextCursor; // keyset pagination; empty after the last page
 };
 
 class ClientApi : public AbstractApi {
@@ -50,11 +50,15 @@ public:
                                         const QString &sortBy = QStringLiteral("created_at"),
                                         const QString &sortDirection = QStringLiteral("desc"),
                                         int page = 1,
-                                        const QString &status = QString());
+                                        const QString &status = QString(),
+                                        const std::optional<QString> &cursor = std::nullopt);
 
     Q_INVOKABLE QFuture<void> getClient(int id);
     Q_INVOKABLE QFuture<void> createClient(const Client &client);
     Q_INVOKABLE QFuture<void> updateClient(int id, const Client &client);
+    // PATCH with only the members client changes from base, the client as
+    // the server last sent it; see ProductApi::patchProduct()
+    QFuture<void> patchClient(const Client &base, const Client &client);
     Q_INVOKABLE QFuture<void> deleteClient(int id);
 
     // Additional operations
@@ -72,6 +76,8 @@ Q_SIGNALS:
     // Success signals
     void clientsReceived(const PaginatedClients &clients);
     void clientReceived(const QVariantMap &client);
+    // The same client, for the models
+    void clientDetailsReceived(const Client &client);
     void clientCreated(const Client &client);
     void clientUpdated(const Client &client);
     void clientDeleted(int id);
@@ -92,9 +98,8 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    Client clientFromJson(const QJsonObject &json) const;
+    static Client clientFromJson(const QJsonObject &json);
     QJsonObject clientToJson(const Client &client) const;
-    PaginatedClients paginatedClientsFromJson(const QJsonObject &json) const;
     QVariantMap clientToVariantMap(const Client &client) const;
 
     QSettings m_settings;
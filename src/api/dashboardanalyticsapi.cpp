@@ -1,4 +1,5 @@
 #include "dashboardanalyticsapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -10,6 +11,8 @@ DashboardAnalyticsApi::DashboardAnalyticsApi(QNetworkAccessManager *netManager,
     : AbstractApi(netManager, parent)
    ,  m_settings(QStringLiteral("Dervox"), QStringLiteral("DGest"))
 {
+    // A dashboard refresh must never hold up the till
+    setDefaultPriority(RequestPriority::Background);
 }
 void DashboardAnalyticsApi::provideFakeData()
 {
@@ -168,40 +171,31 @@ QFuture<void> DashboardAnalyticsApi::getSalesAnalytics(const QString &timeframe,
     setLoading(true);
 
         QString path = QStringLiteral("/api/v1/dashboard/sales-analytics");
-        QStringList queryParts;
-
-        // Always add timeframe
-        queryParts << QStringLiteral("timeframe=%1").arg(timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
+        ListQuery query;
+        query.add("timeframe"_L1, timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
 
         // For "daily" timeframe, set both start and end date to today if not provided
         if (timeframe ==  QStringLiteral("daily") && (!startDate.isValid() || !endDate.isValid())) {
-            QDate today = QDate::currentDate();
-            queryParts << QStringLiteral("start_date=%1").arg(today.toString( QStringLiteral("yyyy-MM-dd")));
-            queryParts << QStringLiteral("end_date=%1").arg(today.toString( QStringLiteral("yyyy-MM-dd")));
+            const QString today = QDate::currentDate().toString(QStringLiteral("yyyy-MM-dd"));
+            query.add("start_date"_L1, today).add("end_date"_L1, today);
         } else {
-            // Use provided dates
-            if (startDate.isValid())
-                queryParts << QStringLiteral("start_date=%1").arg(startDate.toString( QStringLiteral("yyyy-MM-dd")));
-            if (endDate.isValid())
-                queryParts << QStringLiteral("end_date=%1").arg(endDate.toString( QStringLiteral("yyyy-MM-dd")));
-        }
-
-        // Append query parameters to path
-        if (!queryParts.isEmpty()) {
-            path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
+            // Use provided dates; invalid ones format as empty and are left out
+            query.add("start_date"_L1, startDate.toString(QStringLiteral("yyyy-MM-dd")))
+                .add("end_date"_L1, endDate.toString(QStringLiteral("yyyy-MM-dd")));
         }
+        path = query.path(path);
 
         QNetworkRequest request = createRequest(path);
         request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+        acceptCbor(request);
 
         qDebug() << "Making analytics request to:" << request.url().toString();
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<SaleAnalytics>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &salesAnalyticsFromJson).then([=](ApiResponse<SaleAnalytics> response) {
         if (response.success) {
-            SaleAnalytics analytics = salesAnalyticsFromJson(*response.data);
-            qDebug()<<"getSalesAnalytics data : "<<*response.data;
+            const SaleAnalytics &analytics = *response.data;
             Q_EMIT salesAnalyticsReceived(analytics);
         } else {
             qDebug() << "Sales Analytics Error:";
@@ -235,28 +229,21 @@ QFuture<void> DashboardAnalyticsApi::getPurchaseAnalytics(const QString &timefra
     setLoading(true);
 
     QString path = QStringLiteral("/api/v1/dashboard/purchase-analytics");
-    QStringList queryParts;
-
-    queryParts << QStringLiteral("timeframe=%1").arg(timeframe.isEmpty() ?  QStringLiteral("daily") : timeframe);
-
-    if (startDate.isValid())
-        queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(QStringLiteral("yyyy-MM-dd")));
-    if (endDate.isValid())
-        queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(QStringLiteral("yyyy-MM-dd")));
-
-    if (!queryParts.isEmpty()) {
-        path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .add("timeframe"_L1, timeframe.isEmpty() ? QStringLiteral("daily") : timeframe)
+               .add("start_date"_L1, startDate.toString(QStringLiteral("yyyy-MM-dd")))
+               .add("end_date"_L1, endDate.toString(QStringLiteral("yyyy-MM-dd")))
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PurchaseAnalytics>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &purchaseAnalyticsFromJson).then([=](ApiResponse<PurchaseAnalytics> response) {
         if (response.success) {
-            PurchaseAnalytics analytics = purchaseAnalyticsFromJson(*response.data);
-            qDebug()<<"getPurchaseAnalytics data : "<<*response.data;
+            const PurchaseAnalytics &analytics = *response.data;
 
             Q_EMIT purchaseAnalyticsReceived(analytics);
         } else {
@@ -284,33 +271,24 @@ QFuture<void> DashboardAnalyticsApi::getInventoryAnalytics(const QString &timefr
     setLoading(true);
 
     QString path =  QStringLiteral("/api/v1/dashboard/inventory-analytics");
-    QStringList queryParts;
-
-    // Always add timeframe
-    queryParts << QStringLiteral("timeframe=%1").arg(timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
+    ListQuery query;
+    query.add("timeframe"_L1, timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
 
     // For "daily" timeframe, set both start and end date to today if not provided
     if (timeframe ==  QStringLiteral("daily") && (!startDate.isValid() || !endDate.isValid())) {
-        QDate today = QDate::currentDate();
-        queryParts << QStringLiteral("start_date=%1").arg(today.toString(QStringLiteral("yyyy-MM-dd")));
-        queryParts << QStringLiteral("end_date=%1").arg(today.toString(QStringLiteral("yyyy-MM-dd")));
+        const QString today = QDate::currentDate().toString(QStringLiteral("yyyy-MM-dd"));
+        query.add("start_date"_L1, today).add("end_date"_L1, today);
     } else {
-        // Use provided dates
-        if (startDate.isValid())
-            queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(QStringLiteral("yyyy-MM-dd")));
-        if (endDate.isValid())
-            queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(QStringLiteral("yyyy-MM-dd")));
-    }
-
-    // Append query parameters to path
-    if (!queryParts.isEmpty()) {
-        path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
+        // Use provided dates; invalid ones format as empty and are left out
+        query.add("start_date"_L1, startDate.toString(QStringLiteral("yyyy-MM-dd")))
+            .add("end_date"_L1, endDate.toString(QStringLiteral("yyyy-MM-dd")));
     }
+    path = query.path(path);
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "getInventoryAnalytics data : " << *response.data;
@@ -333,35 +311,26 @@ QFuture<void> DashboardAnalyticsApi::getCustomerAnalytics(const QString &timefra
     setLoading(true);
 
     QString path = QStringLiteral("/api/v1/dashboard/customer-analytics");
-    QStringList queryParts;
-
-    // Always add timeframe
-    queryParts << QStringLiteral("timeframe=%1").arg(timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
+    ListQuery query;
+    query.add("timeframe"_L1, timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
 
     // For "daily" timeframe, set both start and end date to today if not provided
-    if (timeframe == QStringLiteral("daily") && (!startDate.isValid() || !endDate.isValid())) {
-        QDate today = QDate::currentDate();
-        queryParts << QStringLiteral("start_date=%1").arg(today.toString(QStringLiteral("yyyy-MM-dd")));
-        queryParts << QStringLiteral("end_date=%1").arg(today.toString(QStringLiteral("yyyy-MM-dd")));
+    if (timeframe ==  QStringLiteral("daily") && (!startDate.isValid() || !endDate.isValid())) {
+        const QString today = QDate::currentDate().toString(QStringLiteral("yyyy-MM-dd"));
+        query.add("start_date"_L1, today).add("end_date"_L1, today);
     } else {
-        // Use provided dates
-        if (startDate.isValid())
-            queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(QStringLiteral("yyyy-MM-dd")));
-        if (endDate.isValid())
-            queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(QStringLiteral("yyyy-MM-dd")));
-    }
-
-    // Append query parameters to path
-    if (!queryParts.isEmpty()) {
-       path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
+        // Use provided dates; invalid ones format as empty and are left out
+        query.add("start_date"_L1, startDate.toString(QStringLiteral("yyyy-MM-dd")))
+            .add("end_date"_L1, endDate.toString(QStringLiteral("yyyy-MM-dd")));
     }
+    path = query.path(path);
 
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "getCustomerAnalytics data : " << *response.data;
@@ -383,33 +352,24 @@ QFuture<void> DashboardAnalyticsApi::getOverallDashboard(const QString &timefram
     setLoading(true);
 
     QString path =  QStringLiteral("/api/v1/dashboard/overall");
-    QStringList queryParts;
-
-    // Always add timeframe
-    queryParts << QStringLiteral("timeframe=%1").arg(timeframe.isEmpty() ? QStringLiteral("daily"): timeframe);
+    ListQuery query;
+    query.add("timeframe"_L1, timeframe.isEmpty() ? QStringLiteral("daily") : timeframe);
 
     // For "daily" timeframe, set both start and end date to today if not provided
-    if (timeframe == QStringLiteral("daily") && (!startDate.isValid() || !endDate.isValid())) {
-        QDate today = QDate::currentDate();
-        queryParts << QStringLiteral("start_date=%1").arg(today.toString(QStringLiteral("yyyy-MM-dd")));
-        queryParts << QStringLiteral("end_date=%1").arg(today.toString(QStringLiteral("yyyy-MM-dd")));
+    if (timeframe ==  QStringLiteral("daily") && (!startDate.isValid() || !endDate.isValid())) {
+        const QString today = QDate::currentDate().toString(QStringLiteral("yyyy-MM-dd"));
+        query.add("start_date"_L1, today).add("end_date"_L1, today);
     } else {
-        // Use provided dates
-        if (startDate.isValid())
-            queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(QStringLiteral("yyyy-MM-dd")));
-        if (endDate.isValid())
-            queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(QStringLiteral("yyyy-MM-dd")));
-    }
-
-    // Append query parameters to path
-    if (!queryParts.isEmpty()) {
-       path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
+        // Use provided dates; invalid ones format as empty and are left out
+        query.add("start_date"_L1, startDate.toString(QStringLiteral("yyyy-MM-dd")))
+            .add("end_date"_L1, endDate.toString(QStringLiteral("yyyy-MM-dd")));
     }
+    path = query.path(path);
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             qDebug() << "getOverallDashboard data : " << *response.data;
@@ -435,7 +395,7 @@ void DashboardAnalyticsApi::saveToken(const QString &token) {
     m_token = token;
 }
 
-SaleAnalytics DashboardAnalyticsApi::salesAnalyticsFromJson(const QJsonObject &json) const
+SaleAnalytics DashboardAnalyticsApi::salesAnalyticsFromJson(const QJsonObject &json)
 {
     SaleAnalytics analytics;
     const QJsonObject &data = json["data"_L1].toObject();
@@ -474,7 +434,7 @@ SaleAnalytics DashboardAnalyticsApi::salesAnalyticsFromJson(const QJsonObject &j
     return analytics;
 }
 
-PurchaseAnalytics DashboardAnalyticsApi::purchaseAnalyticsFromJson(const QJsonObject &json) const
+PurchaseAnalytics DashboardAnalyticsApi::purchaseAnalyticsFromJson(const QJsonObject &json)
 {
     PurchaseAnalytics analytics;
     const QJsonObject &data = json["data"_L1].toObject();
@@ -511,7 +471,7 @@ PurchaseAnalytics DashboardAnalyticsApi::purchaseAnalyticsFromJson(const QJsonOb
     return analytics;
 }
 
-InventoryAnalytics DashboardAnalyticsApi::inventoryAnalyticsFromJson(const QJsonObject &json) const
+InventoryAnalytics DashboardAnalyticsApi::inventoryAnalyticsFromJson(const QJsonObject &json)
 {
     InventoryAnalytics analytics;
     const QJsonObject &data = json["data"_L1].toObject();
@@ -540,7 +500,7 @@ InventoryAnalytics DashboardAnalyticsApi::inventoryAnalyticsFromJson(const QJson
     return analytics;
 }
 
-DashboardOverview DashboardAnalyticsApi::dashboardOverviewFromJson(const QJsonObject &json) const
+DashboardOverview DashboardAnalyticsApi::dashboardOverviewFromJson(const QJsonObject &json)
 {
     DashboardOverview overview;
     const QJsonObject &data = json["data"_L1].toObject();
@@ -116,10 +116,10 @@ Q_SIGNALS:
     void testModeChanged();
 
 private:
-    SaleAnalytics salesAnalyticsFromJson(const QJsonObject &json) const;
-    PurchaseAnalytics purchaseAnalyticsFromJson(const QJsonObject &json) const;
-    InventoryAnalytics inventoryAnalyticsFromJson(const QJsonObject &json) const;
-    DashboardOverview dashboardOverviewFromJson(const QJsonObject &json) const;
+    static SaleAnalytics salesAnalyticsFromJson(const QJsonObject &json);
+    static PurchaseAnalytics purchaseAnalyticsFromJson(const QJsonObject &json);
+    static InventoryAnalytics inventoryAnalyticsFromJson(const QJsonObject &json);
+    static DashboardOverview dashboardOverviewFromJson(const QJsonObject &json);
 
     QSettings m_settings;
     bool m_isLoading = false;
@@ -1,4 +1,6 @@
 #include "invoiceapi.h"
+#include "listquery.h"
+#include "jsondecoders.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
@@ -13,7 +15,7 @@ InvoiceApi::InvoiceApi(QNetworkAccessManager *netManager, QObject *parent)
 }
 
 // Helper Methods
-Invoice InvoiceApi::invoiceFromJson(const QJsonObject &json) const
+Invoice InvoiceApi::invoiceFromJson(const QJsonObject &json)
 {
     Invoice invoice;
     invoice.id = json["id"_L1].toInt();
@@ -54,7 +56,7 @@ Invoice InvoiceApi::invoiceFromJson(const QJsonObject &json) const
     return invoice;
 }
 
-InvoiceItem InvoiceApi::invoiceItemFromJson(const QJsonObject &json) const
+InvoiceItem InvoiceApi::invoiceItemFromJson(const QJsonObject &json)
 {
     InvoiceItem item;
     item.id = json["id"_L1].toInt();
@@ -174,22 +176,6 @@ QJsonObject InvoiceApi::paymentToJson(const InvoicePayment &payment) const
     return json;
 }
 
-PaginatedInvoices InvoiceApi::paginatedInvoicesFromJson(const QJsonObject &json) const
-{
-    PaginatedInvoices result;
-    const QJsonObject &meta = json["invoices"_L1].toObject();
-    result.currentPage = meta["current_page"_L1].toInt();
-    result.lastPage = meta["last_page"_L1].toInt();
-    result.perPage = meta["per_page"_L1].toInt();
-    result.total = meta["total"_L1].toInt();
-
-    const QJsonArray &dataArray = meta["data"_L1].toArray();
-    for (const QJsonValue &value : dataArray) {
-        result.data.append(invoiceFromJson(value.toObject()));
-    }
-
-    return result;
-}
 
 QFuture<void> InvoiceApi::getInvoices(const QString &search, const QString &sortBy,
                                       const QString &sortDirection, int page,
@@ -201,35 +187,24 @@ QFuture<void> InvoiceApi::getInvoices(const QString &search, const QString &sort
     setLoading(true);
     QString path = QStringLiteral("/api/v1/invoices");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-    if (!status.isEmpty())
-        queryParts << QStringLiteral("status=%1").arg(status);
-    if (!paymentStatus.isEmpty())
-        queryParts << QStringLiteral("payment_status=%1").arg(paymentStatus);
-    if (startDate.isValid())
-        queryParts << QStringLiteral("start_date=%1").arg(startDate.toString(Qt::ISODate));
-    if (endDate.isValid())
-        queryParts << QStringLiteral("end_date=%1").arg(endDate.toString(Qt::ISODate));
-    if (!queryParts.isEmpty()) {
-        path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .page(page)
+               .add("status"_L1, status)
+               .add("payment_status"_L1, paymentStatus)
+               .add("start_date"_L1, startDate)
+               .add("end_date"_L1, endDate)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeStreamDecodedRequest<PaginatedInvoices>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &decodePaginatedInvoices, QStringLiteral("invoices")).then([=](ApiResponse<PaginatedInvoices> response) {
         if (response.success) {
-            PaginatedInvoices paginatedInvoices = paginatedInvoicesFromJson(*response.data);
+            const PaginatedInvoices &paginatedInvoices = *response.data;
             Q_EMIT invoicesReceived(paginatedInvoices);
         } else {
             Q_EMIT errorInvoicesReceived(response.error->message, response.error->status,
@@ -247,8 +222,8 @@ QFuture<void> InvoiceApi::getInvoice(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/invoices/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Invoice invoice = invoiceFromJson(response.data->value("invoice"_L1).toObject());
@@ -272,8 +247,8 @@ QFuture<void> InvoiceApi::createInvoice(const Invoice &invoice)
 
     QJsonObject jsonData = invoiceToJson(invoice);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Invoice createdInvoice = invoiceFromJson(response.data->value("invoice"_L1).toObject());
@@ -297,8 +272,8 @@ QFuture<void> InvoiceApi::updateInvoice(int id, const Invoice &invoice)
 
     QJsonObject jsonData = invoiceToJson(invoice);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Invoice updatedInvoice = invoiceFromJson(response.data->value("invoice"_L1).toObject());
@@ -319,8 +294,8 @@ QFuture<void> InvoiceApi::deleteInvoice(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/invoices/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT invoiceDeleted(id);
@@ -343,8 +318,8 @@ QFuture<void> InvoiceApi::addPayment(int id, const InvoicePayment &payment)
 
     QJsonObject jsonData = paymentToJson(payment);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT paymentAdded(response.data->value("payment"_L1).toObject().toVariantMap());
@@ -363,8 +338,8 @@ QFuture<void> InvoiceApi::markAsEmailSent(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/invoices/%1/mark-email-sent").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QByteArray());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QByteArray());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Invoice invoice = invoiceFromJson(response.data->value("invoice"_L1).toObject());
@@ -387,17 +362,17 @@ QFuture<QByteArray> InvoiceApi::generatePdf(int id)
 
     auto promise = std::make_shared<QPromise<QByteArray>>();
 
-    m_currentReply = m_netManager->get(request);
-
-    connect(m_currentReply, &QNetworkReply::finished, this, [this, promise]() {
+    makeRawRequest([=](QNetworkAccessManager *network) {
+        return network->get(request);
+    }).then(this, [this, promise](const RawResponse &reply) {
         setLoading(false);
 
-        if (m_currentReply->error() == QNetworkReply::NoError) {
+        if (reply.networkError == QNetworkReply::NoError) {
             // Get the content type
-            QString contentType = m_currentReply->header(QNetworkRequest::ContentTypeHeader).toString();
+            QString contentType = QString::fromLatin1(reply.header("Content-Type"));
 
             if (contentType.contains("application/pdf"_L1)) {
-                QByteArray pdfData = m_currentReply->readAll();
+                QByteArray pdfData = reply.body;
 
                 // Save to app's data location instead of /tmp
                 QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -422,20 +397,18 @@ QFuture<QByteArray> InvoiceApi::generatePdf(int id)
                 }
             } else if (contentType.contains("application/json"_L1)) {
                 // Handle error response
-                QJsonDocument jsonResponse = QJsonDocument::fromJson(m_currentReply->readAll());
+                QJsonDocument jsonResponse = QJsonDocument::fromJson(reply.body);
                 QJsonObject jsonObject = jsonResponse.object();
                 QString errorMessage = jsonObject["message"_L1].toString();
                 Q_EMIT errorPdfGenerated("Error"_L1, errorMessage);
                 promise->addResult(QByteArray());
             }
         } else {
-            Q_EMIT errorPdfGenerated("Network Error"_L1, m_currentReply->errorString());
+            Q_EMIT errorPdfGenerated("Network Error"_L1, reply.errorString);
             promise->addResult(QByteArray());
         }
 
         promise->finish();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
     });
 
     return promise->future();
@@ -456,8 +429,8 @@ QFuture<QByteArray> InvoiceApi::generatePdf(int id)
 //     connect(m_currentReply, &QNetworkReply::finished, this, [this, promise]() {
 //         setLoading(false);
 
-//         if (m_currentReply->error() == QNetworkReply::NoError) {
-//             QByteArray pdfData = m_currentReply->readAll();
+//         if (reply.networkError == QNetworkReply::NoError) {
+//             QByteArray pdfData = reply.body;
 
 //             try {
 //                 // Save PDF to temporary file
@@ -489,8 +462,8 @@ QFuture<QByteArray> InvoiceApi::generatePdf(int id)
 //                 promise->addResult(QByteArray());
 //             }
 //         } else {
-//             qWarning() << "Network error:" << m_currentReply->errorString();
-//             Q_EMIT errorPdfGenerated("Failed to download PDF", m_currentReply->errorString());
+//             qWarning() << "Network error:" << reply.errorString;
+//             Q_EMIT errorPdfGenerated("Failed to download PDF", reply.errorString);
 //             promise->addResult(QByteArray());
 //         }
 
@@ -503,7 +476,7 @@ QFuture<QByteArray> InvoiceApi::generatePdf(int id)
 //     connect(m_currentReply, &QNetworkReply::errorOccurred, this, [this, promise](QNetworkReply::NetworkError error) {
 //         qWarning() << "Network error occurred:" << error;
 //         setLoading(false);
-//         Q_EMIT errorPdfGenerated("Network error", m_currentReply->errorString());
+//         Q_EMIT errorPdfGenerated("Network error", reply.errorString);
 //         promise->addResult(QByteArray());
 //         promise->finish();
 //     });
@@ -517,8 +490,8 @@ QFuture<void> InvoiceApi::sendToClient(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/invoices/%1/send").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QByteArray());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QByteArray());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT invoiceSent(response.data->value("result"_L1).toObject().toVariantMap());
@@ -538,8 +511,8 @@ QFuture<void> InvoiceApi::markAsSent(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/invoices/%1/mark-as-sent").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QByteArray());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QByteArray());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Invoice invoice = invoiceFromJson(response.data->value("invoice"_L1).toObject());
@@ -560,8 +533,8 @@ QFuture<void> InvoiceApi::markAsPaid(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/invoices/%1/mark-as-paid").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QByteArray());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QByteArray());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Invoice invoice = invoiceFromJson(response.data->value("invoice"_L1).toObject());
@@ -580,15 +553,13 @@ QFuture<void> InvoiceApi::getSummary(const QString &period)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/invoices/summary");
-    if (!period.isEmpty()) {
-        path += QStringLiteral("?period=%1").arg(period);
-    }
+    path = ListQuery().add("period"_L1, period).path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(getToken()).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT summaryReceived(response.data->value("summary"_L1).toObject().toVariantMap());
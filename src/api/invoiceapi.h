@@ -41,7 +41,6 @@ struct Invoice {
     QString notes;
     QVariantMap meta_data;
     QList<InvoiceItem> items;
-    bool checked = false;
 
     // Helper methods for UI compatibility
     QString getPaymentStatus() const {
@@ -88,6 +87,7 @@ struct PaginatedInvoices {
     int lastPage;
     int perPage;
     int total;
+    QString nextCursor; // keyset pagination; empty after the last page
 };
 
 struct InvoicePayment {
@@ -105,6 +105,10 @@ class InvoiceApi : public AbstractApi {
 public:
     explicit InvoiceApi(QNetworkAccessManager *netManager, QObject *parent = nullptr);
 
+    // JSON decoding; pure, so it can run on the decode pool (and in dim_bench)
+    static Invoice invoiceFromJson(const QJsonObject &json);
+    static InvoiceItem invoiceItemFromJson(const QJsonObject &json);
+
     // CRUD operations
     Q_INVOKABLE QFuture<void> getInvoices(const QString &search = QString(),
                                           const QString &sortBy = QStringLiteral("issue_date"),
@@ -168,13 +172,9 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    QNetworkReply* m_currentReply = nullptr;
-    Invoice invoiceFromJson(const QJsonObject &json) const;
-    InvoiceItem invoiceItemFromJson(const QJsonObject &json) const;
     QJsonObject invoiceToJson(const Invoice &invoice) const;
     QJsonObject invoiceItemToJson(const InvoiceItem &item) const;
     QJsonObject paymentToJson(const InvoicePayment &payment) const;
-    PaginatedInvoices paginatedInvoicesFromJson(const QJsonObject &json) const;
     QVariantMap invoiceToVariantMap(const Invoice &invoice) const;
     QVariantMap invoiceItemToVariantMap(const InvoiceItem &item) const;
     QSettings m_settings;
@@ -0,0 +1,270 @@
+// jsondecoders.cpp
+#include "jsondecoders.h"
+
+namespace NetworkApi {
+
+namespace {
+using namespace JsonFields;
+
+// The tables mirror productFromJson(), saleFromJson(), clientFromJson() and
+// invoiceFromJson(), including their conversions: amounts the backend sends
+// as strings are read with numericString, stock levels go through toInt().
+
+constexpr JsonField<ProductUnit> ProductUnitFields[] = {
+    integer<&ProductUnit::id>("id"),
+    string<&ProductUnit::name>("name"),
+};
+
+constexpr JsonField<ProductPackageProduct> ProductPackageFields[] = {
+    integer<&ProductPackageProduct::id>("id"),
+    string<&ProductPackageProduct::name>("name"),
+    integer<&ProductPackageProduct::pieces_per_package>("pieces_per_package"),
+    number<&ProductPackageProduct::purchase_price>("purchase_price"),
+    number<&ProductPackageProduct::selling_price>("selling_price"),
+    string<&ProductPackageProduct::barcode>("barcode"),
+};
+
+constexpr JsonField<Product> ProductFields[] = {
+    integer<&Product::id>("id"),
+    string<&Product::reference>("reference"),
+    string<&Product::name>("name"),
+    string<&Product::description>("description"),
+    integer<&Product::price>("price"),
+    integer<&Product::purchase_price>("purchase_price"),
+    dateTime<&Product::expiredDate>("expired_date"),
+    integer<&Product::quantity>("quantity"),
+    integer<&Product::productUnitId>("product_unit_id"),
+    string<&Product::sku>("sku"),
+    value<&Product::minStockLevel, &JsonReader::readInt>("min_stock_level"),
+    value<&Product::maxStockLevel, &JsonReader::readInt>("max_stock_level"),
+    value<&Product::reorderPoint, &JsonReader::readInt>("reorder_point"),
+    string<&Product::location>("location"),
+    string<&Product::image_path>("image_path"),
+    {"unit", [](JsonReader &reader, Product &product) {
+        readObject(reader, product.unit, ProductUnitFields);
+    }},
+    {"packages", [](JsonReader &reader, Product &product) {
+        product.packages.clear();
+        product.packagesValue.clear();
+        readList(reader, product.packages, ProductPackageFields);
+    }},
+};
+
+constexpr JsonField<SaleItem> SaleItemFields[] = {
+    integer<&SaleItem::id>("id"),
+    integer<&SaleItem::product_id>("product_id"),
+    string<&SaleItem::product_name>("product_name"),
+    integer<&SaleItem::quantity>("quantity"),
+    numericString<&SaleItem::unit_price>("unit_price"),
+    numericString<&SaleItem::total_price>("total_price"),
+    numericString<&SaleItem::tax_rate>("tax_rate"),
+    numericString<&SaleItem::tax_amount>("tax_amount"),
+    numericString<&SaleItem::discount_amount>("discount_amount"),
+    string<&SaleItem::notes>("notes"),
+    boolean<&SaleItem::is_package>("is_package"),
+    integer<&SaleItem::package_id>("package_id"),
+    integer<&SaleItem::total_pieces>("total_pieces"),
+    variantMap<&SaleItem::product>("product"),
+    variantMap<&SaleItem::package>("package"),
+};
+
+constexpr JsonField<Sale> SaleFields[] = {
+    integer<&Sale::id>("id"),
+    integer<&Sale::team_id>("team_id"),
+    integer<&Sale::client_id>("client_id"),
+    integer<&Sale::cash_source_id>("cash_source_id"),
+    string<&Sale::reference_number>("reference_number"),
+    numericString<&Sale::total_amount>("total_amount"),
+    numericString<&Sale::paid_amount>("paid_amount"),
+    numericString<&Sale::tax_amount>("tax_amount"),
+    numericString<&Sale::discount_amount>("discount_amount"),
+    string<&Sale::payment_status>("payment_status"),
+    string<&Sale::status>("status"),
+    string<&Sale::type>("type"),
+    dateTime<&Sale::sale_date>("sale_date"),
+    dateTime<&Sale::due_date>("due_date"),
+    dateTime<&Sale::createdAt>("created_at"),
+    string<&Sale::notes>("notes"),
+    variantMap<&Sale::client>("client"),
+    {"items", [](JsonReader &reader, Sale &sale) {
+        sale.items.clear();
+        sale.itemsValue.clear();
+        readList(reader, sale.items, SaleItemFields);
+    }},
+};
+
+constexpr JsonField<Client> ClientFields[] = {
+    integer<&Client::id>("id"),
+    string<&Client::name>("name"),
+    string<&Client::email>("email"),
+    string<&Client::phone>("phone"),
+    string<&Client::address>("address"),
+    string<&Client::tax_number>("tax_number"),
+    string<&Client::if_number>("if_number"),
+    string<&Client::rc_number>("rc_number"),
+    string<&Client::cnss_number>("cnss_number"),
+    string<&Client::tp_number>("tp_number"),
+    string<&Client::nis_number>("nis_number"),
+    string<&Client::nif_number>("nif_number"),
+    string<&Client::ai_number>("ai_number"),
+    string<&Client::payment_terms>("payment_terms"),
+    string<&Client::notes>("notes"),
+    string<&Client::status>("status"),
+    numericString<&Client::balance>("balance"),
+};
+
+constexpr JsonField<InvoiceItem> InvoiceItemFields[] = {
+    integer<&InvoiceItem::id>("id"),
+    string<&InvoiceItem::description>("description"),
+    integer<&InvoiceItem::quantity>("quantity"),
+    number<&InvoiceItem::unit_price>("unit_price"),
+    number<&InvoiceItem::total_price>("total_price"),
+    string<&InvoiceItem::notes>("notes"),
+};
+
+constexpr JsonField<Invoice> InvoiceFields[] = {
+    integer<&Invoice::id>("id"),
+    integer<&Invoice::team_id>("team_id"),
+    string<&Invoice::reference_number>("reference_number"),
+    string<&Invoice::type>("type"),
+    string<&Invoice::invoiceable_type>("invoiceable_type"),
+    integer<&Invoice::invoiceable_id>("invoiceable_id"),
+    numericString<&Invoice::total_amount>("total_amount"),
+    numericString<&Invoice::tax_amount>("tax_amount"),
+    numericString<&Invoice::discount_amount>("discount_amount"),
+    string<&Invoice::status>("status"),
+    string<&Invoice::payment_status>("payment_status"),
+    boolean<&Invoice::is_email_sent>("is_email_sent"),
+    dateTime<&Invoice::issue_date>("issue_date"),
+    dateTime<&Invoice::due_date>("due_date"),
+    string<&Invoice::notes>("notes"),
+    // meta_data and invoiceable may come in either order; invoiceable_data
+    // wins, as in invoiceFromJson()
+    {"meta_data", [](JsonReader &reader, Invoice &invoice) {
+        QVariantMap metaData = reader.readVariantMap();
+        metaData.insert(invoice.meta_data);
+        invoice.meta_data = metaData;
+    }},
+    {"invoiceable", [](JsonReader &reader, Invoice &invoice) {
+        if (!reader.isNull())
+            invoice.meta_data.insert(QStringLiteral("invoiceable_data"), reader.readVariantMap());
+    }},
+    {"items", [](JsonReader &reader, Invoice &invoice) {
+        readList(reader, invoice.items, InvoiceItemFields);
+    }},
+};
+
+// Decodes {"<envelope>": {"current_page": .., "data": [..], ...}}
+template<typename Page, typename Row, std::size_t N>
+std::optional<Page> decodePage(QByteArrayView body, QByteArrayView envelope, const JsonField<Row> (&fields)[N])
+{
+    JsonReader reader(body);
+    if (!reader.enterObject())
+        return std::nullopt;
+
+    Page page{};
+    QByteArrayView key;
+    while (reader.nextKey(key)) {
+        if (sameKey(key, "errors"))
+            return std::nullopt;
+        if (sameKey(key, "error")) {
+            if (reader.readBool())
+                return std::nullopt;
+            continue;
+        }
+        if (!sameKey(key, envelope) || !reader.peekObject()) {
+            reader.skipValue();
+            continue;
+        }
+
+        reader.enterObject();
+        while (reader.nextKey(key)) {
+            if (sameKey(key, "data"))
+                readList(reader, page.data, fields);
+            else if (sameKey(key, "current_page"))
+                page.currentPage = reader.readInt();
+            else if (sameKey(key, "last_page"))
+                page.lastPage = reader.readInt();
+            else if (sameKey(key, "per_page"))
+                page.perPage = reader.readInt();
+            else if (sameKey(key, "total"))
+                page.total = reader.readInt();
+            else if (sameKey(key, "next_cursor"))
+                page.nextCursor = reader.readString();
+            else
+                reader.skipValue();
+        }
+    }
+
+    if (reader.hasError())
+        return std::nullopt;
+    return page;
+}
+
+// Decodes {"<envelope>": {...}} over row
+template<typename Row, std::size_t N>
+std::optional<Row> decodeEntity(QByteArrayView body, QByteArrayView envelope, Row row, const JsonField<Row> (&fields)[N])
+{
+    JsonReader reader(body);
+    if (!reader.enterObject())
+        return std::nullopt;
+
+    QByteArrayView key;
+    while (reader.nextKey(key)) {
+        if (sameKey(key, "errors"))
+            return std::nullopt;
+        if (sameKey(key, "error")) {
+            if (reader.readBool())
+                return std::nullopt;
+            continue;
+        }
+        if (!sameKey(key, envelope) || !reader.peekObject()) {
+            reader.skipValue();
+            continue;
+        }
+        readObject(reader, row, fields);
+    }
+
+    if (reader.hasError())
+        return std::nullopt;
+    return row;
+}
+
+} // namespace
+
+std::optional<PaginatedProducts> decodePaginatedProducts(QByteArrayView body)
+{
+    return decodePage<PaginatedProducts>(body, "products", ProductFields);
+}
+
+std::optional<PaginatedSales> decodePaginatedSales(QByteArrayView body)
+{
+    return decodePage<PaginatedSales>(body, "sales", SaleFields);
+}
+
+std::optional<PaginatedClients> decodePaginatedClients(QByteArrayView body)
+{
+    return decodePage<PaginatedClients>(body, "clients", ClientFields);
+}
+
+std::optional<PaginatedInvoices> decodePaginatedInvoices(QByteArrayView body)
+{
+    return decodePage<PaginatedInvoices>(body, "invoices", InvoiceFields);
+}
+
+std::optional<Product> decodeProduct(QByteArrayView body, const Product &row)
+{
+    return decodeEntity(body, "product", row, ProductFields);
+}
+
+std::optional<Sale> decodeSale(QByteArrayView body, const Sale &row)
+{
+    return decodeEntity(body, "sale", row, SaleFields);
+}
+
+std::optional<Client> decodeClient(QByteArrayView body, const Client &row)
+{
+    return decodeEntity(body, "client", row, ClientFields);
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,136 @@
+// jsondecoders.h
+#ifndef JSONDECODERS_H
+#define JSONDECODERS_H
+
+#include "jsonreader.h"
+#include "productapi.h"
+#include "saleapi.h"
+#include "clientapi.h"
+#include "invoiceapi.h"
+#include <cstring>
+#include <optional>
+
+namespace NetworkApi {
+
+// Describes how one JSON member is stored in a struct. Decoders are tables of
+// these, evaluated at compile time; see jsondecoders.cpp for the entity tables.
+template<typename S>
+struct JsonField {
+    QByteArrayView name;
+    void (*read)(JsonReader &reader, S &target);
+};
+
+namespace JsonFields {
+
+template<auto Member>
+struct MemberTraits;
+
+template<typename S, typename V, V S::*Member>
+struct MemberTraits<Member> {
+    using Struct = S;
+};
+
+template<auto Member>
+using StructOf = typename MemberTraits<Member>::Struct;
+
+// Reads the member with one of the JsonReader value readers
+template<auto Member, auto Read>
+constexpr JsonField<StructOf<Member>> value(QByteArrayView name)
+{
+    return {name, [](JsonReader &reader, StructOf<Member> &target) {
+        target.*Member = (reader.*Read)();
+    }};
+}
+
+template<auto Member>
+constexpr auto integer(QByteArrayView name) { return value<Member, &JsonReader::readInt>(name); }
+template<auto Member>
+constexpr auto number(QByteArrayView name) { return value<Member, &JsonReader::readDouble>(name); }
+template<auto Member>
+constexpr auto numericString(QByteArrayView name) { return value<Member, &JsonReader::readNumericString>(name); }
+template<auto Member>
+constexpr auto string(QByteArrayView name) { return value<Member, &JsonReader::readString>(name); }
+template<auto Member>
+constexpr auto boolean(QByteArrayView name) { return value<Member, &JsonReader::readBool>(name); }
+template<auto Member>
+constexpr auto dateTime(QByteArrayView name) { return value<Member, &JsonReader::readIsoDateTime>(name); }
+template<auto Member>
+constexpr auto variantMap(QByteArrayView name) { return value<Member, &JsonReader::readVariantMap>(name); }
+
+inline bool sameKey(QByteArrayView a, QByteArrayView b)
+{
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), size_t(a.size())) == 0;
+}
+
+} // namespace JsonFields
+
+// Reads one object into target. Members missing from the table are skipped
+// without being materialised; a value that is not an object leaves target
+// untouched, like QJsonValue::toObject() returning an empty object.
+template<typename S, std::size_t N>
+void readObject(JsonReader &reader, S &target, const JsonField<S> (&fields)[N])
+{
+    if (!reader.peekObject()) {
+        reader.skipValue();
+        return;
+    }
+    reader.enterObject();
+
+    // Every row of a page has the same member order, so after the first row
+    // the field following the previous match is almost always the next one.
+    std::size_t next = 0;
+    QByteArrayView key;
+    while (reader.nextKey(key)) {
+        std::size_t index = N;
+        if (next < N && JsonFields::sameKey(fields[next].name, key)) {
+            index = next;
+        } else {
+            for (std::size_t i = 0; i < N; ++i) {
+                if (JsonFields::sameKey(fields[i].name, key)) {
+                    index = i;
+                    break;
+                }
+            }
+        }
+
+        if (index == N) {
+            reader.skipValue();
+            continue;
+        }
+        fields[index].read(reader, target);
+        next = index + 1;
+    }
+}
+
+// Appends every element of an array, constructed in place in the list
+template<typename S, std::size_t N>
+void readList(JsonReader &reader, QList<S> &list, const JsonField<S> (&fields)[N])
+{
+    if (!reader.peekArray()) {
+        reader.skipValue();
+        return;
+    }
+    reader.enterArray();
+    while (reader.nextElement())
+        readObject(reader, list.emplace_back(), fields);
+}
+
+// Page decoders for the list endpoints. They read the response body in one
+// pass and return nullopt for error payloads ("error": true or "errors") and
+// malformed JSON, which the caller then handles as a regular API error.
+std::optional<PaginatedProducts> decodePaginatedProducts(QByteArrayView body);
+std::optional<PaginatedSales> decodePaginatedSales(QByteArrayView body);
+std::optional<PaginatedClients> decodePaginatedClients(QByteArrayView body);
+std::optional<PaginatedInvoices> decodePaginatedInvoices(QByteArrayView body);
+
+// Decoders for {"product": {...}} and the like, as create and update answer.
+// The members the body carries are read over row and the others keep its
+// values, so a partial (PATCH) response merges into the row it updated. A
+// body without the envelope leaves row as it is.
+std::optional<Product> decodeProduct(QByteArrayView body, const Product &row = Product());
+std::optional<Sale> decodeSale(QByteArrayView body, const Sale &row = Sale());
+std::optional<Client> decodeClient(QByteArrayView body, const Client &row = Client());
+
+} // namespace NetworkApi
+
+#endif // JSONDECODERS_H
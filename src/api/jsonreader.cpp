@@ -0,0 +1,457 @@
+// jsonreader.cpp
+#include "jsonreader.h"
+#include <QVariantList>
+#include <cmath>
+#include <limits>
+
+namespace NetworkApi {
+
+JsonReader::JsonReader(QByteArrayView data)
+    : m_pos(data.data())
+    , m_end(data.data() + data.size())
+{
+}
+
+void JsonReader::fail()
+{
+    m_error = true;
+    m_pos = m_end;
+}
+
+void JsonReader::skipWhitespace()
+{
+    while (m_pos < m_end && (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' || *m_pos == '\t'))
+        ++m_pos;
+}
+
+void JsonReader::skipLiteral(QByteArrayView literal)
+{
+    // Truncated ("t") or garbled ("txyz") bodies are errors, not values
+    if (m_end - m_pos < literal.size() || QByteArrayView(m_pos, literal.size()) != literal) {
+        fail();
+        return;
+    }
+    m_pos += literal.size();
+}
+
+bool JsonReader::consume(char c)
+{
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == c) {
+        ++m_pos;
+        return true;
+    }
+    return false;
+}
+
+JsonReader::Kind JsonReader::peek()
+{
+    skipWhitespace();
+    if (m_pos >= m_end)
+        return Kind::Invalid;
+    switch (*m_pos) {
+    case '{': return Kind::Object;
+    case '[': return Kind::Array;
+    case '"': return Kind::String;
+    case 't': return Kind::True;
+    case 'f': return Kind::False;
+    case 'n': return Kind::Null;
+    default:
+        if (*m_pos == '-' || (*m_pos >= '0' && *m_pos <= '9'))
+            return Kind::Number;
+        return Kind::Invalid;
+    }
+}
+
+bool JsonReader::enterObject()
+{
+    if (!consume('{')) {
+        fail();
+        return false;
+    }
+    return true;
+}
+
+bool JsonReader::nextKey(QByteArrayView &key)
+{
+    if (m_error)
+        return false;
+    if (consume('}'))
+        return false;
+    consume(',');
+    skipWhitespace();
+
+    QByteArrayView raw;
+    bool escaped = false;
+    if (!scanString(raw, escaped) || !consume(':')) {
+        fail();
+        return false;
+    }
+    if (escaped) {
+        m_scratch = decodeString(raw, true).toUtf8();
+        key = m_scratch;
+    } else {
+        key = raw;
+    }
+    return true;
+}
+
+bool JsonReader::enterArray()
+{
+    if (!consume('[')) {
+        fail();
+        return false;
+    }
+    return true;
+}
+
+bool JsonReader::nextElement()
+{
+    if (m_error)
+        return false;
+    if (consume(']'))
+        return false;
+    consume(',');
+    if (peek() == Kind::Invalid) {
+        fail();
+        return false;
+    }
+    return true;
+}
+
+bool JsonReader::isNull()
+{
+    if (peek() != Kind::Null)
+        return false;
+    skipValue();
+    return true;
+}
+
+bool JsonReader::peekObject()
+{
+    return peek() == Kind::Object;
+}
+
+bool JsonReader::peekArray()
+{
+    return peek() == Kind::Array;
+}
+
+bool JsonReader::scanString(QByteArrayView &raw, bool &escaped)
+{
+    if (m_pos >= m_end || *m_pos != '"')
+        return false;
+    const char *begin = ++m_pos;
+    escaped = false;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if (c == '"') {
+            raw = QByteArrayView(begin, m_pos - begin);
+            ++m_pos;
+            return true;
+        }
+        if (c == '\\') {
+            // A backslash needs the character it escapes
+            if (m_end - m_pos < 2)
+                break;
+            escaped = true;
+            m_pos += 2;
+            continue;
+        }
+        ++m_pos;
+    }
+    return false;
+}
+
+QByteArrayView JsonReader::scanNumber()
+{
+    const char *begin = m_pos;
+    while (m_pos < m_end) {
+        const char c = *m_pos;
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E')
+            ++m_pos;
+        else
+            break;
+    }
+    return QByteArrayView(begin, m_pos - begin);
+}
+
+static int hexValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// The four hex digits at p as a UTF-16 unit, -1 when there are fewer or one
+// is not a hex digit
+static int hexUnit(const char *p, const char *end)
+{
+    if (end - p < 4)
+        return -1;
+    int unit = 0;
+    for (int i = 0; i < 4; ++i) {
+        const int digit = hexValue(p[i]);
+        if (digit < 0)
+            return -1;
+        unit = (unit << 4) | digit;
+    }
+    return unit;
+}
+
+QString JsonReader::decodeString(QByteArrayView raw, bool escaped)
+{
+    if (!escaped)
+        return QString::fromUtf8(raw);
+
+    QString result;
+    result.reserve(raw.size());
+    const char *p = raw.data();
+    const char *end = p + raw.size();
+    const char *run = p;
+    while (p < end) {
+        if (*p != '\\') {
+            ++p;
+            continue;
+        }
+        result += QString::fromUtf8(run, p - run);
+        if (p + 1 >= end)
+            break;
+        const char e = p[1];
+        p += 2;
+        switch (e) {
+        case 'n': result += QLatin1Char('\n'); break;
+        case 't': result += QLatin1Char('\t'); break;
+        case 'r': result += QLatin1Char('\r'); break;
+        case 'b': result += QLatin1Char('\b'); break;
+        case 'f': result += QLatin1Char('\f'); break;
+        case 'u': {
+            const int unit = hexUnit(p, end);
+            if (unit < 0) {
+                fail();
+                return QString();
+            }
+            p += 4;
+            // A high surrogate and the \u low surrogate after it are one
+            // code point; a surrogate on its own is not a character
+            if (QChar::isHighSurrogate(char32_t(unit)) && end - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                const int low = hexUnit(p + 2, end);
+                if (low >= 0 && QChar::isLowSurrogate(char32_t(low))) {
+                    result += QChar(char16_t(unit));
+                    result += QChar(char16_t(low));
+                    p += 6;
+                    break;
+                }
+            }
+            result += QChar::isSurrogate(char32_t(unit)) ? QChar(QChar::ReplacementCharacter) : QChar(char16_t(unit));
+            break;
+        }
+        case '"':
+        case '\\':
+        case '/':
+            result += QLatin1Char(e);
+            break;
+        default:
+            // Not an escape JSON knows, like QJsonDocument rejects it
+            fail();
+            return QString();
+        }
+        run = p;
+    }
+    result += QString::fromUtf8(run, end - run);
+    return result;
+}
+
+int JsonReader::readInt()
+{
+    const qint64 value = readInt64();
+    if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+        return 0;
+    return int(value);
+}
+
+qint64 JsonReader::readInt64()
+{
+    if (peek() != Kind::Number) {
+        skipValue();
+        return 0;
+    }
+    const QByteArrayView number = scanNumber();
+    bool ok = false;
+    const qint64 value = QByteArray::fromRawData(number.data(), number.size()).toLongLong(&ok);
+    if (ok)
+        return value;
+
+    // 3.0 is an integer for QJsonValue::toInt(), 3.5 is not
+    const double d = QByteArray::fromRawData(number.data(), number.size()).toDouble(&ok);
+    if (ok && std::floor(d) == d && std::abs(d) < 9007199254740992.0)
+        return qint64(d);
+    return 0;
+}
+
+double JsonReader::readDouble()
+{
+    if (peek() != Kind::Number) {
+        skipValue();
+        return 0.0;
+    }
+    const QByteArrayView number = scanNumber();
+    return QByteArray::fromRawData(number.data(), number.size()).toDouble();
+}
+
+double JsonReader::readNumericString()
+{
+    if (peek() != Kind::String) {
+        skipValue();
+        return 0.0;
+    }
+    QByteArrayView raw;
+    bool escaped = false;
+    if (!scanString(raw, escaped)) {
+        fail();
+        return 0.0;
+    }
+    if (escaped)
+        return decodeString(raw, true).toDouble();
+    return QByteArray::fromRawData(raw.data(), raw.size()).trimmed().toDouble();
+}
+
+bool JsonReader::readBool()
+{
+    const Kind kind = peek();
+    skipValue();
+    return kind == Kind::True;
+}
+
+QString JsonReader::readString()
+{
+    if (peek() != Kind::String) {
+        skipValue();
+        return QString();
+    }
+    QByteArrayView raw;
+    bool escaped = false;
+    if (!scanString(raw, escaped)) {
+        fail();
+        return QString();
+    }
+    return decodeString(raw, escaped);
+}
+
+QDateTime JsonReader::readIsoDateTime()
+{
+    return QDateTime::fromString(readString(), Qt::ISODate);
+}
+
+QVariant JsonReader::readVariant()
+{
+    switch (peek()) {
+    case Kind::Object:
+        return readVariantMap();
+    case Kind::Array: {
+        QVariantList list;
+        enterArray();
+        while (nextElement())
+            list.append(readVariant());
+        return list;
+    }
+    case Kind::String:
+        return readString();
+    case Kind::Number: {
+        const QByteArrayView number = scanNumber();
+        const QByteArray bytes = QByteArray::fromRawData(number.data(), number.size());
+        bool ok = false;
+        const qint64 integer = bytes.toLongLong(&ok);
+        if (ok)
+            return integer;
+        return bytes.toDouble();
+    }
+    case Kind::True:
+    case Kind::False:
+        return readBool();
+    case Kind::Null:
+        skipValue();
+        return QVariant::fromValue(nullptr);
+    case Kind::Invalid:
+        fail();
+        break;
+    }
+    return QVariant();
+}
+
+QVariantMap JsonReader::readVariantMap()
+{
+    QVariantMap map;
+    if (peek() != Kind::Object) {
+        skipValue();
+        return map;
+    }
+    enterObject();
+    QByteArrayView key;
+    while (nextKey(key)) {
+        const QString name = QString::fromUtf8(key);
+        map.insert(name, readVariant());
+    }
+    return map;
+}
+
+void JsonReader::skipValue()
+{
+    switch (peek()) {
+    case Kind::Object:
+    case Kind::Array: {
+        // Skip the whole container by bracket depth; strings are scanned so
+        // brackets inside them do not count
+        int depth = 0;
+        while (m_pos < m_end) {
+            const char c = *m_pos;
+            if (c == '"') {
+                QByteArrayView raw;
+                bool escaped = false;
+                if (!scanString(raw, escaped)) {
+                    fail();
+                    return;
+                }
+                continue;
+            }
+            ++m_pos;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0)
+                    return;
+            }
+        }
+        fail();
+        return;
+    }
+    case Kind::String: {
+        QByteArrayView raw;
+        bool escaped = false;
+        if (!scanString(raw, escaped))
+            fail();
+        return;
+    }
+    case Kind::Number:
+        scanNumber();
+        return;
+    case Kind::True:
+        skipLiteral("true");
+        return;
+    case Kind::False:
+        skipLiteral("false");
+        return;
+    case Kind::Null:
+        skipLiteral("null");
+        return;
+    case Kind::Invalid:
+        fail();
+        return;
+    }
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,72 @@
+// jsonreader.h
+#ifndef JSONREADER_H
+#define JSONREADER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDateTime>
+#include <QString>
+#include <QVariant>
+
+namespace NetworkApi {
+
+// Forward-only pull parser over a UTF-8 JSON buffer. Unlike QJsonDocument it
+// does not build a tree: callers walk objects and arrays in document order,
+// read the values they need straight into their structs and skip the rest
+// without allocating. Keys without escapes are returned as views into the
+// source buffer; escaped strings reuse one scratch buffer per reader.
+//
+// The value readers follow QJsonValue conversion rules, so decoders built on
+// top of it behave like the existing json["x"].toInt()/.toString() code.
+class JsonReader
+{
+public:
+    explicit JsonReader(QByteArrayView data);
+
+    bool hasError() const { return m_error; }
+
+    // Objects: enterObject() then loop on nextKey() until it returns false.
+    bool enterObject();
+    bool nextKey(QByteArrayView &key);
+
+    // Arrays: enterArray() then loop on nextElement() until it returns false.
+    bool enterArray();
+    bool nextElement();
+
+    bool isNull();          // consumes the literal when it is null
+    bool peekObject();
+    bool peekArray();
+
+    int readInt();          // QJsonValue::toInt(): integral numbers only
+    qint64 readInt64();
+    double readDouble();    // QJsonValue::toDouble()
+    double readNumericString(); // QJsonValue::toString().toDouble()
+    bool readBool();        // QJsonValue::toBool()
+    QString readString();   // QJsonValue::toString()
+    QDateTime readIsoDateTime();
+    QVariant readVariant(); // QJsonValue::toVariant()
+    QVariantMap readVariantMap();
+
+    void skipValue();
+
+private:
+    enum class Kind { Object, Array, String, Number, True, False, Null, Invalid };
+
+    Kind peek();
+    void skipWhitespace();
+    bool consume(char c);
+    void skipLiteral(QByteArrayView literal);
+    bool scanString(QByteArrayView &raw, bool &escaped);
+    QByteArrayView scanNumber();
+    QString decodeString(QByteArrayView raw, bool escaped);
+    void fail();
+
+    const char *m_pos;
+    const char *m_end;
+    bool m_error = false;
+    QByteArray m_scratch;
+};
+
+} // namespace NetworkApi
+
+#endif // JSONREADER_H
@@ -0,0 +1,82 @@
+// latencytracker.cpp
+#include "latencytracker.h"
+#include <algorithm>
+
+namespace NetworkApi {
+
+namespace {
+constexpr qsizetype MaximumSamples = 64;
+constexpr int MinimumTimeout = 5 * 1000;
+constexpr int MaximumTimeout = 60 * 1000;
+constexpr int MinimumHedgeDelay = 100;
+}
+
+LatencyTracker *LatencyTracker::instance()
+{
+    static LatencyTracker tracker;
+    return &tracker;
+}
+
+QString LatencyTracker::endpointKey(QNetworkAccessManager::Operation operation, const QUrl &url)
+{
+    QString method;
+    switch (operation) {
+    case QNetworkAccessManager::HeadOperation: method = QStringLiteral("HEAD"); break;
+    case QNetworkAccessManager::GetOperation: method = QStringLiteral("GET"); break;
+    case QNetworkAccessManager::PutOperation: method = QStringLiteral("PUT"); break;
+    case QNetworkAccessManager::PostOperation: method = QStringLiteral("POST"); break;
+    case QNetworkAccessManager::DeleteOperation: method = QStringLiteral("DELETE"); break;
+    default: method = QStringLiteral("CUSTOM"); break;
+    }
+
+    // Ids in the path would give every record its own endpoint
+    QStringList segments = url.path().split(QLatin1Char('/'));
+    for (QString &segment : segments) {
+        bool isNumber = false;
+        segment.toLongLong(&isNumber);
+        if (isNumber)
+            segment = QStringLiteral("{id}");
+    }
+    return method + QLatin1Char(' ') + segments.join(QLatin1Char('/'));
+}
+
+void LatencyTracker::record(const QString &endpoint, qint64 milliseconds)
+{
+    Samples &samples = m_samples[endpoint];
+    if (samples.values.size() < MaximumSamples) {
+        samples.values.append(milliseconds);
+    } else {
+        samples.values[samples.next] = milliseconds;
+        samples.next = (samples.next + 1) % MaximumSamples;
+    }
+}
+
+std::optional<qint64> LatencyTracker::percentile(const QString &endpoint, double fraction) const
+{
+    const auto it = m_samples.constFind(endpoint);
+    if (it == m_samples.constEnd() || it->values.size() < MinimumSamples)
+        return std::nullopt;
+
+    QList<qint64> sorted = it->values;
+    const qsizetype index = qMin(sorted.size() - 1, qsizetype(fraction * sorted.size()));
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted.at(index);
+}
+
+int LatencyTracker::timeoutFor(const QString &endpoint) const
+{
+    const std::optional<qint64> p99 = percentile(endpoint, 0.99);
+    if (!p99)
+        return DefaultTimeout;
+    return int(qBound<qint64>(MinimumTimeout, *p99 * 4, MaximumTimeout));
+}
+
+std::optional<int> LatencyTracker::hedgeDelayFor(const QString &endpoint) const
+{
+    const std::optional<qint64> p95 = percentile(endpoint, 0.95);
+    if (!p95)
+        return std::nullopt;
+    return int(qMax<qint64>(MinimumHedgeDelay, *p95));
+}
+
+} // namespace NetworkApi
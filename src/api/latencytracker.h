@@ -0,0 +1,49 @@
+// latencytracker.h
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <QHash>
+#include <QList>
+#include <QNetworkAccessManager>
+#include <QString>
+#include <QUrl>
+#include <optional>
+
+namespace NetworkApi {
+
+// Rolling round-trip samples per endpoint ("GET /api/v1/products/{id}"),
+// used to derive request timeouts and hedging delays from what the network
+// has actually been doing instead of fixed constants.
+class LatencyTracker
+{
+public:
+    static LatencyTracker *instance();
+
+    static QString endpointKey(QNetworkAccessManager::Operation operation, const QUrl &url);
+
+    void record(const QString &endpoint, qint64 milliseconds);
+    // Nothing is derived from fewer than MinimumSamples samples
+    std::optional<qint64> percentile(const QString &endpoint, double fraction) const;
+
+    // A few times the p99, bounded; DefaultTimeout until enough samples exist
+    int timeoutFor(const QString &endpoint) const;
+    // When a hedged read sends its second request: the p95
+    std::optional<int> hedgeDelayFor(const QString &endpoint) const;
+
+    static constexpr int MinimumSamples = 10;
+    static constexpr int DefaultTimeout = 30 * 1000;
+
+private:
+    LatencyTracker() = default;
+
+    struct Samples {
+        QList<qint64> values; // ring buffer
+        qsizetype next = 0;
+    };
+
+    QHash<QString, Samples> m_samples;
+};
+
+} // namespace NetworkApi
+
+#endif // LATENCYTRACKER_H
@@ -0,0 +1,169 @@
+// listquery.cpp
+#include "listquery.h"
+#include <QLocale>
+#include <QUrlQuery>
+#include <algorithm>
+
+namespace NetworkApi {
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+using Item = std::pair<QString, QString>;
+
+QString encode(const QString &text)
+{
+    // Everything but the RFC 3986 unreserved characters, '+' and '/' included
+    return QString::fromLatin1(QUrl::toPercentEncoding(text));
+}
+
+QString join(const QList<Item> &items)
+{
+    QString query;
+    for (const Item &item : items) {
+        if (!query.isEmpty())
+            query += QLatin1Char('&');
+        query += encode(item.first) + QLatin1Char('=') + encode(item.second);
+    }
+    return query;
+}
+
+bool byName(const Item &a, const Item &b)
+{
+    return a.first < b.first;
+}
+
+QString sortedList(QStringList values)
+{
+    values.sort();
+    values.removeDuplicates();
+    return values.join(QLatin1Char(','));
+}
+
+} // namespace
+
+Fieldset fieldsetForRoles(const QStringList &roles, std::initializer_list<RoleFields> table)
+{
+    Fieldset fieldset;
+    if (roles.isEmpty())
+        return fieldset;
+
+    fieldset.fields.append(QStringLiteral("id"));
+    for (const RoleFields &entry : table) {
+        if (!roles.contains(entry.role))
+            continue;
+        if (!entry.fields.isEmpty())
+            fieldset.fields.append(QString(entry.fields).split(QLatin1Char(',')));
+        if (!entry.include.isEmpty())
+            fieldset.include.append(entry.include);
+    }
+    return fieldset;
+}
+
+ListQuery &ListQuery::search(const QString &text)
+{
+    return add("search"_L1, text);
+}
+
+ListQuery &ListQuery::sort(const QString &field, const QString &direction)
+{
+    add("sort_by"_L1, field);
+    return add("sort_direction"_L1, direction.toLower());
+}
+
+ListQuery &ListQuery::page(int page)
+{
+    if (page > 0)
+        insert(QStringLiteral("page"), QString::number(page));
+    return *this;
+}
+
+ListQuery &ListQuery::pagination(int page, const std::optional<QString> &cursor)
+{
+    if (!cursor)
+        return this->page(page);
+    insert(QStringLiteral("pagination"), QStringLiteral("cursor"));
+    return add("cursor"_L1, *cursor);
+}
+
+ListQuery &ListQuery::add(QLatin1String name, const QString &value)
+{
+    if (!value.isEmpty())
+        insert(name, value);
+    return *this;
+}
+
+ListQuery &ListQuery::add(QLatin1String name, int value)
+{
+    insert(name, QString::number(value));
+    return *this;
+}
+
+ListQuery &ListQuery::add(QLatin1String name, double value)
+{
+    insert(name, QString::number(value, 'g', QLocale::FloatingPointShortest));
+    return *this;
+}
+
+ListQuery &ListQuery::add(QLatin1String name, const QDateTime &value)
+{
+    if (value.isValid())
+        insert(name, value.toString(Qt::ISODate));
+    return *this;
+}
+
+ListQuery &ListQuery::add(QLatin1String name, QDate value)
+{
+    if (value.isValid())
+        insert(name, value.toString(Qt::ISODate));
+    return *this;
+}
+
+ListQuery &ListQuery::flag(QLatin1String name, bool set)
+{
+    if (set)
+        insert(name, QStringLiteral("1"));
+    return *this;
+}
+
+ListQuery &ListQuery::fieldset(const Fieldset &fieldset)
+{
+    if (!fieldset.fields.isEmpty())
+        insert(QStringLiteral("fields"), sortedList(fieldset.fields));
+    if (!fieldset.include.isEmpty())
+        insert(QStringLiteral("include"), sortedList(fieldset.include));
+    return *this;
+}
+
+QString ListQuery::toString() const
+{
+    return join(m_items);
+}
+
+QString ListQuery::path(const QString &path) const
+{
+    if (m_items.isEmpty())
+        return path;
+    return path + QLatin1Char('?') + join(m_items);
+}
+
+QUrl ListQuery::canonical(const QUrl &url)
+{
+    QUrl result = url.adjusted(QUrl::NormalizePathSegments);
+    if (!url.hasQuery())
+        return result;
+    QList<Item> items = QUrlQuery(url).queryItems(QUrl::FullyDecoded);
+    std::stable_sort(items.begin(), items.end(), byName);
+    result.setQuery(join(items), QUrl::StrictMode);
+    return result;
+}
+
+void ListQuery::insert(const QString &name, const QString &value)
+{
+    // Repeated names (ids[]=1&ids[]=2) keep the order they were added in
+    const Item item{name, value};
+    m_items.insert(std::upper_bound(m_items.begin(), m_items.end(), item, byName), item);
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,87 @@
+// listquery.h
+#ifndef LISTQUERY_H
+#define LISTQUERY_H
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUrl>
+#include <initializer_list>
+#include <optional>
+#include <utility>
+
+namespace NetworkApi {
+
+// Sparse list responses: the members each row carries (?fields=) and the
+// relations embedded in it (?include=). Empty asks for the full rows.
+struct Fieldset {
+    QStringList fields;
+    QStringList include;
+
+    bool isEmpty() const { return fields.isEmpty() && include.isEmpty(); }
+};
+
+// What the API has to send for one model role; either may be empty, and
+// fields may list several members ("total_amount,paid_amount")
+struct RoleFields {
+    QLatin1String role;
+    QLatin1String fields;
+    QLatin1String include;
+};
+
+// The fieldset for the roles a view shows, "id" always included. No roles
+// means the full rows.
+Fieldset fieldsetForRoles(const QStringList &roles, std::initializer_list<RoleFields> table);
+
+// Query string of a list endpoint. Parameters are kept sorted by name and
+// percent-encoded (RFC 3986), and empty values are left out, so the same
+// filters always produce the same URL whatever order they were added in.
+// The response cache and GET coalescing key on that URL.
+//
+//   createRequest(ListQuery().search(search).sort(sortBy, sortDirection).page(page)
+//                     .add("status"_L1, status).fieldset(fieldset)
+//                     .path(QStringLiteral("/api/v1/sales")));
+class ListQuery
+{
+public:
+    ListQuery &search(const QString &text);
+    ListQuery &sort(const QString &field, const QString &direction);
+    // Pages start at 1; anything lower is left to the server's default
+    ListQuery &page(int page);
+    // Keyset pagination when a cursor is given: an empty one asks for the
+    // first page, then each page is asked for with the next_cursor of the
+    // one before. Without a cursor, page numbers as above.
+    ListQuery &pagination(int page, const std::optional<QString> &cursor);
+
+    // Skipped when empty
+    ListQuery &add(QLatin1String name, const QString &value);
+    ListQuery &add(QLatin1String name, int value);
+    ListQuery &add(QLatin1String name, double value);
+    // ISO 8601, skipped when invalid
+    ListQuery &add(QLatin1String name, const QDateTime &value);
+    ListQuery &add(QLatin1String name, QDate value);
+    // "1" when set, skipped otherwise
+    ListQuery &flag(QLatin1String name, bool set);
+    // fields and include, each sorted and without duplicates
+    ListQuery &fieldset(const Fieldset &fieldset);
+
+    bool isEmpty() const { return m_items.isEmpty(); }
+    // Encoded, e.g. "page=2&search=fish%20%26%20chips"
+    QString toString() const;
+    // path followed by "?query" when there is one
+    QString path(const QString &path) const;
+
+    // url with its query sorted and encoded the way a ListQuery writes it;
+    // used for the keys of URLs that were built some other way
+    static QUrl canonical(const QUrl &url);
+
+private:
+    void insert(const QString &name, const QString &value);
+
+    QList<std::pair<QString, QString>> m_items; // decoded, sorted by name
+};
+
+} // namespace NetworkApi
+
+#endif // LISTQUERY_H
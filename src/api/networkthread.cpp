@@ -0,0 +1,64 @@
+// networkthread.cpp
+#include "networkthread.h"
+#include <QCoreApplication>
+#include <QNetworkAccessManager>
+
+namespace NetworkApi {
+
+NetworkThread *NetworkThread::instance()
+{
+    static NetworkThread *thread = [] {
+        auto *t = new NetworkThread();
+        t->start();
+        return t;
+    }();
+    return thread;
+}
+
+NetworkThread::NetworkThread()
+    : m_context(new QObject())
+{
+    setObjectName(QStringLiteral("NetworkThread"));
+    m_context->moveToThread(this);
+    // Replies still in flight are abandoned on exit, like on the GUI thread
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &NetworkThread::stop,
+                Qt::DirectConnection);
+    }
+}
+
+void NetworkThread::adopt(QNetworkAccessManager *manager)
+{
+    if (!manager || manager->thread() == instance())
+        return;
+    Q_ASSERT(!manager->parent());
+    manager->moveToThread(instance());
+}
+
+void NetworkThread::post(const std::function<void()> &work)
+{
+    NetworkThread *thread = instance();
+    if (!thread->isRunning()) {
+        // Shutting down: nothing is sent any more
+        return;
+    }
+    QMetaObject::invokeMethod(thread->m_context, work, Qt::QueuedConnection);
+}
+
+QObject *NetworkThread::context()
+{
+    return instance()->m_context;
+}
+
+bool NetworkThread::isCurrent()
+{
+    return QThread::currentThread() == instance();
+}
+
+void NetworkThread::stop()
+{
+    quit();
+    wait();
+}
+
+} // namespace NetworkApi
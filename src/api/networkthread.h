@@ -0,0 +1,43 @@
+// networkthread.h
+#ifndef NETWORKTHREAD_H
+#define NETWORKTHREAD_H
+
+#include <QThread>
+#include <functional>
+
+class QNetworkAccessManager;
+
+namespace NetworkApi {
+
+// The thread the transport runs on. The shared QNetworkAccessManager lives
+// here, and with it every reply, timer and piece of request bookkeeping of
+// AbstractApi (scheduler, circuit breaker, latency tracking, response
+// cache). API objects stay on the GUI thread as a facade: their calls hand
+// the request over and their futures resolve with finished results, so
+// QML keeps rendering while pages download and TLS connections are set up.
+class NetworkThread : public QThread
+{
+    Q_OBJECT
+public:
+    static NetworkThread *instance();
+
+    // Moves a manager created on the GUI thread over to the network thread
+    static void adopt(QNetworkAccessManager *manager);
+    // Runs work on the network thread, after everything posted before it
+    static void post(const std::function<void()> &work);
+    static bool isCurrent();
+    // An object living on the network thread, to use as connection context
+    static QObject *context();
+
+    // Stops the event loop; called when the application quits
+    void stop();
+
+private:
+    NetworkThread();
+
+    QObject *m_context;
+};
+
+} // namespace NetworkApi
+
+#endif // NETWORKTHREAD_H
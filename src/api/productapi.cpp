@@ -1,8 +1,11 @@
 #include "productapi.h"
+#include "listquery.h"
+#include "jsondecoders.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QUrlQuery>
+#include <algorithm>
 #include <qstandardpaths.h>
 
 namespace NetworkApi {
@@ -12,7 +15,7 @@ QNetworkAccessManager* ProductApi::netManager = nullptr;
 void ProductApi::setSharedNetworkManager(QNetworkAccessManager* manager)
 {
     if (netManager && netManager->parent() == nullptr) {
-        delete netManager;
+        netManager->deleteLater();
     }
     netManager = manager;
 }
@@ -33,6 +36,8 @@ ProductApi::ProductApi(QObject *parent)
     ensureSharedNetworkManager();
     setNetworkManager(netManager);
     m_favoriteManager = new FavoriteManager(this);
+    // Product lookups sit on the checkout path
+    setHedgedReads(true);
 }
 
 ProductApi::ProductApi(QNetworkAccessManager *netManager, QObject *parent)
@@ -40,45 +45,37 @@ ProductApi::ProductApi(QNetworkAccessManager *netManager, QObject *parent)
     ,  m_settings(QStringLiteral("Dervox"), QStringLiteral("DGest"))
 {
     m_favoriteManager = new FavoriteManager(this);
+    // Product lookups sit on the checkout path
+    setHedgedReads(true);
 }
 
 QFuture<void> ProductApi::getProducts(const QString &search, const QString &sortBy,
                                       const QString &sortDirection,int page, bool lowStock,
-                                      bool expiringSoon, const QString &status)
+                                      bool expiringSoon, const QString &status,
+                                      const Fieldset &fieldset,
+                                      const std::optional<QString> &cursor)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/products");
 
-    // Build query string manually
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (lowStock)
-        queryParts <<QStringLiteral( "low_stock=1");
-    if (expiringSoon)
-        queryParts <<QStringLiteral( "expiring_soon=1");
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-    if (!status.isEmpty())
-        queryParts << QStringLiteral("status=%1").arg(status);
-
-    // Add query parameters to path if there are any
-    if (!queryParts.isEmpty()) {
-      path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .flag("low_stock"_L1, lowStock)
+               .flag("expiring_soon"_L1, expiringSoon)
+               .pagination(page, cursor)
+               .add("status"_L1, status)
+               .fieldset(fieldset)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeStreamDecodedRequest<PaginatedProducts>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &decodePaginatedProducts, QStringLiteral("products")).then([=](ApiResponse<PaginatedProducts> response) {
         if (response.success) {
-            PaginatedProducts paginatedProducts = paginatedProductsFromJson(*response.data);
+            const PaginatedProducts &paginatedProducts = *response.data;
             Q_EMIT productsReceived(paginatedProducts);
         } else {
             Q_EMIT errorProductsReceived(response.error->message, response.error->status,
@@ -97,14 +94,15 @@ QFuture<void> ProductApi::getProduct(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/products/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &productData = response.data->value("product"_L1).toObject();
             Product product = productFromJson(productData);
             QVariantMap productMap= productToVariantMap(product);
             Q_EMIT productReceived(productMap);
+            Q_EMIT productDetailsReceived(product);
         } else {
             Q_EMIT errorProductReceived(response.error->message, response.error->status,
                                       QJsonDocument(response.error->details).toJson());
@@ -125,8 +123,8 @@ QFuture<void> ProductApi::createProduct(const Product &product)
 
     QJsonObject jsonData = productToJson(product);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &productData = response.data->value("product"_L1).toObject();
@@ -154,8 +152,8 @@ QFuture<void> ProductApi::updateProduct(int id, const Product &product)
 
     QJsonObject jsonData = productToJson(product);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &productData = response.data->value("product"_L1).toObject();
@@ -171,6 +169,84 @@ QFuture<void> ProductApi::updateProduct(int id, const Product &product)
     return future.then([=]() {});
 }
 
+// base with the members productToJson() sends taken from edit: the product
+// the server holds once a patch applies. Edited packages keep the id of the
+// base package with the same barcode, or the same name when they have none.
+static Product applyProductEdit(const Product &base, const Product &edit)
+{
+    Product product = base;
+    product.reference = edit.reference;
+    product.name = edit.name;
+    product.description = edit.description;
+    product.price = edit.price;
+    product.purchase_price = edit.purchase_price;
+    product.expiredDate = edit.expiredDate;
+    product.quantity = edit.quantity;
+    product.sku = edit.sku;
+    product.minStockLevel = edit.minStockLevel;
+    product.maxStockLevel = edit.maxStockLevel;
+    product.reorderPoint = edit.reorderPoint;
+    product.location = edit.location;
+    if (edit.productUnitId != base.productUnitId) {
+        product.productUnitId = edit.productUnitId;
+        product.unit = edit.unit.id == edit.productUnitId ? edit.unit : ProductUnit{edit.productUnitId, QString()};
+    }
+
+    QList<ProductPackageProduct> known = base.packages;
+    product.packages.clear();
+    product.packages.reserve(edit.packages.size());
+    for (ProductPackageProduct package : edit.packages) {
+        const auto match = std::find_if(known.begin(), known.end(), [&package](const ProductPackageProduct &other) {
+            return package.barcode.isEmpty() ? other.name == package.name : other.barcode == package.barcode;
+        });
+        package.id = match != known.end() ? match->id : 0;
+        if (match != known.end())
+            known.erase(match);
+        product.packages.append(package);
+    }
+    product.packagesValue = QVariant();
+    return product;
+}
+
+QFuture<void> ProductApi::patchProduct(const Product &base, const Product &product)
+{
+    QJsonObject changes = changedMembers(productToJson(base), productToJson(product));
+    // productToJson() leaves an empty package list out, which would keep them
+    if (product.packages.isEmpty() && !base.packages.isEmpty())
+        changes["packages"_L1] = QJsonArray();
+    if (changes.isEmpty()) {
+        Q_EMIT productUpdated(base);
+        return QtFuture::makeReadyVoidFuture();
+    }
+
+    setLoading(true);
+
+    QNetworkRequest request = createRequest(QStringLiteral("/api/v1/products/%1").arg(base.id));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+    request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+
+    // What the server holds once the patch applies, should its reply leave
+    // some of the changed members out
+    const Product patched = applyProductEdit(base, product);
+
+    auto future = makeStreamDecodedRequest<Product>([=](QNetworkAccessManager *network) {
+        return sendPatch(network, request, changes);
+    }, [patched](QByteArrayView body) {
+        // 204 No Content: the patch applied as sent
+        return body.isEmpty() ? std::optional<Product>(patched) : decodeProduct(body, patched);
+    }).then([=](ApiResponse<Product> response) {
+        if (response.success) {
+            Q_EMIT productUpdated(*response.data);
+        } else {
+            Q_EMIT errorProductUpdated(response.error->message, response.error->status,
+                                     QJsonDocument(response.error->details).toJson());
+        }
+        setLoading(false);
+    });
+
+    return future.then([=]() {});
+}
+
 QFuture<void> ProductApi::deleteProduct(int id)
 {
     setLoading(true);
@@ -179,8 +255,8 @@ QFuture<void> ProductApi::deleteProduct(int id)
     request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT productDeleted(id);
@@ -206,8 +282,8 @@ QFuture<void> ProductApi::updateStock(int id, int quantity, const QString &opera
     jsonData["quantity"_L1] = quantity;
     jsonData["operation"_L1] = operation;
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &productData = response.data->value("product"_L1).toObject();
@@ -227,8 +303,8 @@ QFuture<void> ProductApi::getLowStockProducts()
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/products/low-stock"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QList<Product> products;
@@ -251,8 +327,8 @@ QFuture<void> ProductApi::getProductUnits()
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/product-units"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QList<ProductUnit> units;
@@ -281,8 +357,8 @@ QFuture<void> ProductApi::addProductBarcode(int productId, const QString &barcod
     QJsonObject jsonData;
     jsonData["barcode"_L1] = barcode;
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &barcodeData = response.data->value("barcode"_L1).toObject();
@@ -311,8 +387,8 @@ QFuture<void> ProductApi::updateProductBarcode(int productId, int barcodeId, con
     QJsonObject jsonData;
     jsonData["barcode"_L1] = newBarcode;
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &barcodeData = response.data->value("barcode"_L1).toObject();
@@ -336,8 +412,8 @@ QFuture<void> ProductApi::removeProductBarcode(int productId, int barcodeId)
                 );
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT barcodeRemoved(productId, barcodeId);
@@ -360,8 +436,8 @@ QFuture<void> ProductApi::getProductBarcodes(int productId)
                 );
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QList<QJsonObject> barcodes;
@@ -382,7 +458,7 @@ QFuture<void> ProductApi::getProductBarcodes(int productId)
 
 
 
-Product ProductApi::productFromJson(const QJsonObject &json) const
+Product ProductApi::productFromJson(const QJsonObject &json)
 {
     Product product;
     product.id = json["id"_L1].toInt();
@@ -421,7 +497,7 @@ Product ProductApi::productFromJson(const QJsonObject &json) const
     return product;
 }
 
-ProductUnit ProductApi::productUnitFromJson(const QJsonObject &json) const
+ProductUnit ProductApi::productUnitFromJson(const QJsonObject &json)
 {
     ProductUnit unit;
     unit.id = json["id"_L1].toInt();
@@ -475,22 +551,6 @@ QJsonObject ProductApi::productToJson(const Product &product) const
     return json;
 }
 
-PaginatedProducts ProductApi::paginatedProductsFromJson(const QJsonObject &json) const
-{
-    PaginatedProducts result;
-    const QJsonObject &meta = json["products"_L1].toObject();
-    result.currentPage = meta["current_page"_L1].toInt();
-    result.lastPage = meta["last_page"_L1].toInt();
-    result.perPage = meta["per_page"_L1].toInt();
-    result.total = meta["total"_L1].toInt();
-
-    const QJsonArray &dataArray = meta["data"_L1].toArray();
-    for (const QJsonValue &value : dataArray) {
-        result.data.append(productFromJson(value.toObject()));
-    }
-
-    return result;
-}
 QVariantMap ProductApi::productToVariantMap(const Product &product) const
 {
     QVariantMap map;
@@ -580,8 +640,8 @@ QVariantMap ProductApi::productToVariantMap(const Product &product) const
 //     file->setParent(multiPart); // File will be deleted with multiPart
 //     multiPart->append(imagePart);
 
-//     auto future = makeRequest<QJsonObject>([=]() {
-//         QNetworkReply* reply = m_netManager->post(request, multiPart);
+//     auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+//         QNetworkReply* reply = network->post(request, multiPart);
 //         multiPart->setParent(reply); // Delete multiPart with reply
 //         return reply;
 //     }).then([=](JsonResponse response) {
@@ -619,16 +679,13 @@ QFuture<void> ProductApi::uploadProductImage(int productId, const QString &image
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    // Create multipart with explicit boundary
-    QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+    // Explicit boundary, also sent in the Content-Type
     QString boundary = QStringLiteral("boundary%1").arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    multiPart->setBoundary(boundary.toLatin1());
 
     // Add image file
     QFile *file = new QFile(localPath);
     if (!file->open(QIODevice::ReadOnly)) {
         delete file;
-        delete multiPart;
         Q_EMIT uploadImageError(QStringLiteral("Failed to open image file"));
         setLoading(false);
         return QtFuture::makeReadyVoidFuture();
@@ -651,19 +708,26 @@ QFuture<void> ProductApi::uploadProductImage(int productId, const QString &image
 
     // Set the body
     imagePart.setBody(fileData);
-    multiPart->append(imagePart);
 
     // Set the content type for the request
     request.setHeader(QNetworkRequest::ContentTypeHeader,
                       QStringLiteral("multipart/form-data; boundary=%1").arg(boundary));
+    // The multipart body is owned by the first reply
+    request.setAttribute(NoRetryAttribute, true);
 
     qDebug() << "Sending request:";
     qDebug() << "Boundary:" << boundary;
     qDebug() << "Content-Type:" << request.header(QNetworkRequest::ContentTypeHeader);
     qDebug() << "File size:" << fileData.size();
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        QNetworkReply* reply = m_netManager->post(request, multiPart);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        // Built when the request is sent, on the network thread: a request
+        // that never is (open circuit, superseded while queued) leaves
+        // nothing behind
+        auto *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+        multiPart->setBoundary(boundary.toLatin1());
+        multiPart->append(imagePart);
+        QNetworkReply* reply = network->post(request, multiPart);
         multiPart->setParent(reply);
 
         connect(reply, &QNetworkReply::uploadProgress,
@@ -700,8 +764,8 @@ QFuture<void> ProductApi::removeProductImage(int productId)
     request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT imageRemoved(productId);
@@ -739,20 +803,21 @@ QFuture<QByteArray> ProductApi::generateProductBarcode(int productId, const QStr
     auto promise = std::make_shared<QPromise<QByteArray>>();
 
     // Make the POST request
-    m_currentReply = m_netManager->post(request, QJsonDocument(jsonData).toJson());
-
-    connect(m_currentReply, &QNetworkReply::finished, this, [this, promise]() {
+    const QByteArray body = QJsonDocument(jsonData).toJson();
+    makeRawRequest([=](QNetworkAccessManager *network) {
+        return network->post(request, body);
+    }).then(this, [this, promise](const RawResponse &reply) {
         setLoading(false);
 
-        if (m_currentReply->error() == QNetworkReply::NoError) {
-            QString contentType = m_currentReply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (reply.networkError == QNetworkReply::NoError) {
+            QString contentType = QString::fromLatin1(reply.header("Content-Type"));
 
             if (contentType.contains("application/pdf"_L1)) {
-                QByteArray pdfData = m_currentReply->readAll();
+                QByteArray pdfData = reply.body;
 
                 // Extract dimension metadata from response headers
-                int paperWidthMM = m_currentReply->rawHeader(QStringLiteral("X-Paper-Width")).toInt();
-                int paperHeightMM = m_currentReply->rawHeader(QStringLiteral("X-Paper-Height")).toInt();
+                int paperWidthMM = reply.header("X-Paper-Width").toInt();
+                int paperHeightMM = reply.header("X-Paper-Height").toInt();
 
                 // Save to app's data location
                 QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -790,20 +855,18 @@ QFuture<QByteArray> ProductApi::generateProductBarcode(int productId, const QStr
                 }
             } else if (contentType.contains("application/json"_L1)) {
                 // Handle error response
-                QJsonDocument jsonResponse = QJsonDocument::fromJson(m_currentReply->readAll());
+                QJsonDocument jsonResponse = QJsonDocument::fromJson(reply.body);
                 QJsonObject jsonObject = jsonResponse.object();
                 QString errorMessage = jsonObject["message"_L1].toString();
                 Q_EMIT errorBarcodeGenerated(QStringLiteral("Error"), errorMessage);
                 promise->addResult(QByteArray());
             }
         } else {
-            Q_EMIT errorBarcodeGenerated(QStringLiteral("Network Error"), m_currentReply->errorString());
+            Q_EMIT errorBarcodeGenerated(QStringLiteral("Network Error"), reply.errorString);
             promise->addResult(QByteArray());
         }
 
         promise->finish();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
     });
 
     return promise->future();
@@ -836,20 +899,21 @@ QFuture<QByteArray> ProductApi::generateCustomBarcode(const QString &content, co
     auto promise = std::make_shared<QPromise<QByteArray>>();
 
     // Make the POST request
-    m_currentReply = m_netManager->post(request, QJsonDocument(jsonData).toJson());
-
-    connect(m_currentReply, &QNetworkReply::finished, this, [this, promise]() {
+    const QByteArray body = QJsonDocument(jsonData).toJson();
+    makeRawRequest([=](QNetworkAccessManager *network) {
+        return network->post(request, body);
+    }).then(this, [this, promise](const RawResponse &reply) {
         setLoading(false);
 
-        if (m_currentReply->error() == QNetworkReply::NoError) {
-            QString contentType = m_currentReply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (reply.networkError == QNetworkReply::NoError) {
+            QString contentType = QString::fromLatin1(reply.header("Content-Type"));
 
             if (contentType.contains("application/pdf"_L1)) {
-                QByteArray pdfData = m_currentReply->readAll();
+                QByteArray pdfData = reply.body;
 
                 // Extract dimension metadata from response headers
-                int paperWidthMM = m_currentReply->rawHeader(QStringLiteral("X-Paper-Width")).toInt();
-                int paperHeightMM = m_currentReply->rawHeader(QStringLiteral("X-Paper-Height")).toInt();
+                int paperWidthMM = reply.header("X-Paper-Width").toInt();
+                int paperHeightMM = reply.header("X-Paper-Height").toInt();
 
                 // Save to app's data location
                 QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -887,20 +951,18 @@ QFuture<QByteArray> ProductApi::generateCustomBarcode(const QString &content, co
                 }
             } else if (contentType.contains("application/json"_L1)) {
                 // Handle error response
-                QJsonDocument jsonResponse = QJsonDocument::fromJson(m_currentReply->readAll());
+                QJsonDocument jsonResponse = QJsonDocument::fromJson(reply.body);
                 QJsonObject jsonObject = jsonResponse.object();
                 QString errorMessage = jsonObject["message"_L1].toString();
                 Q_EMIT errorBarcodeGenerated(QStringLiteral("Error"), errorMessage);
                 promise->addResult(QByteArray());
             }
         } else {
-            Q_EMIT errorBarcodeGenerated(QStringLiteral("Network Error"), m_currentReply->errorString());
+            Q_EMIT errorBarcodeGenerated(QStringLiteral("Network Error"), reply.errorString);
             promise->addResult(QByteArray());
         }
 
         promise->finish();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
     });
 
     return promise->future();
@@ -3,6 +3,7 @@
 #define PRODUCTAPI_H
 
 #include "abstractapi.h"
+#include "listquery.h"
 #include <QSettings>
 #include <QJsonArray>
 #include <QHttpMultiPart>
@@ -43,8 +44,10 @@ struct Product {
     QString location;
     ProductUnit unit;
     QList<ProductPackageProduct> packages;
-    bool checked = false;
     QString image_path;
+    // packages as ProductModel's PackagesRole, built the first time a view
+    // asks; a row that is replaced comes with none
+    mutable QVariant packagesValue;
 };
 
 struct PaginatedProducts {
@@ -53,6 +56,7 @@ struct PaginatedProducts {
     int lastPage;
     int perPage;
     int total;
+    QString nextCursor; // keyset pagination; empty after the last page
 };
 class ProductApi : public AbstractApi {
     Q_OBJECT
@@ -68,11 +72,17 @@ public:
                                           int page = 1,
                                           bool lowStock = false,
                                           bool expiringSoon = false,
-                                          const QString &status = QString());
+                                          const QString &status = QString(),
+                                          const Fieldset &fieldset = Fieldset(),
+                                          const std::optional<QString> &cursor = std::nullopt);
 
     Q_INVOKABLE QFuture<void> getProduct(int id);
     Q_INVOKABLE QFuture<void> createProduct(const Product &product);
     Q_INVOKABLE QFuture<void> updateProduct(int id, const Product &product);
+    // PATCH with only the members product changes from base, the product as
+    // the server last sent it. productUpdated carries base with the changes
+    // and the reply merged in; nothing is sent when nothing changed.
+    QFuture<void> patchProduct(const Product &base, const Product &product);
     Q_INVOKABLE QFuture<void> deleteProduct(int id);
 
     // Additional operations
@@ -109,6 +119,8 @@ Q_SIGNALS:
     // Success signals
     void productsReceived(const PaginatedProducts &products);
     void productReceived(const QVariantMap &product);
+    // The same full record, for models holding a sparse copy of it
+    void productDetailsReceived(const Product &product);
     void productReceivedForBarcode(const QVariantMap &product); // to get id from  variantmap
 
     void productCreated(const Product &product);
@@ -147,11 +159,9 @@ Q_SIGNALS:
     void isLoadingChanged();
     void imageUploaded(const QString &imageUrl);
 private:
-    QNetworkReply* m_currentReply = nullptr;
-    Product productFromJson(const QJsonObject &json) const;
-    ProductUnit productUnitFromJson(const QJsonObject &json) const;
+    static Product productFromJson(const QJsonObject &json);
+    static ProductUnit productUnitFromJson(const QJsonObject &json);
     QJsonObject productToJson(const Product &product) const;
-    PaginatedProducts paginatedProductsFromJson(const QJsonObject &json) const;
     QVariantMap productToVariantMap(const Product &product) const;
     Product productFromVariant(const QVariantMap &data) const;
     QSettings m_settings;
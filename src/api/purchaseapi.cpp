@@ -1,5 +1,6 @@
 // purchaseapi.cpp
 #include "purchaseapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
@@ -13,7 +14,7 @@ PurchaseApi::PurchaseApi(QNetworkAccessManager *netManager, QObject *parent)
 }
 
 // Helper Methods
-Purchase PurchaseApi::purchaseFromJson(const QJsonObject &json) const
+Purchase PurchaseApi::purchaseFromJson(const QJsonObject &json)
 {
     Purchase purchase;
     purchase.id = json["id"_L1].toInt();
@@ -41,7 +42,7 @@ Purchase PurchaseApi::purchaseFromJson(const QJsonObject &json) const
     return purchase;
 }
 
-PurchaseItem PurchaseApi::purchaseItemFromJson(const QJsonObject &json) const
+PurchaseItem PurchaseApi::purchaseItemFromJson(const QJsonObject &json)
 {
     PurchaseItem item;
     item.id = json["id"_L1].toInt();
@@ -161,7 +162,7 @@ QJsonObject PurchaseApi::paymentToJson(const PurchasePayment &payment) const
     return json;
 }
 
-PaginatedPurchases PurchaseApi::paginatedPurchasesFromJson(const QJsonObject &json) const
+PaginatedPurchases PurchaseApi::paginatedPurchasesFromJson(const QJsonObject &json)
 {
     PaginatedPurchases result;
     const QJsonObject &meta = json["purchases"_L1].toObject();
@@ -242,32 +243,23 @@ QFuture<void> PurchaseApi::getPurchases(const QString &search, const QString &so
     setLoading(true);
     QString path = QStringLiteral("/api/v1/purchases");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-    if (!status.isEmpty())
-        queryParts << QStringLiteral("status=%1").arg(status);
-    if (!paymentStatus.isEmpty())
-        queryParts << QStringLiteral("payment_status=%1").arg(paymentStatus);
-
-    if (!queryParts.isEmpty()) {
-       path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .page(page)
+               .add("status"_L1, status)
+               .add("payment_status"_L1, paymentStatus)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedPurchases>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedPurchasesFromJson, QStringLiteral("purchases")).then([=](ApiResponse<PaginatedPurchases> response) {
         if (response.success) {
-            PaginatedPurchases paginatedPurchases = paginatedPurchasesFromJson(*response.data);
+            const PaginatedPurchases &paginatedPurchases = *response.data;
             Q_EMIT purchasesReceived(paginatedPurchases);
         } else {
             Q_EMIT errorPurchasesReceived(response.error->message, response.error->status,
@@ -286,8 +278,8 @@ QFuture<void> PurchaseApi::getPurchase(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/purchases/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Purchase purchase = purchaseFromJson(response.data->value("purchase"_L1).toObject());
@@ -314,8 +306,8 @@ QFuture<void> PurchaseApi::createPurchase(const Purchase &purchase)
 
     qDebug() << "Creating purchase with data:" << requestData;
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        QNetworkReply* reply = m_netManager->post(request, requestData);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        QNetworkReply* reply = network->post(request, requestData);
 
         // Add response logging
         connect(reply, &QNetworkReply::finished, [reply]() {
@@ -365,8 +357,8 @@ QFuture<void> PurchaseApi::updatePurchase(int id, const Purchase &purchase)
 
     QJsonObject jsonData = purchaseToJson(purchase);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Purchase updatedPurchase = purchaseFromJson(response.data->value("purchase"_L1).toObject());
@@ -387,8 +379,8 @@ QFuture<void> PurchaseApi::deletePurchase(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/purchases/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT purchaseDeleted(id);
@@ -411,8 +403,8 @@ QFuture<void> PurchaseApi::addPayment(int id, const PurchasePayment &payment)
 
     QJsonObject jsonData = paymentToJson(payment);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT paymentAdded(response.data->value("payment"_L1).toObject().toVariantMap());
@@ -432,8 +424,8 @@ QFuture<void> PurchaseApi::generateInvoice(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/purchases/%1/generate-invoice").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QByteArray());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QByteArray());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT invoiceGenerated(response.data->value("invoice"_L1).toObject().toVariantMap());
@@ -451,15 +443,13 @@ QFuture<void> PurchaseApi::getSummary(const QString &period)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/purchases/summary");
-    if (!period.isEmpty()) {
-        path += QStringLiteral("?period=%1").arg(period);
-    }
+    path = ListQuery().add("period"_L1, period).path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT summaryReceived(response.data->value("summary"_L1).toObject().toVariantMap());
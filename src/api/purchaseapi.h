@@ -55,7 +55,6 @@ struct Purchase {
     QString notes;
     QVariantMap supplier;
     QList<PurchaseItem> items;
-    bool checked = false;
 };
 
 
@@ -82,6 +81,11 @@ class PurchaseApi : public AbstractApi {
 public:
     explicit PurchaseApi(QNetworkAccessManager *netManager, QObject *parent = nullptr);
 
+    // JSON decoding; pure, so it can run on the decode pool (and in dim_bench)
+    static Purchase purchaseFromJson(const QJsonObject &json);
+    static PurchaseItem purchaseItemFromJson(const QJsonObject &json);
+    static PaginatedPurchases paginatedPurchasesFromJson(const QJsonObject &json);
+
     // CRUD operations
     Q_INVOKABLE QFuture<void> getPurchases(const QString &search = QString(),
                                            const QString &sortBy = QStringLiteral("purchase_date"),
@@ -130,12 +134,9 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    Purchase purchaseFromJson(const QJsonObject &json) const;
-    PurchaseItem purchaseItemFromJson(const QJsonObject &json) const;
     QJsonObject purchaseToJson(const Purchase &purchase) const;
     QJsonObject purchaseItemToJson(const PurchaseItem &item) const;
     QJsonObject paymentToJson(const PurchasePayment &payment) const;
-    PaginatedPurchases paginatedPurchasesFromJson(const QJsonObject &json) const;
     QVariantMap purchaseToVariantMap(const Purchase &purchase) const;
     QVariantMap purchaseItemToVariantMap(const PurchaseItem &item) const;
 
@@ -0,0 +1,219 @@
+// requestbatch.cpp
+#include "requestbatch.h"
+#include "bufferedreply.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace Qt::StringLiterals;
+
+namespace NetworkApi {
+
+static RequestBatch *s_current = nullptr;
+QSet<QString> RequestBatch::s_unsupportedHosts;
+
+class RequestBatch::Collector : public QNetworkAccessManager
+{
+public:
+    explicit Collector(RequestBatch *batch)
+        : QNetworkAccessManager(batch)
+        , m_batch(batch)
+    {
+    }
+
+protected:
+    QNetworkReply *createRequest(Operation operation, const QNetworkRequest &request,
+                                 QIODevice *outgoingData) override
+    {
+        if (operation != GetOperation)
+            return m_batch->m_network->sendCustomRequest(request, verb(operation, request), outgoingData);
+
+        // Parented like a regular reply: the batch goes away before its
+        // callers are done with their replies
+        auto *reply = new BufferedReply(operation, request, m_batch->m_network);
+        m_batch->m_calls.append({reply, request});
+        return reply;
+    }
+
+private:
+    static QByteArray verb(Operation operation, const QNetworkRequest &request)
+    {
+        switch (operation) {
+        case HeadOperation: return QByteArrayLiteral("HEAD");
+        case GetOperation: return QByteArrayLiteral("GET");
+        case PutOperation: return QByteArrayLiteral("PUT");
+        case PostOperation: return QByteArrayLiteral("POST");
+        case DeleteOperation: return QByteArrayLiteral("DELETE");
+        default:
+            return request.attribute(QNetworkRequest::CustomVerbAttribute).toByteArray();
+        }
+    }
+
+    RequestBatch *m_batch;
+};
+
+RequestBatch::RequestBatch(QNetworkAccessManager *network, const QString &apiHost)
+    : m_network(network)
+    , m_apiHost(apiHost)
+    , m_collector(new Collector(this))
+{
+    Q_ASSERT(!s_current);
+    s_current = this;
+}
+
+RequestBatch::~RequestBatch()
+{
+    if (s_current == this)
+        s_current = nullptr;
+}
+
+RequestBatch *RequestBatch::current()
+{
+    return s_current;
+}
+
+void RequestBatch::submit()
+{
+    if (s_current == this)
+        s_current = nullptr;
+
+    // Superseded before the batch even left
+    m_calls.removeIf([](const Call &call) {
+        return !call.reply || call.reply->isFinished();
+    });
+
+    if (m_calls.size() > 1 && !s_unsupportedHosts.contains(m_apiHost))
+        sendBatch();
+    else
+        sendIndividually();
+}
+
+void RequestBatch::sendBatch()
+{
+    QJsonArray requests;
+    for (qsizetype i = 0; i < m_calls.size(); ++i) {
+        const QNetworkRequest &request = m_calls.at(i).request;
+        // Conditional headers let the server answer 304 for cached pages.
+        // Accept is left out: the bodies come back embedded in the JSON, so
+        // a CBOR one would not survive the trip
+        QJsonObject headers;
+        for (const QByteArray &name : request.rawHeaderList()) {
+            if (name.compare("Authorization", Qt::CaseInsensitive) != 0 && name.compare("Accept", Qt::CaseInsensitive) != 0)
+                headers.insert(QString::fromLatin1(name), QString::fromLatin1(request.rawHeader(name)));
+        }
+        requests.append(QJsonObject{
+            {"id"_L1, QString::number(i)},
+            {"method"_L1, "GET"_L1},
+            {"path"_L1, request.url().toString(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::FullyEncoded)},
+            {"headers"_L1, headers},
+        });
+    }
+
+    QNetworkRequest request(QUrl(m_apiHost + "/api/v1/batch"_L1));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json"_L1);
+    request.setRawHeader("Accept", "application/json");
+    request.setRawHeader("Authorization", m_calls.first().request.rawHeader("Authorization"));
+
+    QNetworkReply *reply = m_network->post(request, QJsonDocument(QJsonObject{{"requests"_L1, requests}}).toJson(QJsonDocument::Compact));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        batchFinished(reply);
+    });
+    // Keep the stall timers of the calls alive while the batch downloads
+    for (const Call &call : std::as_const(m_calls)) {
+        connect(reply, &QNetworkReply::downloadProgress, call.reply, [reply = call.reply]() {
+            Q_EMIT reply->downloadProgress(0, -1);
+        });
+    }
+}
+
+void RequestBatch::sendIndividually()
+{
+    for (const Call &call : std::as_const(m_calls)) {
+        if (!call.reply || call.reply->isFinished())
+            continue;
+        QNetworkReply *real = m_network->get(call.request);
+        QPointer<BufferedReply> buffered = call.reply;
+        connect(real, &QNetworkReply::finished, real, [real, buffered]() {
+            if (buffered)
+                buffered->fulfilFrom(real);
+            real->deleteLater();
+        });
+        connect(real, &QNetworkReply::downloadProgress, buffered, &QNetworkReply::downloadProgress);
+        // Superseded or timed out: stop the transfer as well
+        connect(buffered, &QNetworkReply::finished, real, [real]() {
+            if (!real->isFinished())
+                real->abort();
+        });
+    }
+    deleteLater();
+}
+
+void RequestBatch::batchFinished(QNetworkReply *reply)
+{
+    reply->deleteLater();
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+
+    if (status == 404 || status == 405 || status == 501) {
+        qDebug() << "No batch endpoint on" << m_apiHost << "- sending calls individually";
+        s_unsupportedHosts.insert(m_apiHost);
+        sendIndividually();
+        return;
+    }
+
+    // Transport failure: every call failed the same way, and each one
+    // decides on its own whether to retry
+    if (status == 0) {
+        for (const Call &call : std::as_const(m_calls)) {
+            if (call.reply)
+                call.reply->fail(reply->error(), reply->errorString());
+        }
+        deleteLater();
+        return;
+    }
+
+    const QByteArray body = reply->readAll();
+    const QJsonObject json = QJsonDocument::fromJson(body).object();
+    if (status != 200 || !json.value("responses"_L1).isArray()) {
+        // Auth and server errors concern the whole batch: pass them on
+        for (const Call &call : std::as_const(m_calls)) {
+            if (call.reply)
+                call.reply->fulfil(status == 200 ? 502 : status, reply->rawHeaderPairs(), body);
+        }
+        deleteLater();
+        return;
+    }
+
+    const QJsonArray responses = json.value("responses"_L1).toArray();
+    for (const QJsonValue &value : responses) {
+        const QJsonObject response = value.toObject();
+        bool ok = false;
+        const int index = response.value("id"_L1).toString().toInt(&ok);
+        if (!ok || index < 0 || index >= m_calls.size() || !m_calls.at(index).reply)
+            continue;
+
+        QList<QNetworkReply::RawHeaderPair> headers;
+        const QJsonObject headerObject = response.value("headers"_L1).toObject();
+        for (auto it = headerObject.constBegin(); it != headerObject.constEnd(); ++it)
+            headers.append({it.key().toLatin1(), it.value().toString().toLatin1()});
+
+        // Bodies come back embedded as JSON, or as a string when they are not
+        const QJsonValue payload = response.value("body"_L1);
+        QByteArray callBody;
+        if (payload.isObject())
+            callBody = QJsonDocument(payload.toObject()).toJson(QJsonDocument::Compact);
+        else if (payload.isArray())
+            callBody = QJsonDocument(payload.toArray()).toJson(QJsonDocument::Compact);
+        else
+            callBody = payload.toString().toUtf8();
+
+        m_calls.at(index).reply->fulfil(response.value("status"_L1).toInt(), headers, callBody);
+    }
+
+    for (const Call &call : std::as_const(m_calls)) {
+        if (call.reply && !call.reply->isFinished())
+            call.reply->fail(QNetworkReply::ProtocolFailure, tr("The batch response did not include this request."));
+    }
+    deleteLater();
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,65 @@
+// requestbatch.h
+#ifndef REQUESTBATCH_H
+#define REQUESTBATCH_H
+
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+
+namespace NetworkApi {
+
+class BufferedReply;
+
+// Bundles the GETs issued while it is collecting into one POST to the
+// backend's batch endpoint:
+//
+//   POST /api/v1/batch  {"requests": [{"id", "method", "path", "headers"}]}
+//   200                 {"responses": [{"id", "status", "headers", "body"}]}
+//
+// Every call gets a BufferedReply straight away and is answered from its
+// part of the batch response, so callers keep their own futures, handlers
+// and signals. Hosts without the endpoint (404, 405, 501) are remembered and
+// served with parallel requests instead. Other methods are not batched.
+//
+// Use it through AbstractApi::batch(). It deletes itself once answered.
+class RequestBatch : public QObject
+{
+    Q_OBJECT
+public:
+    RequestBatch(QNetworkAccessManager *network, const QString &apiHost);
+    ~RequestBatch() override;
+
+    // The batch collecting right now, if any
+    static RequestBatch *current();
+
+    // Manager to send through while collecting: it answers GETs with
+    // buffered replies and passes anything else to the real manager.
+    QNetworkAccessManager *collector() const { return m_collector; }
+
+    // Ends collection and sends what was collected
+    void submit();
+
+private:
+    class Collector;
+
+    struct Call {
+        QPointer<BufferedReply> reply;
+        QNetworkRequest request;
+    };
+
+    void sendBatch();
+    void sendIndividually();
+    void batchFinished(QNetworkReply *reply);
+
+    QNetworkAccessManager *m_network;
+    QString m_apiHost;
+    Collector *m_collector;
+    QList<Call> m_calls;
+
+    static QSet<QString> s_unsupportedHosts;
+};
+
+} // namespace NetworkApi
+
+#endif // REQUESTBATCH_H
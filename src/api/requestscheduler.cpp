@@ -0,0 +1,110 @@
+// requestscheduler.cpp
+#include "requestscheduler.h"
+
+namespace NetworkApi {
+
+RequestScheduler *RequestScheduler::instance()
+{
+    static RequestScheduler scheduler;
+    return &scheduler;
+}
+
+RequestScheduler::RequestScheduler()
+    // QNetworkAccessManager opens up to six connections per host; keeping the
+    // total at that number means our queue, not Qt's FIFO one, decides order.
+    : m_limits{6, 4, 2, 2}
+    , m_totalLimit(6)
+{
+}
+
+quint64 RequestScheduler::schedule(RequestPriority priority, std::function<bool()> start)
+{
+    const quint64 ticket = m_nextTicket++;
+    m_queues[int(priority)].append({ticket, std::move(start)});
+    dispatch();
+    return ticket;
+}
+
+bool RequestScheduler::cancel(quint64 ticket)
+{
+    for (QList<Entry> &queue : m_queues) {
+        for (qsizetype i = 0; i < queue.size(); ++i) {
+            if (queue.at(i).ticket == ticket) {
+                queue.removeAt(i);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void RequestScheduler::release(RequestPriority priority)
+{
+    int &running = m_running[int(priority)];
+    Q_ASSERT(running > 0);
+    running = qMax(0, running - 1);
+    dispatch();
+}
+
+void RequestScheduler::setLimit(RequestPriority priority, int limit)
+{
+    m_limits[int(priority)] = qMax(1, limit);
+    dispatch();
+}
+
+void RequestScheduler::setTotalLimit(int limit)
+{
+    m_totalLimit = qMax(1, limit);
+    dispatch();
+}
+
+int RequestScheduler::running(RequestPriority priority) const
+{
+    return m_running[int(priority)];
+}
+
+int RequestScheduler::queued(RequestPriority priority) const
+{
+    return int(m_queues[int(priority)].size());
+}
+
+bool RequestScheduler::canStart(int index) const
+{
+    if (m_running[index] >= m_limits[index])
+        return false;
+    if (index == int(RequestPriority::Interactive))
+        return true;
+
+    int total = 0;
+    for (int running : m_running)
+        total += running;
+    return total < m_totalLimit;
+}
+
+void RequestScheduler::dispatch()
+{
+    // start() may finish synchronously and release(); the outer loop picks
+    // up whatever that frees
+    if (m_dispatching)
+        return;
+    m_dispatching = true;
+
+    bool started = true;
+    while (started) {
+        started = false;
+        for (int index = 0; index < ClassCount; ++index) {
+            if (m_queues[index].isEmpty() || !canStart(index))
+                continue;
+            Entry entry = m_queues[index].takeFirst();
+            ++m_running[index];
+            if (!entry.start())
+                --m_running[index];
+            started = true;
+            break;
+        }
+    }
+
+    m_dispatching = false;
+}
+
+} // namespace NetworkApi
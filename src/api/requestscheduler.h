@@ -0,0 +1,69 @@
+// requestscheduler.h
+#ifndef REQUESTSCHEDULER_H
+#define REQUESTSCHEDULER_H
+
+#include <QHash>
+#include <QList>
+#include <array>
+#include <functional>
+
+namespace NetworkApi {
+
+// Importance of a request, highest first
+enum class RequestPriority {
+    Interactive, // the user is waiting on it (checkout, payments)
+    Visible,     // data for what is on screen
+    Prefetch,    // data that will probably be needed soon
+    Background,  // dashboard analytics, statistics
+};
+
+// Orders requests of every API instance before they reach the shared
+// QNetworkAccessManager, which would otherwise send them first come first
+// served. Each priority class has its own concurrency cap, and all but
+// Interactive also share a global cap, so a burst of background work can
+// never occupy every connection. Queued work always starts highest class
+// first; Interactive requests therefore overtake anything still waiting.
+class RequestScheduler
+{
+public:
+    static RequestScheduler *instance();
+
+    // start() is called once a slot is free, possibly right away. It returns
+    // false when it ended up not sending anything, which frees the slot.
+    // The returned ticket identifies the queued request for cancel().
+    quint64 schedule(RequestPriority priority, std::function<bool()> start);
+    // Drops a request that has not started yet. Returns false if it already has.
+    bool cancel(quint64 ticket);
+    // Called when a started request has finished
+    void release(RequestPriority priority);
+
+    void setLimit(RequestPriority priority, int limit);
+    void setTotalLimit(int limit);
+
+    int running(RequestPriority priority) const;
+    int queued(RequestPriority priority) const;
+
+private:
+    RequestScheduler();
+
+    struct Entry {
+        quint64 ticket;
+        std::function<bool()> start;
+    };
+
+    static constexpr int ClassCount = 4;
+
+    bool canStart(int index) const;
+    void dispatch();
+
+    std::array<QList<Entry>, ClassCount> m_queues;
+    std::array<int, ClassCount> m_running{};
+    std::array<int, ClassCount> m_limits;
+    int m_totalLimit;
+    quint64 m_nextTicket = 1;
+    bool m_dispatching = false;
+};
+
+} // namespace NetworkApi
+
+#endif // REQUESTSCHEDULER_H
@@ -0,0 +1,224 @@
+// responsecache.cpp
+#include "responsecache.h"
+#include "listquery.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace NetworkApi {
+using namespace Qt::StringLiterals;
+
+namespace {
+constexpr quint32 EntryMagic = 0x44494d43; // "DIMC"
+constexpr quint16 EntryVersion = 1;
+}
+
+ResponseCache *ResponseCache::instance()
+{
+    static ResponseCache cache;
+    return &cache;
+}
+
+ResponseCache::ResponseCache()
+    : m_directory(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                  + QStringLiteral("/api-responses"))
+{
+    QDir().mkpath(m_directory);
+}
+
+void ResponseCache::setScope(const QString &scope)
+{
+    QMutexLocker locker(&m_mutex);
+    m_scope = scope;
+}
+
+QString ResponseCache::scope() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_scope;
+}
+
+QString ResponseCache::cacheKey(const QNetworkRequest &request) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(scope().toUtf8());
+    hash.addData("\n");
+    hash.addData(request.rawHeader("Authorization"));
+    hash.addData("\n");
+    // JSON and CBOR bodies of the same page are different entries
+    hash.addData(request.rawHeader("Accept"));
+    hash.addData("\n");
+    // Same filters in another order, or encoded differently, are the same page
+    hash.addData(ListQuery::canonical(request.url()).toEncoded());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+bool ResponseCache::applyValidators(const QString &key, QNetworkRequest &request)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_validators.constFind(key);
+    if (it == m_validators.constEnd()) {
+        const std::optional<Entry> entry = readEntry(key);
+        if (!entry)
+            return false;
+        Entry validators;
+        validators.etag = entry->etag;
+        validators.lastModified = entry->lastModified;
+        it = m_validators.insert(key, validators);
+    } else if (!QFileInfo::exists(entryPath(key))) {
+        // The body went away behind our back; a 304 could not be served
+        m_validators.erase(it);
+        return false;
+    }
+
+    if (!it->etag.isEmpty())
+        request.setRawHeader("If-None-Match", it->etag);
+    if (!it->lastModified.isEmpty())
+        request.setRawHeader("If-Modified-Since", it->lastModified);
+    return !it->etag.isEmpty() || !it->lastModified.isEmpty();
+}
+
+std::optional<QByteArray> ResponseCache::body(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    const std::optional<Entry> entry = readEntry(key);
+    if (!entry) {
+        m_validators.remove(key);
+        return std::nullopt;
+    }
+    // Touch the file so pruning evicts the least recently served pages first
+    QFile file(entryPath(key));
+    if (file.open(QIODevice::ReadWrite))
+        file.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+    return entry->body;
+}
+
+void ResponseCache::store(const QString &key, const Entry &entry)
+{
+    if (entry.etag.isEmpty() && entry.lastModified.isEmpty())
+        return;
+    if (entry.body.size() > m_maximumSize / 4)
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    ensureSizeKnown();
+
+    const QString path = entryPath(key);
+    const qint64 previousSize = QFileInfo(path).size();
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "ResponseCache: cannot write" << path << file.errorString();
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << EntryMagic << EntryVersion << entry.etag << entry.lastModified << entry.body;
+    if (!file.commit()) {
+        qWarning() << "ResponseCache: cannot commit" << path << file.errorString();
+        return;
+    }
+
+    Entry validators;
+    validators.etag = entry.etag;
+    validators.lastModified = entry.lastModified;
+    m_validators.insert(key, validators);
+
+    m_currentSize += QFileInfo(path).size() - previousSize;
+    if (m_currentSize > m_maximumSize)
+        prune();
+}
+
+void ResponseCache::remove(const QString &key)
+{
+    QMutexLocker locker(&m_mutex);
+    ensureSizeKnown();
+    const QString path = entryPath(key);
+    m_currentSize -= QFileInfo(path).size();
+    QFile::remove(path);
+    m_validators.remove(key);
+}
+
+void ResponseCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    QDir(m_directory).removeRecursively();
+    QDir().mkpath(m_directory);
+    m_validators.clear();
+    m_currentSize = 0;
+}
+
+void ResponseCache::setMaximumSize(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_maximumSize = bytes;
+    ensureSizeKnown();
+    if (m_currentSize > m_maximumSize)
+        prune();
+}
+
+QString ResponseCache::entryPath(const QString &key) const
+{
+    return m_directory + QLatin1Char('/') + key + QStringLiteral(".entry");
+}
+
+std::optional<ResponseCache::Entry> ResponseCache::readEntry(const QString &key) const
+{
+    QFile file(entryPath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != EntryMagic || version != EntryVersion)
+        return std::nullopt;
+
+    Entry entry;
+    in >> entry.etag >> entry.lastModified >> entry.body;
+    if (in.status() != QDataStream::Ok)
+        return std::nullopt;
+    return entry;
+}
+
+void ResponseCache::ensureSizeKnown()
+{
+    if (m_currentSize >= 0)
+        return;
+    m_currentSize = 0;
+    QDirIterator it(m_directory, {QStringLiteral("*.entry")}, QDir::Files);
+    while (it.hasNext()) {
+        it.next();
+        m_currentSize += it.fileInfo().size();
+    }
+}
+
+void ResponseCache::prune()
+{
+    QFileInfoList files = QDir(m_directory).entryInfoList({QStringLiteral("*.entry")}, QDir::Files);
+    std::sort(files.begin(), files.end(), [](const QFileInfo &a, const QFileInfo &b) {
+        return a.lastModified() < b.lastModified();
+    });
+
+    // Evict down to three quarters of the budget so we do not prune on every store
+    const qint64 target = m_maximumSize - m_maximumSize / 4;
+    for (const QFileInfo &info : std::as_const(files)) {
+        if (m_currentSize <= target)
+            break;
+        m_currentSize -= info.size();
+        m_validators.remove(info.completeBaseName());
+        QFile::remove(info.absoluteFilePath());
+    }
+}
+
+} // namespace NetworkApi
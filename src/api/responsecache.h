@@ -0,0 +1,65 @@
+// responsecache.h
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QNetworkRequest>
+#include <QString>
+#include <optional>
+
+namespace NetworkApi {
+
+// Persistent store of GET response bodies together with their HTTP validators.
+// AbstractApi uses it to turn repeated list requests into conditional requests
+// (If-None-Match / If-Modified-Since) and to serve 304 replies from disk.
+class ResponseCache
+{
+public:
+    struct Entry {
+        QByteArray etag;
+        QByteArray lastModified;
+        QByteArray body;
+    };
+
+    static ResponseCache *instance();
+
+    // Entries are isolated per scope (the current team) on top of the
+    // Authorization header, so two accounts never share a cached page.
+    void setScope(const QString &scope);
+    QString scope() const;
+
+    QString cacheKey(const QNetworkRequest &request) const;
+
+    // Adds the conditional headers for a known entry. Returns false when
+    // nothing is cached for the key.
+    bool applyValidators(const QString &key, QNetworkRequest &request);
+
+    std::optional<QByteArray> body(const QString &key);
+    void store(const QString &key, const Entry &entry);
+    void remove(const QString &key);
+    void clear();
+
+    void setMaximumSize(qint64 bytes);
+    qint64 maximumSize() const { return m_maximumSize; }
+
+private:
+    ResponseCache();
+
+    QString entryPath(const QString &key) const;
+    std::optional<Entry> readEntry(const QString &key) const;
+    void ensureSizeKnown();
+    void prune();
+
+    mutable QMutex m_mutex;
+    QString m_directory;
+    QString m_scope;
+    QHash<QString, Entry> m_validators; // bodies are left on disk
+    qint64 m_maximumSize = 64 * 1024 * 1024;
+    qint64 m_currentSize = -1;
+};
+
+} // namespace NetworkApi
+
+#endif // RESPONSECACHE_H
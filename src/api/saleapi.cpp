@@ -1,8 +1,11 @@
 // saleapi.cpp
 #include "saleapi.h"
+#include "listquery.h"
+#include "jsondecoders.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
+#include <algorithm>
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
@@ -14,7 +17,7 @@ SaleApi::SaleApi(QNetworkAccessManager *netManager, QObject *parent)
 }
 
 // Helper Methods
-Sale SaleApi::saleFromJson(const QJsonObject &json) const
+Sale SaleApi::saleFromJson(const QJsonObject &json)
 {
     Sale sale;
     sale.id = json["id"_L1].toInt();
@@ -53,7 +56,7 @@ Sale SaleApi::saleFromJson(const QJsonObject &json) const
     return sale;
 }
 
-SaleItem SaleApi::saleItemFromJson(const QJsonObject &json) const
+SaleItem SaleApi::saleItemFromJson(const QJsonObject &json)
 {
     SaleItem item;
     item.id = json["id"_L1].toInt();
@@ -160,22 +163,6 @@ QJsonObject SaleApi::paymentToJson(const Payment &payment) const
     return json;
 }
 
-PaginatedSales SaleApi::paginatedSalesFromJson(const QJsonObject &json) const
-{
-    PaginatedSales result;
-    const QJsonObject &meta = json["sales"_L1].toObject();
-    result.currentPage = meta["current_page"_L1].toInt();
-    result.lastPage = meta["last_page"_L1].toInt();
-    result.perPage = meta["per_page"_L1].toInt();
-    result.total = meta["total"_L1].toInt();
-
-    const QJsonArray &dataArray = meta["data"_L1].toArray();
-    for (const QJsonValue &value : dataArray) {
-        result.data.append(saleFromJson(value.toObject()));
-    }
-
-    return result;
-}
 
 QVariantMap SaleApi::saleToVariantMap(const Sale &sale) const
 {
@@ -299,39 +286,30 @@ QJsonObject SaleApi::configToJson(const DocumentConfig &config) const
 QFuture<void> SaleApi::getSales(const QString &search, const QString &sortBy,
                                 const QString &sortDirection, int page,
                                 const QString &status, const QString &paymentStatus,
-                                const QString &type) // Add type parameter
+                                const QString &type, const Fieldset &fieldset,
+                                const std::optional<QString> &cursor)
 {
     setLoading(true);
     QString path = QStringLiteral("/api/v1/sales");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-    if (!status.isEmpty())
-        queryParts << QStringLiteral("status=%1").arg(status);
-    if (!paymentStatus.isEmpty())
-        queryParts << QStringLiteral("payment_status=%1").arg(paymentStatus);
-    if (!type.isEmpty())
-        queryParts << QStringLiteral("type=%1").arg(type); // Add type filter
-
-    if (!queryParts.isEmpty()) {
-        path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .pagination(page, cursor)
+               .add("status"_L1, status)
+               .add("payment_status"_L1, paymentStatus)
+               .add("type"_L1, type)
+               .fieldset(fieldset)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeStreamDecodedRequest<PaginatedSales>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &decodePaginatedSales, QStringLiteral("sales")).then([=](ApiResponse<PaginatedSales> response) {
         if (response.success) {
-            PaginatedSales paginatedSales = paginatedSalesFromJson(*response.data);
+            const PaginatedSales &paginatedSales = *response.data;
             Q_EMIT salesReceived(paginatedSales);
         } else {
             Q_EMIT errorSalesReceived(response.error->message, response.error->status,
@@ -350,12 +328,13 @@ QFuture<void> SaleApi::getSale(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/sales/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Sale sale = saleFromJson(response.data->value("sale"_L1).toObject());
             Q_EMIT saleReceived(saleToVariantMap(sale));
+            Q_EMIT saleDetailsReceived(sale);
         } else {
             Q_EMIT errorSaleReceived(response.error->message, response.error->status,
                                      QJsonDocument(response.error->details).toJson());
@@ -377,9 +356,9 @@ QFuture<void> SaleApi::createSale(const Sale &sale)
 
     QJsonObject jsonData = saleToJson(sale);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
-    }).then([=](JsonResponse response) {
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
+    }, QString(), RequestPriority::Interactive).then([=](JsonResponse response) {
         if (response.success) {
             Sale createdSale = saleFromJson(response.data->value("sale"_L1).toObject());
             qDebug() << "================== Done:";
@@ -406,8 +385,8 @@ QFuture<void> SaleApi::updateSale(int id, const Sale &sale)
 
     QJsonObject jsonData = saleToJson(sale);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Sale updatedSale = saleFromJson(response.data->value("sale"_L1).toObject());
@@ -422,14 +401,103 @@ QFuture<void> SaleApi::updateSale(int id, const Sale &sale)
     return future.then([=]() {});
 }
 
+// base with the members saleToJson() sends taken from edit: the sale the
+// server holds once a patch applies. Edited items keep the id and product
+// details of the base item selling the same product or package.
+static Sale applySaleEdit(const Sale &base, const Sale &edit)
+{
+    Sale sale = base;
+    sale.cash_source_id = edit.cash_source_id;
+    sale.sale_date = edit.sale_date;
+    sale.status = edit.status;
+    sale.payment_status = edit.payment_status;
+    sale.type = edit.type;
+    sale.total_amount = edit.total_amount;
+    sale.tax_amount = edit.tax_amount;
+    sale.discount_amount = edit.discount_amount;
+    sale.notes = edit.notes;
+    // saleToJson() only sends a client that is set
+    if (edit.client_id > 0) {
+        if (edit.client_id != base.client_id) {
+            sale.client_id = edit.client_id;
+            sale.client = edit.client;
+        }
+        if (edit.due_date.isValid())
+            sale.due_date = edit.due_date;
+    }
+
+    QList<SaleItem> known = base.items;
+    sale.items.clear();
+    sale.items.reserve(edit.items.size());
+    for (SaleItem item : edit.items) {
+        const auto match = std::find_if(known.begin(), known.end(), [&item](const SaleItem &other) {
+            return other.product_id == item.product_id && other.is_package == item.is_package
+                && (!item.is_package || other.package_id == item.package_id);
+        });
+        if (match != known.end()) {
+            item.id = match->id;
+            if (item.product_name.isEmpty())
+                item.product_name = match->product_name;
+            if (item.product.isEmpty())
+                item.product = match->product;
+            if (item.package.isEmpty())
+                item.package = match->package;
+            known.erase(match);
+        } else {
+            item.id = 0;
+        }
+        sale.items.append(item);
+    }
+    sale.itemsValue = QVariant();
+    return sale;
+}
+
+QFuture<void> SaleApi::patchSale(const Sale &base, const Sale &sale)
+{
+    QJsonObject changes = changedMembers(saleToJson(base), saleToJson(sale));
+    // saleToJson() leaves empty notes out, which would keep them
+    if (sale.notes.isEmpty() && !base.notes.isEmpty())
+        changes["notes"_L1] = QString();
+    if (changes.isEmpty()) {
+        Q_EMIT saleUpdated(base);
+        return QtFuture::makeReadyVoidFuture();
+    }
+
+    setLoading(true);
+    QNetworkRequest request = createRequest(QStringLiteral("/api/v1/sales/%1").arg(base.id));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
+    request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+
+    // What the server holds once the patch applies, should its reply leave
+    // some of the changed members out
+    const Sale patched = applySaleEdit(base, sale);
+
+    auto future = makeStreamDecodedRequest<Sale>([=](QNetworkAccessManager *network) {
+        return sendPatch(network, request, changes);
+    }, [patched](QByteArrayView body) {
+        // 204 No Content: the patch applied as sent
+        return body.isEmpty() ? std::optional<Sale>(patched) : decodeSale(body, patched);
+    }).then([=](ApiResponse<Sale> response) {
+        if (response.success) {
+            Q_EMIT saleUpdated(*response.data);
+        } else {
+            Q_EMIT errorSaleUpdated(response.error->message, response.error->status,
+                                    QJsonDocument(response.error->details).toJson());
+        }
+        setLoading(false);
+    });
+
+    return future.then([=]() {});
+}
+
 QFuture<void> SaleApi::deleteSale(int id)
 {
     setLoading(true);
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/sales/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT saleDeleted(id);
@@ -459,9 +527,9 @@ QFuture<void> SaleApi::addPayment(int id, const Payment &payment)
         jsonData["cash_source_id"_L1] = payment.cash_source_id;
     }
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
-    }).then([=](JsonResponse response) {
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
+    }, QString(), RequestPriority::Interactive).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT paymentAdded(response.data->value("sale"_L1).toObject().toVariantMap());
         } else {
@@ -494,8 +562,8 @@ QFuture<void> SaleApi::generateInvoice(int id, const QVariantMap &configMap)
     // Debug output
     qDebug() << "Sending invoice generation request:" << QJsonDocument(jsonData).toJson();
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             QVariantMap invoice = response.data->toVariantMap();
@@ -520,8 +588,8 @@ QFuture<void> SaleApi::convertToSale(int id)
     request.setHeader(QNetworkRequest::ContentTypeHeader, QStringLiteral("application/json"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QByteArray());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QByteArray());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Sale convertedSale = saleFromJson(response.data->value("sale"_L1).toObject());
@@ -562,21 +630,21 @@ QFuture<QByteArray> SaleApi::generateReceipt(int id, int paperWidthMM, const QSt
 
     auto promise = std::make_shared<QPromise<QByteArray>>();
 
-    m_currentReply = m_netManager->get(request);
-
-    connect(m_currentReply, &QNetworkReply::finished, this, [this, promise]() {
+    makeRawRequest([=](QNetworkAccessManager *network) {
+        return network->get(request);
+    }).then(this, [this, promise](const RawResponse &reply) {
         setLoading(false);
 
-        if (m_currentReply->error() == QNetworkReply::NoError) {
-            QString contentType = m_currentReply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (reply.networkError == QNetworkReply::NoError) {
+            QString contentType = QString::fromLatin1(reply.header("Content-Type"));
 
             if (contentType.contains("application/pdf"_L1)) {
-                QByteArray pdfData = m_currentReply->readAll();
+                QByteArray pdfData = reply.body;
 
                 // Extract dimension metadata from response headers
-                int paperWidthMM = m_currentReply->rawHeader(QStringLiteral("X-Paper-Width-MM")).toInt();
-                int paperHeightPt = m_currentReply->rawHeader(QStringLiteral("X-Paper-Height-PT")).toInt();
-                QByteArray heightModeBytes = m_currentReply->rawHeader(QStringLiteral("X-Height-Mode"));
+                int paperWidthMM = reply.header("X-Paper-Width-MM").toInt();
+                int paperHeightPt = reply.header("X-Paper-Height-PT").toInt();
+                QByteArray heightModeBytes = reply.header("X-Height-Mode");
                 QString heightMode = QString::fromUtf8(heightModeBytes);
                 // Save to app's data location
                 QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
@@ -615,20 +683,18 @@ QFuture<QByteArray> SaleApi::generateReceipt(int id, int paperWidthMM, const QSt
                 }
             } else if (contentType.contains("application/json"_L1)) {
                 // Handle error response
-                QJsonDocument jsonResponse = QJsonDocument::fromJson(m_currentReply->readAll());
+                QJsonDocument jsonResponse = QJsonDocument::fromJson(reply.body);
                 QJsonObject jsonObject = jsonResponse.object();
                 QString errorMessage = jsonObject["message"_L1].toString();
                 Q_EMIT errorReceiptGenerated("Error"_L1, errorMessage);
                 promise->addResult(QByteArray());
             }
         } else {
-            Q_EMIT errorReceiptGenerated("Network Error"_L1, m_currentReply->errorString());
+            Q_EMIT errorReceiptGenerated("Network Error"_L1, reply.errorString);
             promise->addResult(QByteArray());
         }
 
         promise->finish();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
     });
 
     return promise->future();
@@ -663,52 +729,34 @@ QFuture<QByteArray> SaleApi::generateTestReceipt(int paperWidthMM, const QString
 
     auto promise = std::make_shared<QPromise<QByteArray>>();
 
-    // Cancel any existing operation
-    if (m_currentReply && m_currentReply->isRunning()) {
-        m_currentReply->abort();
-        m_currentReply->deleteLater();
-        m_currentReply = nullptr;
-    }
-
-    m_currentReply = m_netManager->get(request);
-
-    connect(m_currentReply, &QNetworkReply::finished, this, [this, promise]() {
-        // Create a local pointer to m_currentReply to ensure it doesn't change during the function
-        QNetworkReply *reply = m_currentReply;
-        m_currentReply = nullptr; // Set to null before any return statements
-
+    // A newer test receipt supersedes one still being generated
+    makeRawRequest([=](QNetworkAccessManager *network) {
+        return network->get(request);
+    }, QStringLiteral("testReceipt")).then(this, [this, promise](const RawResponse &reply) {
         setLoading(false);
 
-        if (!reply) {
-            qWarning() << "Reply is null in finished handler";
-            Q_EMIT errorReceiptGenerated(QStringLiteral("Error"), QStringLiteral("Request was canceled"));
-            promise->addResult(QByteArray());
-            promise->finish();
-            return;
-        }
-
-        if (reply->error() == QNetworkReply::NoError) {
-            QString contentType = reply->header(QNetworkRequest::ContentTypeHeader).toString();
+        if (reply.networkError == QNetworkReply::NoError) {
+            QString contentType = QString::fromLatin1(reply.header("Content-Type"));
 
             if (contentType.contains(QStringLiteral("application/pdf"))) {
-                QByteArray pdfData = reply->readAll();
+                QByteArray pdfData = reply.body;
 
                 // Extract dimension metadata from response headers
                 int paperWidthMM = 0;
                 int paperHeightPt = 0;
                 QString heightMode;
 
-                QByteArray paperWidthBytes = reply->rawHeader(QStringLiteral("X-Paper-Width-MM"));
+                QByteArray paperWidthBytes = reply.header("X-Paper-Width-MM");
                 if (!paperWidthBytes.isEmpty()) {
                     paperWidthMM = paperWidthBytes.toInt();
                 }
 
-                QByteArray paperHeightBytes = reply->rawHeader(QStringLiteral("X-Paper-Height-PT"));
+                QByteArray paperHeightBytes = reply.header("X-Paper-Height-PT");
                 if (!paperHeightBytes.isEmpty()) {
                     paperHeightPt = paperHeightBytes.toInt();
                 }
 
-                QByteArray heightModeBytes = reply->rawHeader(QStringLiteral("X-Height-Mode"));
+                QByteArray heightModeBytes = reply.header("X-Height-Mode");
                 if (!heightModeBytes.isEmpty()) {
                     heightMode = QString::fromUtf8(heightModeBytes);
                 }
@@ -761,7 +809,7 @@ QFuture<QByteArray> SaleApi::generateTestReceipt(int paperWidthMM, const QString
                 }
             } else if (contentType.contains(QStringLiteral("application/json"))) {
                 // Handle error response
-                QJsonDocument jsonResponse = QJsonDocument::fromJson(reply->readAll());
+                QJsonDocument jsonResponse = QJsonDocument::fromJson(reply.body);
                 QJsonObject jsonObject = jsonResponse.object();
                 QString errorMessage = jsonObject[QStringLiteral("message")].toString();
                 Q_EMIT errorReceiptGenerated(QStringLiteral("Error"), errorMessage);
@@ -773,17 +821,16 @@ QFuture<QByteArray> SaleApi::generateTestReceipt(int paperWidthMM, const QString
             }
         } else {
             // If the request was aborted by a new request, don't show an error
-            if (reply->error() == QNetworkReply::OperationCanceledError) {
+            if (reply.networkError == QNetworkReply::OperationCanceledError) {
                 qWarning() << "Request was canceled";
                 // Don't emit an error for canceled requests
             } else {
-                Q_EMIT errorReceiptGenerated(QStringLiteral("Network Error"), reply->errorString());
+                Q_EMIT errorReceiptGenerated(QStringLiteral("Network Error"), reply.errorString);
             }
             promise->addResult(QByteArray());
         }
 
         promise->finish();
-        reply->deleteLater();
     });
 
     return promise->future();
@@ -793,15 +840,13 @@ QFuture<void> SaleApi::getSummary(const QString &period)
 {
     setLoading(true);
     QString path = QStringLiteral( "/api/v1/sales/summary");
-    if (!period.isEmpty()) {
-        path += QStringLiteral("?period=%1").arg(period);
-    }
+    path = ListQuery().add("period"_L1, period).path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT summaryReceived(response.data->value("summary"_L1).toObject().toVariantMap());
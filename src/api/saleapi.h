@@ -3,6 +3,7 @@
 #define SALEAPI_H
 
 #include "abstractapi.h"
+#include "listquery.h"
 #include <QSettings>
 #include <QJsonArray>
 #include <QStandardPaths>
@@ -51,7 +52,9 @@ struct Sale {
     QVariantMap client;
     QList<SaleItem> items;
     bool auto_payment = false;
-    bool checked = false;
+    // items as SaleModel's ItemsRole, built the first time a view asks; a
+    // row that is replaced comes with none
+    mutable QVariant itemsValue;
 };
 
 struct PaginatedSales {
@@ -60,6 +63,7 @@ struct PaginatedSales {
     int lastPage;
     int perPage;
     int total;
+    QString nextCursor; // keyset pagination; empty after the last page
 };
 
 struct Payment {
@@ -91,6 +95,10 @@ class SaleApi : public AbstractApi {
 public:
     explicit SaleApi(QNetworkAccessManager *netManager, QObject *parent = nullptr);
 
+    // JSON decoding; pure, so it can run on the decode pool (and in dim_bench)
+    static Sale saleFromJson(const QJsonObject &json);
+    static SaleItem saleItemFromJson(const QJsonObject &json);
+
     // CRUD operations
     Q_INVOKABLE QFuture<void> getSales(const QString &search = QString(),
                                        const QString &sortBy = QStringLiteral("sale_date"),
@@ -98,11 +106,16 @@ public:
                                        int page = 1,
                                        const QString &status = QString(),
                                        const QString &paymentStatus = QString(),
-                                       const QString &type = QString() );
+                                       const QString &type = QString(),
+                                       const Fieldset &fieldset = Fieldset(),
+                                       const std::optional<QString> &cursor = std::nullopt);
 
     Q_INVOKABLE QFuture<void> getSale(int id);
     Q_INVOKABLE QFuture<void> createSale(const Sale &sale);
     Q_INVOKABLE QFuture<void> updateSale(int id, const Sale &sale);
+    // PATCH with only the members sale changes from base, the sale as the
+    // server last sent it; see ProductApi::patchProduct()
+    QFuture<void> patchSale(const Sale &base, const Sale &sale);
     Q_INVOKABLE QFuture<void> deleteSale(int id);
     Q_INVOKABLE QFuture<void> convertToSale(int id);
     // Additional operations
@@ -122,6 +135,8 @@ Q_SIGNALS:
     // Success signals
     void salesReceived(const PaginatedSales &sales);
     void saleReceived(const QVariantMap &sale);
+    // The same full record, for models holding a sparse copy of it
+    void saleDetailsReceived(const Sale &sale);
     void saleCreated(const Sale &sale);
     void saleMapCreated(const QVariantMap &sale);
     void saleUpdated(const Sale &sale);
@@ -147,14 +162,10 @@ Q_SIGNALS:
     void errorReceiptGenerated(const QString &title, const QString &message);
 private:
     // Helper methods for JSON conversion
-    QNetworkReply* m_currentReply = nullptr;
 
-    Sale saleFromJson(const QJsonObject &json) const;
-    SaleItem saleItemFromJson(const QJsonObject &json) const;
     QJsonObject saleToJson(const Sale &sale) const;
     QJsonObject saleItemToJson(const SaleItem &item) const;
     QJsonObject paymentToJson(const Payment &payment) const;
-    PaginatedSales paginatedSalesFromJson(const QJsonObject &json) const;
     QVariantMap saleToVariantMap(const Sale &sale) const;
     QVariantMap saleItemToVariantMap(const SaleItem &item) const;
     DocumentConfig configFromVariantMap(const QVariantMap &map) const;
@@ -18,8 +18,8 @@ QFuture<void> SubscriptionApi::getStatus(const QString &token ) {
     qDebug() << " 1 Token:" << authToken;
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(authToken).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         qDebug() << "Token:" << authToken;
 
@@ -1,5 +1,6 @@
 // supplierapi.cpp
 #include "supplierapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QUrlQuery>
@@ -19,28 +20,20 @@ QFuture<void> SupplierApi::getSuppliers(const QString &search, const QString &so
     setLoading(true);
     QString path = QStringLiteral("/api/v1/suppliers");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-
-    if (!queryParts.isEmpty()) {
-        path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .page(page)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedSuppliers>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedSuppliersFromJson, QStringLiteral("suppliers")).then([=](ApiResponse<PaginatedSuppliers> response) {
         if (response.success) {
-            PaginatedSuppliers paginatedSuppliers = paginatedSuppliersFromJson(*response.data);
+            const PaginatedSuppliers &paginatedSuppliers = *response.data;
             Q_EMIT suppliersReceived(paginatedSuppliers);
         } else {
             Q_EMIT errorSuppliersReceived(response.error->message, response.error->status,
@@ -57,8 +50,8 @@ QFuture<void> SupplierApi::getSupplier(int id)
     setLoading(true);
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/suppliers/%1").arg(id));
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             Supplier supplier = supplierFromJson(response.data->value("supplier"_L1).toObject());
@@ -81,8 +74,8 @@ QFuture<void> SupplierApi::createSupplier(const Supplier &supplier)
 
     QJsonObject jsonData = supplierToJson(supplier);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Supplier createdSupplier = supplierFromJson(response.data->value("supplier"_L1).toObject());
@@ -105,8 +98,8 @@ QFuture<void> SupplierApi::updateSupplier(int id, const Supplier &supplier)
 
     QJsonObject jsonData = supplierToJson(supplier);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Supplier updatedSupplier = supplierFromJson(response.data->value("supplier"_L1).toObject());
@@ -126,8 +119,8 @@ QFuture<void> SupplierApi::deleteSupplier(int id)
     setLoading(true);
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/suppliers/%1").arg(id));
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT supplierDeleted(id);
@@ -141,7 +134,7 @@ QFuture<void> SupplierApi::deleteSupplier(int id)
     return future.then([=]() {});
 }
 
-Supplier SupplierApi::supplierFromJson(const QJsonObject &json) const
+Supplier SupplierApi::supplierFromJson(const QJsonObject &json)
 {
     Supplier supplier;
     supplier.id = json["id"_L1].toInt();
@@ -171,7 +164,7 @@ QJsonObject SupplierApi::supplierToJson(const Supplier &supplier) const
     return json;
 }
 
-PaginatedSuppliers SupplierApi::paginatedSuppliersFromJson(const QJsonObject &json) const
+PaginatedSuppliers SupplierApi::paginatedSuppliersFromJson(const QJsonObject &json)
 {
     PaginatedSuppliers result;
     const QJsonObject &meta = json["suppliers"_L1].toObject();
@@ -19,7 +19,6 @@ struct Supplier {
     QString notes;
     QString status;
     double balance;
-    bool checked = false;
 };
 
 struct PaginatedSuppliers {
@@ -69,9 +68,9 @@ Q_SIGNALS:
     void isLoadingChanged();
 
 private:
-    Supplier supplierFromJson(const QJsonObject &json) const;
+    static Supplier supplierFromJson(const QJsonObject &json);
     QJsonObject supplierToJson(const Supplier &supplier) const;
-    PaginatedSuppliers paginatedSuppliersFromJson(const QJsonObject &json) const;
+    static PaginatedSuppliers paginatedSuppliersFromJson(const QJsonObject &json);
     QVariantMap supplierToVariantMap(const Supplier &supplier) const;
     QSettings m_settings;
     bool m_isLoading = false;
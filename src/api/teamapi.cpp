@@ -1,5 +1,6 @@
 // teamapi.cpp
 #include "teamapi.h"
+#include "listquery.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -14,7 +15,7 @@ QNetworkAccessManager* TeamApi::netManager = nullptr;
 void TeamApi::setSharedNetworkManager(QNetworkAccessManager* manager)
 {
     if (netManager && netManager->parent() == nullptr) {
-        delete netManager;
+        netManager->deleteLater();
     }
     netManager = manager;
 }
@@ -46,28 +47,21 @@ QFuture<void> TeamApi::getTeams(const QString &search, const QString &sortBy,
     setLoading(true);
     QString path = QStringLiteral("/api/v1/teams");
 
-    QStringList queryParts;
-    if (!search.isEmpty())
-        queryParts << QStringLiteral("search=%1").arg(search);
-    if (!sortBy.isEmpty())
-        queryParts << QStringLiteral("sort_by=%1").arg(sortBy);
-    if (!sortDirection.isEmpty())
-        queryParts << QStringLiteral("sort_direction=%1").arg(sortDirection);
-    if (page > 0)
-        queryParts << QStringLiteral("page=%1").arg(page);
-
-    if (!queryParts.isEmpty()) {
-        path += QStringLiteral("?") + queryParts.join(QLatin1String("&"));
-    }
+    path = ListQuery()
+               .search(search)
+               .sort(sortBy, sortDirection)
+               .page(page)
+               .path(path);
 
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
+    acceptCbor(request);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
-    }).then([=](JsonResponse response) {
+    auto future = makeDecodedRequest<PaginatedTeams>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
+    }, &paginatedTeamsFromJson, QStringLiteral("teams")).then([=](ApiResponse<PaginatedTeams> response) {
         if (response.success) {
-            PaginatedTeams paginatedTeams = paginatedTeamsFromJson(*response.data);
+            const PaginatedTeams &paginatedTeams = *response.data;
             Q_EMIT teamsReceived(paginatedTeams);
         } else {
             Q_EMIT errorTeamsReceived(response.error->message, response.error->status,
@@ -86,8 +80,8 @@ QFuture<void> TeamApi::getTeam(int id)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/teams/%1").arg(id));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &teamData = response.data->value("team"_L1).toObject();
@@ -114,8 +108,8 @@ QFuture<void> TeamApi::createTeam(const Team &team)
 
     QJsonObject jsonData = teamToJson(team);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &teamData = response.data->value("team"_L1).toObject();
@@ -141,8 +135,8 @@ QFuture<void> TeamApi::updateTeam(int id, const QVariantMap &team)
     Team teamDate = teamFromVariantMap(team);
     QJsonObject jsonData = teamToJson(teamDate);
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->put(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->put(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &teamData = response.data->value("team"_L1).toObject();
@@ -166,8 +160,8 @@ QFuture<void> TeamApi::deleteTeam(int id)
     request.setHeader(QNetworkRequest::ContentTypeHeader,QStringLiteral( "application/json"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT teamDeleted(id);
@@ -197,15 +191,12 @@ QFuture<void> TeamApi::uploadTeamImage(int teamId, const QString &imagePath)
     QNetworkRequest request = createRequest(path);
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
     QString boundary = QStringLiteral("boundary%1")
             .arg(QUuid::createUuid().toString(QUuid::WithoutBraces));
-    multiPart->setBoundary(boundary.toLatin1());
 
     QFile *file = new QFile(localPath);
     if (!file->open(QIODevice::ReadOnly)) {
         delete file;
-        delete multiPart;
         Q_EMIT uploadImageError("Failed to open image file"_L1);
         setLoading(false);
         return QtFuture::makeReadyVoidFuture();
@@ -223,13 +214,20 @@ QFuture<void> TeamApi::uploadTeamImage(int teamId, const QString &imagePath)
     delete file;
 
     imagePart.setBody(fileData);
-    multiPart->append(imagePart);
 
     request.setHeader(QNetworkRequest::ContentTypeHeader,
                       QStringLiteral("multipart/form-data; boundary=%1").arg(boundary));
-
-    auto future = makeRequest<QJsonObject>([=]() {
-        QNetworkReply* reply = m_netManager->post(request, multiPart);
+    // The multipart body is owned by the first reply
+    request.setAttribute(NoRetryAttribute, true);
+
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        // Built when the request is sent, on the network thread: a request
+        // that never is (open circuit, superseded while queued) leaves
+        // nothing behind
+        auto *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+        multiPart->setBoundary(boundary.toLatin1());
+        multiPart->append(imagePart);
+        QNetworkReply* reply = network->post(request, multiPart);
         multiPart->setParent(reply);
         return reply;
     }).then([=](JsonResponse response) {
@@ -255,8 +253,8 @@ QFuture<void> TeamApi::removeTeamImage(int teamId)
     request.setHeader(QNetworkRequest::ContentTypeHeader,QStringLiteral( "application/json"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->deleteResource(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return network->deleteResource(request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             Q_EMIT imageRemoved(teamId);
@@ -270,7 +268,7 @@ QFuture<void> TeamApi::removeTeamImage(int teamId)
     return future.then([=]() {});
 }
 
-Team TeamApi::teamFromJson(const QJsonObject &json) const
+Team TeamApi::teamFromJson(const QJsonObject &json)
 {
     Team team;
     team.id = json["id"_L1].toInt();
@@ -296,7 +294,7 @@ QJsonObject TeamApi::teamToJson(const Team &team) const
     return json;
 }
 
-PaginatedTeams TeamApi::paginatedTeamsFromJson(const QJsonObject &json) const
+PaginatedTeams TeamApi::paginatedTeamsFromJson(const QJsonObject &json)
 {
     PaginatedTeams result;
     const QJsonObject &meta = json["teams"_L1].toObject();
@@ -348,8 +346,8 @@ QFuture<void> TeamApi::getTeamLocale(int teamId)
     QNetworkRequest request = createRequest(QStringLiteral("/api/v1/teams/%1/language").arg(teamId));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             QString locale = response.data->value("language"_L1).toString();
@@ -376,8 +374,8 @@ QFuture<void> TeamApi::updateTeamLocale(int teamId, const QString &locale)
       QJsonObject jsonData;
       jsonData.insert(QStringLiteral("lang"), locale);  // Make sure to use "lang" as the key
 
-      auto future = makeRequest<QJsonObject>([=]() {
-          return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+      auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+          return network->post(request, QJsonDocument(jsonData).toJson());
       }).then([=](JsonResponse response) {
           if (response.success) {
               Q_EMIT localeUpdated(locale);
@@ -87,9 +87,9 @@ Q_SIGNALS:
     void localeError(const QString &message, ApiStatus status, const QByteArray &details);
 
 private:
-    Team teamFromJson(const QJsonObject &json) const;
+    static Team teamFromJson(const QJsonObject &json);
     QJsonObject teamToJson(const Team &team) const;
-    PaginatedTeams paginatedTeamsFromJson(const QJsonObject &json) const;
+    static PaginatedTeams paginatedTeamsFromJson(const QJsonObject &json);
     QVariantMap teamToVariantMap(const Team &team) const;
     Team teamFromVariantMap(const QVariantMap &map) const;
     QSettings m_settings;
@@ -1,4 +1,5 @@
 #include "userapi.h"
+#include "responsecache.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 
@@ -22,8 +23,8 @@ QFuture<void> UserApi::login(const QString &email, const QString &password, bool
     jsonData["email"_L1] = email;
     jsonData["password"_L1] = password;
 
-    auto future = makeRequest<QString>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QString>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](TokenResponse response) {
         if (response.success) {
             saveToken(response.data.value_or(QString()));
@@ -53,8 +54,8 @@ QFuture<void> UserApi::registerUser(const QString &name, const QString &email,
     jsonData["password"_L1] = password;
     jsonData["c_password"_L1] = confirmPassword;
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->post(request, QJsonDocument(jsonData).toJson());
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return network->post(request, QJsonDocument(jsonData).toJson());
     }).then([=](JsonResponse response) {
         if (response.success) {
             Q_EMIT registerSuccess();
@@ -72,11 +73,12 @@ QFuture<void> UserApi::logout() {
     QNetworkRequest request = createRequest(QStringLiteral( "/api/v1/logout"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<std::monostate>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<std::monostate>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](VoidResponse response) {
         if (response.success) {
             saveToken(QString{});
+            ResponseCache::instance()->setScope(QString());
             Q_EMIT logoutSuccess();
         } else {
             Q_EMIT logoutError(response.error->message);
@@ -92,14 +94,15 @@ QFuture<void> UserApi::getUserInfo() {
     QNetworkRequest request = createRequest(QStringLiteral( "/api/v1/user"));
     request.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
 
-    auto future = makeRequest<QJsonObject>([=]() {
-        return m_netManager->get(request);
+    auto future = makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+        return sendGet(network, request);
     }).then([=](JsonResponse response) {
         if (response.success) {
             const QJsonObject &userData = *response.data; // Dereference the optional
             m_user.name = userData["name"_L1].toString(); // Save the user's name
             m_user.email = userData["email"_L1].toString(); // Save the user's email
             m_user.team_id = userData["team_id"_L1].toInt();
+            ResponseCache::instance()->setScope(QString::number(m_user.team_id));
             Q_EMIT userInfoReceived(response.data.value());
         } else {
             Q_EMIT userInfoError(response.error->message,response.error->status);
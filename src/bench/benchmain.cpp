@@ -0,0 +1,69 @@
+// benchmain.cpp
+//
+//   ./dim_bench                          every suite, results on the console
+//   ./dim_bench ModelBench -iterations 5 one suite, QTest options as usual
+//   ./dim_bench -report results          also writes results/<Suite>.xml
+//
+// The report is QTest's XML: one BenchmarkResult per benchmark and data row
+// with its metric, value and iteration count, to keep and compare between
+// releases.
+#include "benchmain.h"
+#include <QCoreApplication>
+#include <QDir>
+#include <QLoggingCategory>
+#include <QTest>
+#include <map>
+#include <memory>
+
+namespace Bench {
+
+static std::map<QString, std::function<QObject *()>> &suites()
+{
+    static std::map<QString, std::function<QObject *()>> registered;
+    return registered;
+}
+
+bool registerSuite(const char *name, const std::function<QObject *()> &create)
+{
+    suites().emplace(QString::fromLatin1(name), create);
+    return true;
+}
+
+} // namespace Bench
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    // The models log every page they receive
+    QLoggingCategory::setFilterRules(QStringLiteral("default.debug=false"));
+
+    QStringList arguments = app.arguments();
+    const QString program = arguments.takeFirst();
+
+    QString reportDir;
+    const qsizetype report = arguments.indexOf(QStringLiteral("-report"));
+    if (report >= 0 && report + 1 < arguments.size()) {
+        reportDir = arguments.at(report + 1);
+        arguments.remove(report, 2);
+        QDir().mkpath(reportDir);
+    }
+
+    QStringList selected;
+    while (!arguments.isEmpty() && Bench::suites().count(arguments.first()))
+        selected.append(arguments.takeFirst());
+
+    int status = 0;
+    for (const auto &[name, create] : Bench::suites()) {
+        if (!selected.isEmpty() && !selected.contains(name))
+            continue;
+        QStringList suiteArguments{program};
+        suiteArguments.append(arguments);
+        if (!reportDir.isEmpty()) {
+            suiteArguments << QStringLiteral("-o") << QDir(reportDir).filePath(name + QStringLiteral(".xml,xml"))
+                           << QStringLiteral("-o") << QStringLiteral("-,txt");
+        }
+        const std::unique_ptr<QObject> suite(create());
+        status |= QTest::qExec(suite.get(), suiteArguments);
+    }
+    return status;
+}
@@ -0,0 +1,19 @@
+// benchmain.h
+#ifndef BENCHMAIN_H
+#define BENCHMAIN_H
+
+#include <QObject>
+#include <functional>
+
+// dim_bench runs several QTest suites from one binary. Each suite registers
+// itself with DIM_BENCH_SUITE(Class) at the end of its file.
+namespace Bench {
+
+bool registerSuite(const char *name, const std::function<QObject *()> &create);
+
+} // namespace Bench
+
+#define DIM_BENCH_SUITE(Class) \
+    static const bool Class##Registered = Bench::registerSuite(#Class, [] { return new Class(); });
+
+#endif // BENCHMAIN_H
@@ -0,0 +1,163 @@
+// circuitbreakertest.cpp
+//
+// The half-open probe of the CircuitBreaker always comes back: a probe that
+// is superseded or torn down with its API frees the host for the next
+// request, and one that never reports back is given up after its deadline.
+// The server accepts connections and never answers, so the probes stay on
+// the wire until the test lets go of them.
+//
+//   ./bin/dim_bench CircuitBreakerTest
+//
+#include "benchmain.h"
+#include "abstractapi.h"
+#include "circuitbreaker.h"
+#include "networkthread.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+#include <memory>
+
+using namespace NetworkApi;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+// Sends GETs in one slot, so each supersedes the one before
+class ProbeApi : public AbstractApi
+{
+public:
+    ProbeApi(QNetworkAccessManager *network, const QString &host)
+        : AbstractApi(network)
+    {
+        setApiHost(host);
+    }
+
+    QFuture<JsonResponse> search(const QString &query)
+    {
+        const QNetworkRequest request = createRequest(u"/api/v1/items?search=%1"_s.arg(query));
+        return makeRequest<QJsonObject>([=](QNetworkAccessManager *network) {
+            return sendGet(network, request);
+        }, u"items"_s);
+    }
+};
+
+void onNetworkThread(const std::function<void()> &work)
+{
+    QMetaObject::invokeMethod(NetworkThread::context(), work, Qt::BlockingQueuedConnection);
+}
+
+} // namespace
+
+class CircuitBreakerTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init()
+    {
+        m_requests = 0;
+        m_server = std::make_unique<QTcpServer>();
+        QVERIFY(m_server->listen(QHostAddress::LocalHost));
+        connect(m_server.get(), &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                    m_requests += int(socket->readAll().count("GET "));
+                });
+            }
+        });
+        m_host = u"http://127.0.0.1:%1"_s.arg(m_server->serverPort());
+        m_network = new QNetworkAccessManager();
+    }
+
+    void cleanup()
+    {
+        onNetworkThread([]() {
+            CircuitBreaker *breaker = CircuitBreaker::instance();
+            breaker->m_hosts.clear();
+            breaker->m_initialOpenTime = CircuitBreaker().m_initialOpenTime;
+            breaker->m_probeTimeout = CircuitBreaker().m_probeTimeout;
+        });
+        m_network->deleteLater();
+        m_server.reset();
+    }
+
+    // A newer search supersedes the probe: the next request is the probe
+    void supersededProbe()
+    {
+        openCircuit();
+        ProbeApi api(m_network, m_host);
+
+        api.search(u"a"_s);
+        QTRY_COMPARE(m_requests, 1);
+        QFuture<JsonResponse> next = api.search(u"ab"_s);
+        QTRY_COMPARE(m_requests, 2);
+        QVERIFY(!next.isFinished());
+    }
+
+    // An API destroyed with the probe on the wire gives it up
+    void probeTornDown()
+    {
+        openCircuit();
+        {
+            ProbeApi api(m_network, m_host);
+            api.search(u"a"_s);
+            QTRY_COMPARE(m_requests, 1);
+        }
+
+        ProbeApi api(m_network, m_host);
+        QFuture<JsonResponse> next = api.search(u"a"_s);
+        QTRY_COMPARE(m_requests, 2);
+        QVERIFY(!next.isFinished());
+    }
+
+    // A probe that is never heard of again only holds the host until its
+    // deadline
+    void probeDeadline()
+    {
+        openCircuit();
+        const QString host = CircuitBreaker::hostKey(QUrl(m_host));
+        bool probe = false;
+        bool whileProbing = true;
+        onNetworkThread([&]() {
+            CircuitBreaker *breaker = CircuitBreaker::instance();
+            breaker->m_probeTimeout = 50;
+            probe = breaker->allowRequest(host);
+            whileProbing = breaker->allowRequest(host);
+        });
+        QVERIFY(probe);
+        QVERIFY(!whileProbing);
+
+        QTest::qWait(100);
+        bool overdue = false;
+        onNetworkThread([&]() {
+            overdue = CircuitBreaker::instance()->allowRequest(host);
+        });
+        QVERIFY(overdue);
+    }
+
+private:
+    // Opens the circuit for the server, ready to let a probe through
+    void openCircuit()
+    {
+        const QString host = CircuitBreaker::hostKey(QUrl(m_host));
+        onNetworkThread([host]() {
+            CircuitBreaker::instance()->m_initialOpenTime = 0;
+            trip(host);
+        });
+    }
+
+    static void trip(const QString &host)
+    {
+        for (int failure = 0; failure < 5; ++failure)
+            CircuitBreaker::instance()->recordFailure(host);
+    }
+
+    std::unique_ptr<QTcpServer> m_server;
+    QString m_host;
+    QNetworkAccessManager *m_network = nullptr;
+    int m_requests = 0;
+};
+
+DIM_BENCH_SUITE(CircuitBreakerTest)
+
+#include "circuitbreakertest.moc"
@@ -0,0 +1,281 @@
+// entitydecodebench.cpp
+//
+// Decoding of the document endpoints (sales, invoices, purchases) whose rows
+// carry their line items, on pages of 20 documents with 10 to 1000 items
+// each: the QJsonDocument decoders of the API classes next to the field-table
+// decoders where they exist, and purchases read from CBOR.
+//
+//   ./bin/dim_bench EntityDecodeBench
+//
+#include "benchmain.h"
+#include "invoiceapi.h"
+#include "jsondecoders.h"
+#include "purchaseapi.h"
+#include "saleapi.h"
+#include <QCborMap>
+#include <QCborValue>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+
+using namespace NetworkApi;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+constexpr int DocumentsPerPage = 20;
+
+QString money(double value)
+{
+    return QString::number(value, 'f', 2);
+}
+
+// Sales and purchases share the item layout, amounts are decimal strings
+QJsonObject documentItem(int id)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"product_id"_L1, id % 500 + 1},
+        {"product_name"_L1, QStringLiteral("Product %1").arg(id % 500 + 1)},
+        {"quantity"_L1, id % 7 + 1},
+        {"unit_price"_L1, money(12.5 + id % 40)},
+        {"total_price"_L1, money((12.5 + id % 40) * (id % 7 + 1))},
+        {"tax_rate"_L1, money(20)},
+        {"tax_amount"_L1, money(2.5)},
+        {"discount_amount"_L1, money(0)},
+        {"notes"_L1, QJsonValue::Null},
+        {"is_package"_L1, id % 5 == 0},
+        {"package_id"_L1, id % 5 == 0 ? QJsonValue(id) : QJsonValue(QJsonValue::Null)},
+        {"total_pieces"_L1, id % 7 + 1},
+        {"product"_L1, QJsonObject{{"id"_L1, id % 500 + 1}, {"name"_L1, QStringLiteral("Product %1").arg(id % 500 + 1)}, {"sku"_L1, QStringLiteral("SKU%1").arg(id)}}},
+        {"created_at"_L1, "2025-01-10T09:12:44.000000Z"_L1},
+        {"updated_at"_L1, "2025-01-10T09:12:44.000000Z"_L1},
+    };
+}
+
+QJsonArray documentItems(int first, int count)
+{
+    QJsonArray items;
+    for (int i = 0; i < count; ++i)
+        items.append(documentItem(first + i));
+    return items;
+}
+
+QJsonObject sale(int id, int items)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 7},
+        {"client_id"_L1, id % 50 + 1},
+        {"cash_source_id"_L1, 1},
+        {"reference_number"_L1, QStringLiteral("SAL-%1").arg(id, 6, 10, QLatin1Char('0'))},
+        {"total_amount"_L1, money(1250.75 + id)},
+        {"paid_amount"_L1, money(1000)},
+        {"tax_amount"_L1, money(208.46)},
+        {"discount_amount"_L1, money(0)},
+        {"payment_status"_L1, "partial"_L1},
+        {"status"_L1, "completed"_L1},
+        {"type"_L1, "sale"_L1},
+        {"sale_date"_L1, "2025-02-03T17:40:02.000000Z"_L1},
+        {"due_date"_L1, "2025-03-03T00:00:00.000000Z"_L1},
+        {"created_at"_L1, "2025-02-03T17:40:02.000000Z"_L1},
+        {"notes"_L1, "Delivered to the back entrance"_L1},
+        {"client"_L1, QJsonObject{{"id"_L1, id % 50 + 1}, {"name"_L1, QStringLiteral("Client %1").arg(id % 50 + 1)}, {"email"_L1, "client@example.com"_L1}}},
+        {"items"_L1, documentItems(id * items, items)},
+    };
+}
+
+QJsonObject purchase(int id, int items)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 7},
+        {"supplier_id"_L1, id % 20 + 1},
+        {"cash_source_id"_L1, 1},
+        {"reference_number"_L1, QStringLiteral("PUR-%1").arg(id, 6, 10, QLatin1Char('0'))},
+        {"total_amount"_L1, money(980.10 + id)},
+        {"paid_amount"_L1, money(980.10 + id)},
+        {"payment_status"_L1, "paid"_L1},
+        {"status"_L1, "completed"_L1},
+        {"purchase_date"_L1, "2025-02-03T17:40:02.000000Z"_L1},
+        {"notes"_L1, QJsonValue::Null},
+        {"supplier"_L1, QJsonObject{{"id"_L1, id % 20 + 1}, {"name"_L1, QStringLiteral("Supplier %1").arg(id % 20 + 1)}}},
+        {"items"_L1, documentItems(id * items, items)},
+    };
+}
+
+QJsonObject invoice(int id, int items)
+{
+    QJsonArray lines;
+    for (int i = 0; i < items; ++i) {
+        lines.append(QJsonObject{
+            {"id"_L1, id * items + i},
+            {"description"_L1, QStringLiteral("Service line %1").arg(i + 1)},
+            {"quantity"_L1, i % 3 + 1},
+            {"unit_price"_L1, 45.0},
+            {"total_price"_L1, 45.0 * (i % 3 + 1)},
+            {"notes"_L1, QJsonValue::Null},
+        });
+    }
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 7},
+        {"reference_number"_L1, QStringLiteral("INV-%1").arg(id, 6, 10, QLatin1Char('0'))},
+        {"type"_L1, "invoice"_L1},
+        {"invoiceable_type"_L1, "App\\Models\\Sale"_L1},
+        {"invoiceable_id"_L1, id},
+        {"total_amount"_L1, money(540 + id)},
+        {"tax_amount"_L1, money(90)},
+        {"discount_amount"_L1, money(0)},
+        {"status"_L1, "sent"_L1},
+        {"payment_status"_L1, "unpaid"_L1},
+        {"is_email_sent"_L1, true},
+        {"issue_date"_L1, "2025-02-03T00:00:00.000000Z"_L1},
+        {"due_date"_L1, "2025-03-03T00:00:00.000000Z"_L1},
+        {"notes"_L1, QJsonValue::Null},
+        {"meta_data"_L1, QJsonObject{{"payment_terms"_L1, "30 days"_L1}}},
+        {"items"_L1, lines},
+    };
+}
+
+// {"<envelope>": {"data": [...], "current_page": 1, ...}}
+QByteArray page(const char *envelope, QJsonObject (*document)(int, int), int items)
+{
+    QJsonArray data;
+    for (int id = 1; id <= DocumentsPerPage; ++id)
+        data.append(document(id, items));
+    const QJsonObject paginated{
+        {"data"_L1, data},
+        {"current_page"_L1, 1},
+        {"last_page"_L1, 10},
+        {"per_page"_L1, DocumentsPerPage},
+        {"total"_L1, DocumentsPerPage * 10},
+    };
+    return QJsonDocument(QJsonObject{{QLatin1String(envelope), paginated}}).toJson(QJsonDocument::Compact);
+}
+
+template<typename Document>
+QList<Document> treeDecode(const QByteArray &body, QLatin1String envelope, Document (*fromJson)(const QJsonObject &))
+{
+    QList<Document> documents;
+    const QJsonArray data = QJsonDocument::fromJson(body).object()[envelope].toObject()["data"_L1].toArray();
+    for (const QJsonValue &value : data)
+        documents.append(fromJson(value.toObject()));
+    return documents;
+}
+
+} // namespace
+
+class EntityDecodeBench : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void saleFromJson_data() { itemCounts(); }
+    void saleFromJson()
+    {
+        QFETCH(int, items);
+        const QByteArray body = QJsonDocument(sale(1, items)).toJson(QJsonDocument::Compact);
+        QBENCHMARK {
+            const Sale decoded = SaleApi::saleFromJson(QJsonDocument::fromJson(body).object());
+            Q_UNUSED(decoded);
+        }
+    }
+
+    void salePageTree_data() { itemCounts(); }
+    void salePageTree()
+    {
+        QFETCH(int, items);
+        const QByteArray body = page("sales", sale, items);
+        QCOMPARE(int(treeDecode(body, "sales"_L1, SaleApi::saleFromJson).first().items.size()), items);
+        QBENCHMARK {
+            const QList<Sale> decoded = treeDecode(body, "sales"_L1, SaleApi::saleFromJson);
+            Q_UNUSED(decoded);
+        }
+    }
+
+    void salePageFieldTable_data() { itemCounts(); }
+    void salePageFieldTable()
+    {
+        QFETCH(int, items);
+        const QByteArray body = page("sales", sale, items);
+        QCOMPARE(int(decodePaginatedSales(body)->data.first().items.size()), items);
+        QBENCHMARK {
+            const std::optional<PaginatedSales> decoded = decodePaginatedSales(body);
+            Q_UNUSED(decoded);
+        }
+    }
+
+    void invoicePageTree_data() { itemCounts(); }
+    void invoicePageTree()
+    {
+        QFETCH(int, items);
+        const QByteArray body = page("invoices", invoice, items);
+        QCOMPARE(int(treeDecode(body, "invoices"_L1, InvoiceApi::invoiceFromJson).first().items.size()), items);
+        QBENCHMARK {
+            const QList<Invoice> decoded = treeDecode(body, "invoices"_L1, InvoiceApi::invoiceFromJson);
+            Q_UNUSED(decoded);
+        }
+    }
+
+    void invoicePageFieldTable_data() { itemCounts(); }
+    void invoicePageFieldTable()
+    {
+        QFETCH(int, items);
+        const QByteArray body = page("invoices", invoice, items);
+        QCOMPARE(int(decodePaginatedInvoices(body)->data.first().items.size()), items);
+        QBENCHMARK {
+            const std::optional<PaginatedInvoices> decoded = decodePaginatedInvoices(body);
+            Q_UNUSED(decoded);
+        }
+    }
+
+    // Purchases have no field-table decoder yet
+    void purchasePageTree_data() { itemCounts(); }
+    void purchasePageTree()
+    {
+        QFETCH(int, items);
+        const QByteArray body = page("purchases", purchase, items);
+        QBENCHMARK {
+            const PaginatedPurchases decoded = PurchaseApi::paginatedPurchasesFromJson(QJsonDocument::fromJson(body).object());
+            Q_UNUSED(decoded);
+        }
+    }
+
+    // The same page as application/cbor, through RawResponse::json() into
+    // the same decoder
+    void purchasePageCbor_data() { itemCounts(); }
+    void purchasePageCbor()
+    {
+        QFETCH(int, items);
+        const QByteArray json = page("purchases", purchase, items);
+        RawResponse raw;
+        raw.body = QCborValue::fromJsonValue(QJsonDocument::fromJson(json).object()).toCbor();
+        raw.cbor = true;
+        const PaginatedPurchases expected = PurchaseApi::paginatedPurchasesFromJson(QJsonDocument::fromJson(json).object());
+        const PaginatedPurchases fromCbor = PurchaseApi::paginatedPurchasesFromJson(raw.json());
+        QCOMPARE(fromCbor.data.size(), expected.data.size());
+        QCOMPARE(fromCbor.data.first().items.size(), expected.data.first().items.size());
+        QCOMPARE(fromCbor.data.first().total_amount, expected.data.first().total_amount);
+        QCOMPARE(fromCbor.total, expected.total);
+        QVERIFY(raw.body.size() < json.size());
+        QBENCHMARK {
+            const PaginatedPurchases decoded = PurchaseApi::paginatedPurchasesFromJson(QCborValue::fromCbor(raw.body).toMap().toJsonObject());
+            Q_UNUSED(decoded);
+        }
+    }
+
+private:
+    static void itemCounts()
+    {
+        QTest::addColumn<int>("items");
+        QTest::newRow("10 items") << 10;
+        QTest::newRow("100 items") << 100;
+        QTest::newRow("1000 items") << 1000;
+    }
+};
+
+DIM_BENCH_SUITE(EntityDecodeBench)
+
+#include "entitydecodebench.moc"
@@ -0,0 +1,258 @@
+// jsondecodebench.cpp
+//
+// Compares the tree-based page decoding (QJsonDocument + productFromJson) with
+// the field-table decoders in api/jsondecoders.h on a 1000-product page.
+//
+//   cmake -DDIM_BUILD_BENCHMARKS=ON ... && ./bin/dim_bench JsonDecodeBench
+//
+#include "benchmain.h"
+#include "jsondecoders.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTest>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+using namespace NetworkApi;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+// The product page as the backend sends it, including the members the client
+// never reads (timestamps, team, barcodes, ...)
+QByteArray productPage(int rows)
+{
+    QJsonArray data;
+    for (int i = 1; i <= rows; ++i) {
+        QJsonObject product{
+            {"id"_L1, i},
+            {"team_id"_L1, 7},
+            {"reference"_L1, QStringLiteral("REF-%1").arg(i, 6, 10, QLatin1Char('0'))},
+            {"name"_L1, QStringLiteral("Product \"%1\" été").arg(i)},
+            {"description"_L1, QStringLiteral("A fairly ordinary description for product number %1").arg(i)},
+            {"price"_L1, 1000 + i},
+            {"purchase_price"_L1, 800 + i},
+            {"expired_date"_L1, "2027-03-01T00:00:00.000000Z"_L1},
+            {"quantity"_L1, i % 50},
+            {"product_unit_id"_L1, 3},
+            {"sku"_L1, QStringLiteral("SKU%1").arg(i)},
+            {"min_stock_level"_L1, 5},
+            {"max_stock_level"_L1, 100},
+            {"reorder_point"_L1, 10},
+            {"location"_L1, "Aisle 4 / Shelf B"_L1},
+            {"image_path"_L1, QJsonValue::Null},
+            {"created_at"_L1, "2025-01-10T09:12:44.000000Z"_L1},
+            {"updated_at"_L1, "2025-02-03T17:40:02.000000Z"_L1},
+            {"deleted_at"_L1, QJsonValue::Null},
+            {"unit"_L1, QJsonObject{{"id"_L1, 3}, {"name"_L1, "piece"_L1}, {"team_id"_L1, 7}}},
+            {"barcodes"_L1, QJsonArray{QJsonObject{{"id"_L1, i}, {"barcode"_L1, QStringLiteral("61300%1").arg(i)}}}},
+            {"packages"_L1, QJsonArray{QJsonObject{{"id"_L1, i},
+                                                   {"name"_L1, "Box"_L1},
+                                                   {"pieces_per_package"_L1, 12},
+                                                   {"purchase_price"_L1, 90.5},
+                                                   {"selling_price"_L1, 120.25},
+                                                   {"barcode"_L1, QStringLiteral("99%1").arg(i)}}}},
+        };
+        data.append(product);
+    }
+
+    const QJsonObject page{
+        {"current_page"_L1, 1},
+        {"data"_L1, data},
+        {"first_page_url"_L1, "https://example.invalid/api/v1/products?page=1"_L1},
+        {"last_page"_L1, 3},
+        {"per_page"_L1, rows},
+        {"total"_L1, rows * 3},
+    };
+    return QJsonDocument(QJsonObject{{"products"_L1, page}}).toJson(QJsonDocument::Compact);
+}
+
+// Verbatim copy of the tree-based decoding the list endpoints used before
+Product productFromJson(const QJsonObject &json)
+{
+    Product product;
+    product.id = json["id"_L1].toInt();
+    product.reference = json["reference"_L1].toString();
+    product.name = json["name"_L1].toString();
+    product.description = json["description"_L1].toString();
+    product.price = json["price"_L1].toInt();
+    product.purchase_price = json["purchase_price"_L1].toInt();
+    product.expiredDate = QDateTime::fromString(json["expired_date"_L1].toString(), Qt::ISODate);
+    product.quantity = json["quantity"_L1].toInt();
+    product.productUnitId = json["product_unit_id"_L1].toInt();
+    product.sku = json["sku"_L1].toString();
+    product.minStockLevel = json["min_stock_level"_L1].toInt();
+    product.maxStockLevel = json["max_stock_level"_L1].toInt();
+    product.reorderPoint = json["reorder_point"_L1].toInt();
+    product.location = json["location"_L1].toString();
+    product.image_path = json["image_path"_L1].toString();
+    if (json.contains("unit"_L1)) {
+        const QJsonObject unit = json["unit"_L1].toObject();
+        product.unit.id = unit["id"_L1].toInt();
+        product.unit.name = unit["name"_L1].toString();
+    }
+    if (json.contains("packages"_L1) && json["packages"_L1].isArray()) {
+        const QJsonArray packagesArray = json["packages"_L1].toArray();
+        for (const QJsonValue &value : packagesArray) {
+            QJsonObject packageObj = value.toObject();
+            ProductPackageProduct package;
+            package.id = packageObj["id"_L1].toInt();
+            package.name = packageObj["name"_L1].toString();
+            package.pieces_per_package = packageObj["pieces_per_package"_L1].toInt();
+            package.purchase_price = packageObj["purchase_price"_L1].toDouble();
+            package.selling_price = packageObj["selling_price"_L1].toDouble();
+            package.barcode = packageObj["barcode"_L1].toString();
+            product.packages.append(package);
+        }
+    }
+    return product;
+}
+
+PaginatedProducts treeDecode(const QByteArray &body)
+{
+    const QJsonObject json = QJsonDocument::fromJson(body).object();
+    PaginatedProducts result;
+    const QJsonObject &meta = json["products"_L1].toObject();
+    result.currentPage = meta["current_page"_L1].toInt();
+    result.lastPage = meta["last_page"_L1].toInt();
+    result.perPage = meta["per_page"_L1].toInt();
+    result.total = meta["total"_L1].toInt();
+
+    const QJsonArray &dataArray = meta["data"_L1].toArray();
+    for (const QJsonValue &value : dataArray) {
+        result.data.append(productFromJson(value.toObject()));
+    }
+    return result;
+}
+
+#ifdef __GLIBC__
+size_t heapInUse()
+{
+    return mallinfo2().uordblks;
+}
+#endif
+
+} // namespace
+
+class JsonDecodeBench : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_page = productPage(1000);
+        qInfo() << "page size:" << m_page.size() << "bytes";
+    }
+
+    void decodersAgree()
+    {
+        const PaginatedProducts expected = treeDecode(m_page);
+        const std::optional<PaginatedProducts> actual = decodePaginatedProducts(m_page);
+        QVERIFY(actual);
+        QCOMPARE(actual->currentPage, expected.currentPage);
+        QCOMPARE(actual->lastPage, expected.lastPage);
+        QCOMPARE(actual->perPage, expected.perPage);
+        QCOMPARE(actual->total, expected.total);
+        QCOMPARE(actual->data.size(), expected.data.size());
+        for (qsizetype i = 0; i < expected.data.size(); ++i) {
+            const Product &a = actual->data.at(i);
+            const Product &e = expected.data.at(i);
+            QCOMPARE(a.id, e.id);
+            QCOMPARE(a.reference, e.reference);
+            QCOMPARE(a.name, e.name);
+            QCOMPARE(a.description, e.description);
+            QCOMPARE(a.price, e.price);
+            QCOMPARE(a.purchase_price, e.purchase_price);
+            QCOMPARE(a.expiredDate, e.expiredDate);
+            QCOMPARE(a.quantity, e.quantity);
+            QCOMPARE(a.productUnitId, e.productUnitId);
+            QCOMPARE(a.sku, e.sku);
+            QCOMPARE(a.minStockLevel, e.minStockLevel);
+            QCOMPARE(a.maxStockLevel, e.maxStockLevel);
+            QCOMPARE(a.reorderPoint, e.reorderPoint);
+            QCOMPARE(a.location, e.location);
+            QCOMPARE(a.image_path, e.image_path);
+            QCOMPARE(a.unit.id, e.unit.id);
+            QCOMPARE(a.unit.name, e.unit.name);
+            QCOMPARE(a.packages.size(), e.packages.size());
+            QCOMPARE(a.packages.first().selling_price, e.packages.first().selling_price);
+            QCOMPARE(a.packages.first().barcode, e.packages.first().barcode);
+        }
+    }
+
+    void errorPayloadsAreRejected()
+    {
+        QVERIFY(!decodePaginatedProducts(R"({"error":true,"message":"nope"})"));
+        QVERIFY(!decodePaginatedProducts(R"({"message":"invalid","errors":{"page":["bad"]}})"));
+        QVERIFY(!decodePaginatedProducts(R"({"products":{"data":[{"id":1)"));
+        QVERIFY(decodePaginatedProducts(R"({"error":false,"products":{"data":[]}})"));
+        // Escapes QJsonDocument rejects as well
+        QVERIFY(!decodePaginatedProducts(R"({"products":{"data":[{"id":1,"name":"\u12zz"}]}})"));
+        QVERIFY(!decodePaginatedProducts(R"({"products":{"data":[{"id":1,"name":"\u12"}]}})"));
+        QVERIFY(!decodePaginatedProducts(R"({"products":{"data":[{"id":1,"name":"\x41"}]}})"));
+        // Cut off right after a backslash: nothing is read past the end
+        QVERIFY(!decodePaginatedProducts(R"({"products":{"data":[{"id":1,"name":"ab\)"));
+    }
+
+    // Escaped strings read as QJsonDocument reads them, surrogate pairs
+    // included
+    void escapedStrings()
+    {
+        const QByteArray body = R"({"products":{"data":[{"id":1,"name":"a\"b\\\/\n\u00e9\ud83d\ude00\u20AC"}]}})";
+        const std::optional<PaginatedProducts> actual = decodePaginatedProducts(body);
+        QVERIFY(actual);
+        QCOMPARE(actual->data.size(), 1);
+        QCOMPARE(actual->data.first().name, treeDecode(body).data.first().name);
+        QCOMPARE(actual->data.first().name, u"a\"b\\/\n\u00e9\U0001F600\u20ac"_s);
+    }
+
+    void treeDecoder()
+    {
+        QBENCHMARK {
+            const PaginatedProducts page = treeDecode(m_page);
+            Q_UNUSED(page);
+        }
+    }
+
+    void fieldTableDecoder()
+    {
+        QBENCHMARK {
+            const std::optional<PaginatedProducts> page = decodePaginatedProducts(m_page);
+            Q_UNUSED(page);
+        }
+    }
+
+#ifdef __GLIBC__
+    // Heap held at the point where the decoded page exists: the tree decoder
+    // still owns the whole document there, the field-table decoder only the
+    // structs themselves.
+    void peakHeap()
+    {
+        const size_t before = heapInUse();
+        size_t tree = 0;
+        {
+            const QJsonDocument document = QJsonDocument::fromJson(m_page);
+            const size_t parsed = heapInUse();
+            const PaginatedProducts page = treeDecode(m_page);
+            tree = parsed - before + (heapInUse() - parsed);
+        }
+        size_t streamed = 0;
+        {
+            const std::optional<PaginatedProducts> page = decodePaginatedProducts(m_page);
+            streamed = heapInUse() - before;
+        }
+        qInfo() << "heap held by tree decode:" << tree << "bytes, field tables:" << streamed << "bytes";
+        QVERIFY(streamed < tree);
+    }
+#endif
+
+private:
+    QByteArray m_page;
+};
+
+DIM_BENCH_SUITE(JsonDecodeBench)
+
+#include "jsondecodebench.moc"
@@ -0,0 +1,175 @@
+// modelbench.cpp
+//
+// What the product models cost on the GUI thread once a page has been
+// decoded: replacing the table (ProductModel), growing the infinite scroll
+// list (ProductModelFetch), answering data() for each role the views bind and
+// checking every row at once.
+//
+//   ./bin/dim_bench ModelBench
+//
+#include "benchmain.h"
+#include "productmodel.h"
+#include "productmodelFetch.h"
+#include <QTest>
+#include <algorithm>
+#include <memory>
+
+using namespace NetworkApi;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+constexpr int RowsPerPage = 100;
+
+// The page handlers are what ProductApi::productsReceived is connected to
+class BenchProductModel : public ProductModel
+{
+public:
+    using ProductModel::handleProductsReceived;
+};
+
+class BenchProductModelFetch : public ProductModelFetch
+{
+public:
+    using ProductModelFetch::handleProductsReceived;
+};
+
+Product product(int id)
+{
+    Product product;
+    product.id = id;
+    product.reference = QStringLiteral("REF-%1").arg(id, 6, 10, QLatin1Char('0'));
+    product.name = QStringLiteral("Product %1").arg(id);
+    product.description = QStringLiteral("A fairly ordinary description for product number %1").arg(id);
+    product.price = 1000 + id;
+    product.purchase_price = 800 + id;
+    product.expiredDate = QDateTime(QDate(2027, 3, 1), QTime(0, 0));
+    product.quantity = id % 50;
+    product.productUnitId = 3;
+    product.sku = QStringLiteral("SKU%1").arg(id);
+    product.barcode = QStringLiteral("61300%1").arg(id);
+    product.minStockLevel = 5;
+    product.maxStockLevel = 100;
+    product.reorderPoint = 10;
+    product.location = QStringLiteral("Aisle 4 / Shelf B");
+    product.unit = ProductUnit{3, QStringLiteral("piece")};
+    product.packages = {ProductPackageProduct{id, QStringLiteral("Box"), 12, 90.5, 120.25, QStringLiteral("99%1").arg(id)}};
+    return product;
+}
+
+PaginatedProducts page(int first, int rows, int currentPage, int total)
+{
+    PaginatedProducts page;
+    page.data.reserve(rows);
+    for (int id = first; id < first + rows; ++id)
+        page.data.append(product(id));
+    page.currentPage = currentPage;
+    page.perPage = rows;
+    page.total = total;
+    page.lastPage = std::max(1, (total + RowsPerPage - 1) / RowsPerPage);
+    return page;
+}
+
+} // namespace
+
+class ModelBench : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        m_model = std::make_unique<BenchProductModel>();
+        m_model->handleProductsReceived(page(1, 10000, 1, 10000));
+    }
+
+    // One page holding every row, as the table view receives it; after the
+    // first round the same rows again, so this is the keyed diff of a refresh
+    // where nothing changed
+    void productModelReset_data() { rowCounts(); }
+    void productModelReset()
+    {
+        QFETCH(int, rows);
+        const PaginatedProducts products = page(1, rows, 1, rows);
+        BenchProductModel model;
+        QBENCHMARK {
+            model.handleProductsReceived(products);
+        }
+        QCOMPARE(model.rowCount(), rows);
+    }
+
+    // Page 1 resets, every further page of 100 is appended
+    void productModelFetchAppend_data() { rowCounts(); }
+    void productModelFetchAppend()
+    {
+        QFETCH(int, rows);
+        QList<PaginatedProducts> pages;
+        for (int first = 1; first <= rows; first += RowsPerPage)
+            pages.append(page(first, std::min(RowsPerPage, rows - first + 1), int(pages.size()) + 1, rows));
+
+        BenchProductModelFetch model;
+        QBENCHMARK {
+            for (const PaginatedProducts &products : std::as_const(pages))
+                model.handleProductsReceived(products);
+        }
+        QCOMPARE(model.rowCount(), rows);
+    }
+
+    // "Select all" then "clear" over the fetched rows, each one ranged
+    // dataChanged
+    void toggleAllChecked_data() { rowCounts(); }
+    void toggleAllChecked()
+    {
+        QFETCH(int, rows);
+        BenchProductModelFetch model;
+        model.handleProductsReceived(page(1, rows, 1, rows));
+        QBENCHMARK {
+            model.toggleAllProductsChecked();
+            model.toggleAllProductsChecked();
+        }
+        QVERIFY(!model.hasCheckedItems());
+    }
+
+    // Every row read once for the role, as a delegate binding it would
+    void dataPerRole_data()
+    {
+        QTest::addColumn<int>("role");
+        const QHash<int, QByteArray> roles = m_model->roleNames();
+        QList<int> sorted = roles.keys();
+        std::sort(sorted.begin(), sorted.end());
+        for (int role : std::as_const(sorted))
+            QTest::newRow(roles.value(role).constData()) << role;
+    }
+    void dataPerRole()
+    {
+        QFETCH(int, role);
+        const int rows = m_model->rowCount();
+        QBENCHMARK {
+            for (int row = 0; row < rows; ++row) {
+                const QVariant value = m_model->data(m_model->index(row, 0), role);
+                Q_UNUSED(value);
+            }
+        }
+    }
+
+    void cleanupTestCase()
+    {
+        m_model.reset();
+    }
+
+private:
+    static void rowCounts()
+    {
+        QTest::addColumn<int>("rows");
+        QTest::newRow("100 rows") << 100;
+        QTest::newRow("1k rows") << 1000;
+        QTest::newRow("10k rows") << 10000;
+        QTest::newRow("100k rows") << 100000;
+    }
+
+    std::unique_ptr<BenchProductModel> m_model;
+};
+
+DIM_BENCH_SUITE(ModelBench)
+
+#include "modelbench.moc"
@@ -0,0 +1,255 @@
+// rowdifftest.cpp
+//
+// What RowDiff tells the views when a refreshed page replaces the rows of an
+// entity model: removals, insertions and moves as such, only the roles that
+// changed, a reset for another sort or a page with an id twice, and checked
+// rows that stay checked through all of it. QAbstractItemModelTester checks
+// every signal against the model's state as it goes.
+//
+//   ./bin/dim_bench RowDiffTest
+//
+#include "benchmain.h"
+#include "paginatedentitymodel.h"
+#include <QAbstractItemModelTester>
+#include <QSignalSpy>
+#include <QTest>
+#include <memory>
+
+using namespace NetworkApi;
+using namespace Qt::StringLiterals;
+
+namespace {
+
+struct Item {
+    int id = 0;
+    QString name;
+};
+
+struct ItemPage {
+    QList<Item> data;
+    int total = 0;
+    int currentPage = 1;
+    int lastPage = 1;
+};
+
+enum ItemRoles {
+    IdRole = Qt::UserRole + 1,
+    NameRole,
+    CheckedRole,
+};
+
+using namespace ModelFields;
+
+constexpr ModelRole<Item> ItemRoleTable[] = {
+    memberRole<&Item::id>(IdRole, "id"),
+    memberRole<&Item::name>(NameRole, "name"),
+};
+
+constexpr ModelColumn<Item> ItemColumns[] = {
+    memberColumn<&Item::id>("ID"),
+    memberColumn<&Item::name>("Name"),
+};
+
+class ItemModel : public PaginatedEntityModel<Item>
+{
+public:
+    ItemModel()
+        : PaginatedEntityModel<Item>(ItemRoleTable, ItemColumns, CheckedRole,
+                                     QStringLiteral("name"), QStringLiteral("asc"), nullptr)
+    {
+    }
+
+    void refresh() override {}
+
+    // A table page holding the rows with these ids, named after them
+    void receive(const QList<int> &ids, const QString &suffix = QString())
+    {
+        ItemPage page;
+        for (int id : ids)
+            page.data.append(Item{id, QStringLiteral("Item %1%2").arg(id).arg(suffix)});
+        page.total = int(ids.size());
+        receivePage(page);
+    }
+
+    QList<int> ids() const
+    {
+        QList<int> ids;
+        for (const Item &row : m_rows)
+            ids.append(row.id);
+        return ids;
+    }
+};
+
+QList<int> checkedIds(const ItemModel &model)
+{
+    QList<int> ids;
+    for (const QVariant &id : model.checkedIds())
+        ids.append(id.toInt());
+    return ids;
+}
+
+} // namespace
+
+class RowDiffTest : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init()
+    {
+        m_model = std::make_unique<ItemModel>();
+        m_tester = std::make_unique<QAbstractItemModelTester>(m_model.get(),
+                                                              QAbstractItemModelTester::FailureReportingMode::QtTest);
+        m_model->receive({1, 2, 3, 4, 5, 6, 7, 8});
+
+        m_reset = std::make_unique<QSignalSpy>(m_model.get(), &QAbstractItemModel::modelReset);
+        m_removed = std::make_unique<QSignalSpy>(m_model.get(), &QAbstractItemModel::rowsRemoved);
+        m_inserted = std::make_unique<QSignalSpy>(m_model.get(), &QAbstractItemModel::rowsInserted);
+        m_moved = std::make_unique<QSignalSpy>(m_model.get(), &QAbstractItemModel::rowsMoved);
+        m_changed = std::make_unique<QSignalSpy>(m_model.get(), &QAbstractItemModel::dataChanged);
+    }
+
+    void cleanup()
+    {
+        m_reset.reset();
+        m_removed.reset();
+        m_inserted.reset();
+        m_moved.reset();
+        m_changed.reset();
+        m_tester.reset();
+        m_model.reset();
+    }
+
+    // The same page again tells the views nothing
+    void unchangedPage()
+    {
+        m_model->receive({1, 2, 3, 4, 5, 6, 7, 8});
+        QCOMPARE(m_model->ids(), QList<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+        QCOMPARE(signalCount(), 0);
+    }
+
+    // Two runs of removed rows, each one rowsRemoved
+    void remove()
+    {
+        m_model->setChecked(4, true);
+        m_model->receive({1, 2, 5, 6, 8});
+
+        QCOMPARE(m_model->ids(), QList<int>({1, 2, 5, 6, 8}));
+        QCOMPARE(m_removed->count(), 2);
+        QCOMPARE(m_removed->at(0).at(1).toInt(), 6);
+        QCOMPARE(m_removed->at(0).at(2).toInt(), 6);
+        QCOMPARE(m_removed->at(1).at(1).toInt(), 2);
+        QCOMPARE(m_removed->at(1).at(2).toInt(), 3);
+        QCOMPARE(m_reset->count(), 0);
+        QCOMPARE(m_inserted->count(), 0);
+        QCOMPARE(checkedIds(*m_model), QList<int>({5}));
+    }
+
+    // A run of new rows is one rowsInserted, and comes in unchecked
+    void insert()
+    {
+        m_model->setChecked(2, true);
+        m_model->receive({1, 2, 10, 11, 3, 4, 5, 6, 7, 8, 12});
+
+        QCOMPARE(m_model->ids(), QList<int>({1, 2, 10, 11, 3, 4, 5, 6, 7, 8, 12}));
+        QCOMPARE(m_inserted->count(), 2);
+        QCOMPARE(m_inserted->at(0).at(1).toInt(), 2);
+        QCOMPARE(m_inserted->at(0).at(2).toInt(), 3);
+        QCOMPARE(m_inserted->at(1).at(1).toInt(), 10);
+        QCOMPARE(m_inserted->at(1).at(2).toInt(), 10);
+        QCOMPARE(m_reset->count(), 0);
+        QCOMPARE(m_removed->count(), 0);
+        QCOMPARE(checkedIds(*m_model), QList<int>({3}));
+    }
+
+    // A row that changed place is moved, and its check moves with it
+    void move()
+    {
+        m_model->setChecked(6, true);
+        m_model->setChecked(1, true);
+        m_model->receive({1, 2, 3, 4, 5, 6, 8, 7});
+
+        QCOMPARE(m_model->ids(), QList<int>({1, 2, 3, 4, 5, 6, 8, 7}));
+        QCOMPARE(m_moved->count(), 1);
+        QCOMPARE(m_moved->at(0).at(1).toInt(), 7);
+        QCOMPARE(m_moved->at(0).at(4).toInt(), 6);
+        QCOMPARE(m_reset->count(), 0);
+        QCOMPARE(checkedIds(*m_model), QList<int>({2, 7}));
+        QVERIFY(m_model->data(m_model->index(7, 0), CheckedRole).toBool());
+        QVERIFY(!m_model->data(m_model->index(6, 0), CheckedRole).toBool());
+    }
+
+    // Removed, inserted and moved rows in one refresh
+    void mixed()
+    {
+        m_model->setChecked(7, true);
+        m_model->receive({1, 8, 2, 9, 3, 4, 5, 6});
+
+        QCOMPARE(m_model->ids(), QList<int>({1, 8, 2, 9, 3, 4, 5, 6}));
+        QCOMPARE(m_reset->count(), 0);
+        QCOMPARE(m_removed->count(), 1);
+        QCOMPARE(m_moved->count(), 1);
+        QCOMPARE(m_inserted->count(), 1);
+        QCOMPARE(checkedIds(*m_model), QList<int>({8}));
+        QCOMPARE(m_model->data(m_model->index(1, 0), NameRole).toString(), u"Item 8"_s);
+    }
+
+    // Another sort would take many moves: one reset, which clears the checks
+    void reorder()
+    {
+        m_model->setChecked(0, true);
+        m_model->receive({8, 7, 6, 5, 4, 3, 2, 1});
+
+        QCOMPARE(m_model->ids(), QList<int>({8, 7, 6, 5, 4, 3, 2, 1}));
+        QCOMPARE(m_reset->count(), 1);
+        QCOMPARE(m_moved->count(), 0);
+        QVERIFY(!m_model->hasCheckedItems());
+    }
+
+    // Pages that overlapped while appending: the page is shown as received
+    void duplicateIds()
+    {
+        m_model->receive({1, 2, 2, 3});
+
+        QCOMPARE(m_model->ids(), QList<int>({1, 2, 2, 3}));
+        QCOMPARE(m_reset->count(), 1);
+        QCOMPARE(m_removed->count(), 0);
+    }
+
+    // Rows that stayed report the roles that changed, and DisplayRole for
+    // the table columns, across the whole row
+    void changedRoles()
+    {
+        m_model->receive({1, 2, 3, 4, 5, 6, 7, 8}, u"*"_s);
+
+        QCOMPARE(m_changed->count(), 8);
+        const QModelIndex topLeft = m_changed->at(2).at(0).value<QModelIndex>();
+        const QModelIndex bottomRight = m_changed->at(2).at(1).value<QModelIndex>();
+        const QList<int> roles = m_changed->at(2).at(2).value<QList<int>>();
+        QCOMPARE(topLeft.row(), 2);
+        QCOMPARE(bottomRight.row(), 2);
+        QCOMPARE(bottomRight.column(), m_model->columnCount() - 1);
+        QVERIFY(roles.contains(NameRole));
+        QVERIFY(roles.contains(Qt::DisplayRole));
+        QVERIFY(!roles.contains(IdRole));
+        QCOMPARE(m_reset->count() + m_removed->count() + m_inserted->count() + m_moved->count(), 0);
+    }
+
+private:
+    int signalCount() const
+    {
+        return int(m_reset->count() + m_removed->count() + m_inserted->count() + m_moved->count() + m_changed->count());
+    }
+
+    std::unique_ptr<ItemModel> m_model;
+    std::unique_ptr<QAbstractItemModelTester> m_tester;
+    std::unique_ptr<QSignalSpy> m_reset;
+    std::unique_ptr<QSignalSpy> m_removed;
+    std::unique_ptr<QSignalSpy> m_inserted;
+    std::unique_ptr<QSignalSpy> m_moved;
+    std::unique_ptr<QSignalSpy> m_changed;
+};
+
+DIM_BENCH_SUITE(RowDiffTest)
+
+#include "rowdifftest.moc"
@@ -33,6 +33,10 @@
 #include <api/cashtransactionapi.h>
 #include <api/dashboardanalyticsapi.h>
 #include <api/teamapi.h>
+#include <api/apimetrics.h>
+#include <api/apitransport.h>
+#include <api/apitrace.h>
+#include <api/networkthread.h>
 
 
 #include <model/productmodel.h>
@@ -102,7 +106,16 @@ int main(int argc, char *argv[])
     // Expose the updater to QML
     engine.rootContext()->setContextProperty(QStringLiteral("appUpdater"), appUpdater);
 
-    QNetworkAccessManager *networkManager = new QNetworkAccessManager();
+    // DIM_TRACE_REPLAY answers the API from a recorded trace, see ApiTrace
+    NetworkApi::ApiTrace *apiTrace = NetworkApi::ApiTrace::instance();
+    QNetworkAccessManager *networkManager = apiTrace->isReplaying() ? apiTrace->createReplayManager()
+                                                                     : new QNetworkAccessManager();
+    // Replies are received and processed off the GUI thread
+    NetworkApi::NetworkThread::adopt(networkManager);
+    // Open the API connection while the UI is still loading
+    NetworkApi::ApiTransport::instance()->attach(networkManager);
+    if (!apiTrace->isReplaying())
+        NetworkApi::ApiTransport::instance()->prewarm(QUrl(QStringLiteral(DIM_API_BASE_URL)));
     NetworkApi::UserApi *userapi = new NetworkApi::UserApi(networkManager);
     NetworkApi::TeamApi *teamApi = new NetworkApi::TeamApi(networkManager);
 
@@ -121,6 +134,8 @@ int main(int argc, char *argv[])
 
     engine.rootContext()->setContextProperty(QStringLiteral("productApi"), productApi);
     engine.rootContext()->setContextProperty(QStringLiteral("teamApi"), teamApi);
+    // Per-endpoint request statistics, see ApiMetrics::dumpToFile()
+    engine.rootContext()->setContextProperty(QStringLiteral("apiMetrics"), NetworkApi::ApiMetrics::instance());
 
     NetworkApi::ActivityLogApi *activityLogApi = new NetworkApi::ActivityLogApi(networkManager);
     NetworkApi::SupplierApi *supplierApi = new NetworkApi::SupplierApi(networkManager);
@@ -0,0 +1,61 @@
+// main.cpp
+// Local stand-in for the DIM API, for offline development and for
+// reproducible measurements of the client. Build the app with APP_ENV=dev
+// (http://localhost:8000) and run, for example:
+//
+//   dim_mock_server --products 100000 --latency 80 --jitter 40 --bandwidth 256
+#include "mockserver.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QHostAddress>
+
+using namespace Qt::StringLiterals;
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName(QStringLiteral("dim_mock_server"));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Serves the DIM /api/v1 routes from synthetic data or fixtures."));
+    parser.addHelpOption();
+    const QCommandLineOption port(QStringLiteral("port"), QStringLiteral("Port to listen on."), QStringLiteral("port"), QStringLiteral("8000"));
+    const QCommandLineOption latency(QStringLiteral("latency"), QStringLiteral("Delay before every response, in ms."), QStringLiteral("ms"), QStringLiteral("0"));
+    const QCommandLineOption jitter(QStringLiteral("jitter"), QStringLiteral("Random extra delay of up to this many ms."), QStringLiteral("ms"), QStringLiteral("0"));
+    const QCommandLineOption bandwidth(QStringLiteral("bandwidth"), QStringLiteral("Throughput cap per connection, in KiB/s (0: none)."),
+                                       QStringLiteral("kib"), QStringLiteral("0"));
+    const QCommandLineOption errorRate(QStringLiteral("error-rate"), QStringLiteral("Share of requests that fail, 0 to 1."), QStringLiteral("rate"), QStringLiteral("0"));
+    const QCommandLineOption errorStatus(QStringLiteral("error-status"),
+                                         QStringLiteral("Status of injected failures; 0 drops the connection instead."),
+                                         QStringLiteral("status"), QStringLiteral("503"));
+    const QCommandLineOption products(QStringLiteral("products"), QStringLiteral("Number of products in the dataset."), QStringLiteral("n"), QStringLiteral("1000"));
+    const QCommandLineOption records(QStringLiteral("records"), QStringLiteral("Number of rows in every other collection."), QStringLiteral("n"), QStringLiteral("200"));
+    const QCommandLineOption fixtures(QStringLiteral("fixtures"),
+                                      QStringLiteral("Directory of recorded responses, <dir>/<METHOD>/api/v1/<path>.json."),
+                                      QStringLiteral("dir"));
+    const QCommandLineOption noCompression(QStringLiteral("no-compression"), QStringLiteral("Never deflate response bodies."));
+    parser.addOptions({port, latency, jitter, bandwidth, errorRate, errorStatus, products, records, fixtures,
+                       noCompression});
+    parser.process(app);
+
+    MockApi::MockServer::Options options;
+    options.latencyMs = parser.value(latency).toInt();
+    options.jitterMs = parser.value(jitter).toInt();
+    options.bandwidth = parser.value(bandwidth).toInt() * 1024;
+    options.errorRate = qBound(0.0, parser.value(errorRate).toDouble(), 1.0);
+    options.errorStatus = parser.value(errorStatus).toInt();
+    options.compress = !parser.isSet(noCompression);
+    options.fixtures = parser.value(fixtures);
+
+    MockApi::MockDataset::Sizes sizes;
+    sizes.products = qMax(0, parser.value(products).toInt());
+    sizes.records = qMax(0, parser.value(records).toInt());
+
+    MockApi::MockServer server(options, sizes);
+    if (!server.listen(QHostAddress::LocalHost, quint16(parser.value(port).toUInt())))
+        return 1;
+    qInfo().noquote() << QStringLiteral("Mock API on http://localhost:%1 with %2 products").arg(server.port()).arg(sizes.products);
+
+    return app.exec();
+}
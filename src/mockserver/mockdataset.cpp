@@ -0,0 +1,845 @@
+// mockdataset.cpp
+#include "mockdataset.h"
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <algorithm>
+#include <functional>
+
+using namespace Qt::StringLiterals;
+
+namespace MockApi {
+
+// Fixed dates keep the bodies, and with them the ETags, stable across runs
+static const QString CreatedAt = QStringLiteral("2025-01-10T09:12:44.000000Z");
+static const QString UpdatedAt = QStringLiteral("2025-02-03T17:40:02.000000Z");
+
+static QString money(double amount)
+{
+    // The API serialises decimals as strings
+    return QString::number(amount, 'f', 2);
+}
+
+static QString dateFor(int id)
+{
+    return QDate(2025, 1, 1).addDays(id % 365).toString(Qt::ISODate);
+}
+
+QByteArray MockRequest::header(QByteArrayView name) const
+{
+    for (const auto &header : headers) {
+        if (name.compare(header.first, Qt::CaseInsensitive) == 0)
+            return header.second;
+    }
+    return {};
+}
+
+MockResponse MockResponse::json(const QJsonObject &object, int status)
+{
+    MockResponse response;
+    response.status = status;
+    response.body = QJsonDocument(object).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+MockResponse MockResponse::message(int status, const QString &message)
+{
+    return json(QJsonObject{{"message"_L1, message}}, status);
+}
+
+MockDataset::MockDataset(const Sizes &sizes)
+{
+    const int products = sizes.products;
+    auto add = [this](const QString &segment, const QString &plural, const QString &singular, int count,
+                      std::function<QJsonObject(int)> generate, std::function<QString(int)> name) {
+        Collection collection;
+        collection.plural = plural;
+        collection.singular = singular;
+        collection.count = count;
+        collection.nextId = count + 1;
+        collection.generate = std::move(generate);
+        collection.name = std::move(name);
+        m_collections.insert(segment, collection);
+    };
+
+    add(QStringLiteral("products"), QStringLiteral("products"), QStringLiteral("product"), products, &MockDataset::product,
+        [](int id) { return QStringLiteral("Product %1 REF-%2").arg(id).arg(id, 6, 10, '0'_L1); });
+    add(QStringLiteral("clients"), QStringLiteral("clients"), QStringLiteral("client"), sizes.records, &MockDataset::client,
+        [](int id) { return QStringLiteral("Client %1").arg(id); });
+    add(QStringLiteral("suppliers"), QStringLiteral("suppliers"), QStringLiteral("supplier"), sizes.records, &MockDataset::supplier,
+        [](int id) { return QStringLiteral("Supplier %1").arg(id); });
+    add(QStringLiteral("sales"), QStringLiteral("sales"), QStringLiteral("sale"), sizes.records, [products](int id) { return sale(id, products); },
+        [](int id) { return QStringLiteral("SAL-%1").arg(id, 6, 10, '0'_L1); });
+    add(QStringLiteral("purchases"), QStringLiteral("purchases"), QStringLiteral("purchase"), sizes.records,
+        [products](int id) { return purchase(id, products); },
+        [](int id) { return QStringLiteral("PUR-%1").arg(id, 6, 10, '0'_L1); });
+    add(QStringLiteral("invoices"), QStringLiteral("invoices"), QStringLiteral("invoice"), sizes.records, &MockDataset::invoice,
+        [](int id) { return QStringLiteral("INV-%1").arg(id, 6, 10, '0'_L1); });
+    add(QStringLiteral("cash-sources"), QStringLiteral("cash_sources"), QStringLiteral("cash_source"), qMin(sizes.records, 12), &MockDataset::cashSource,
+        [](int id) { return QStringLiteral("Register %1").arg(id); });
+    add(QStringLiteral("transactions"), QStringLiteral("transactions"), QStringLiteral("transaction"), sizes.records, &MockDataset::transaction,
+        [](int id) { return QStringLiteral("TRX-%1").arg(id, 6, 10, '0'_L1); });
+    add(QStringLiteral("activity-logs"), QStringLiteral("logs"), QStringLiteral("log"), sizes.records, &MockDataset::activityLog,
+        [](int id) { return QStringLiteral("Product %1").arg(id); });
+    add(QStringLiteral("teams"), QStringLiteral("teams"), QStringLiteral("team"), 1, &MockDataset::team, [](int) { return QStringLiteral("Mock Team"); });
+}
+
+MockDataset::Collection *MockDataset::collection(const QString &segment)
+{
+    auto it = m_collections.find(segment);
+    return it == m_collections.end() ? nullptr : &it.value();
+}
+
+bool MockDataset::exists(const Collection &collection, int id) const
+{
+    if (collection.deleted.contains(id))
+        return false;
+    return (id >= 1 && id <= collection.count) || collection.changed.contains(id);
+}
+
+QJsonObject MockDataset::entity(const Collection &collection, int id) const
+{
+    auto it = collection.changed.constFind(id);
+    return it != collection.changed.cend() ? it.value() : collection.generate(id);
+}
+
+QJsonObject MockDataset::page(const Collection &collection, const QUrlQuery &query, const QString &basePath) const
+{
+    const int asked = query.queryItemValue(QStringLiteral("per_page")).toInt();
+    const int perPage = asked > 0 ? qMin(asked, 500) : 15;
+    const int requested = qMax(1, query.queryItemValue(QStringLiteral("page")).toInt());
+    const QString search = query.queryItemValue(QStringLiteral("search"), QUrl::FullyDecoded);
+    const bool descending = query.queryItemValue(QStringLiteral("sort_direction")) == "desc"_L1;
+
+    // Newest first when asked; created rows are appended after the generated ones
+    QList<int> ids;
+    ids.reserve(collection.count + collection.changed.size());
+    for (int id = 1; id < collection.nextId; ++id) {
+        if (!exists(collection, id))
+            continue;
+        if (!search.isEmpty() && !collection.name(id).contains(search, Qt::CaseInsensitive))
+            continue;
+        ids.append(id);
+    }
+    if (descending)
+        std::reverse(ids.begin(), ids.end());
+
+    // Sparse fieldsets: only the listed members and relations
+    QStringList members = query.queryItemValue(QStringLiteral("fields"), QUrl::FullyDecoded)
+                              .split(QLatin1Char(','), Qt::SkipEmptyParts);
+    if (!members.isEmpty())
+        members += query.queryItemValue(QStringLiteral("include"), QUrl::FullyDecoded)
+                       .split(QLatin1Char(','), Qt::SkipEmptyParts);
+    const auto row = [&](int id) {
+        QJsonObject row = entity(collection, id);
+        if (!members.isEmpty()) {
+            for (const QString &key : row.keys()) {
+                if (!members.contains(key))
+                    row.remove(key);
+            }
+        }
+        return row;
+    };
+
+    // Keyset pagination (pagination=cursor), shaped like Laravel's
+    // cursorPaginate(): no totals, and the cursor is the last id sent
+    if (query.queryItemValue(QStringLiteral("pagination")) == "cursor"_L1) {
+        const QByteArray cursor = query.queryItemValue(QStringLiteral("cursor"), QUrl::FullyDecoded).toLatin1();
+        auto first = ids.cbegin();
+        if (!cursor.isEmpty()) {
+            const int after = QByteArray::fromBase64(cursor, QByteArray::Base64UrlEncoding).toInt();
+            first = descending ? std::upper_bound(ids.cbegin(), ids.cend(), after, std::greater<int>())
+                               : std::upper_bound(ids.cbegin(), ids.cend(), after);
+        }
+        const auto last = first + qMin<qsizetype>(perPage, ids.cend() - first);
+
+        QJsonArray data;
+        for (auto it = first; it != last; ++it)
+            data.append(row(*it));
+        const QJsonValue next = last != ids.cend() && last != first
+            ? QJsonValue(QString::fromLatin1(QByteArray::number(*(last - 1)).toBase64(QByteArray::Base64UrlEncoding)))
+            : QJsonValue();
+        return QJsonObject{
+            {"data"_L1, data},
+            {"next_cursor"_L1, next},
+            {"path"_L1, QStringLiteral("http://localhost") + basePath},
+            {"per_page"_L1, perPage},
+            {"prev_cursor"_L1, QJsonValue()},
+        };
+    }
+
+    const int total = int(ids.size());
+    const int lastPage = qMax(1, (total + perPage - 1) / perPage);
+    const int current = qMin(requested, lastPage);
+    const int from = (current - 1) * perPage;
+    const int to = qMin(total, from + perPage);
+
+    QJsonArray data;
+    for (int i = from; i < to; ++i)
+        data.append(row(ids.at(i)));
+
+    const QString url = QStringLiteral("http://localhost") + basePath + QStringLiteral("?page=");
+    return QJsonObject{
+        {"current_page"_L1, current},
+        {"data"_L1, data},
+        {"first_page_url"_L1, url + QStringLiteral("1")},
+        {"from"_L1, total ? QJsonValue(from + 1) : QJsonValue()},
+        {"last_page"_L1, lastPage},
+        {"last_page_url"_L1, url + QString::number(lastPage)},
+        {"next_page_url"_L1, current < lastPage ? QJsonValue(url + QString::number(current + 1)) : QJsonValue()},
+        {"path"_L1, QStringLiteral("http://localhost") + basePath},
+        {"per_page"_L1, perPage},
+        {"prev_page_url"_L1, current > 1 ? QJsonValue(url + QString::number(current - 1)) : QJsonValue()},
+        {"to"_L1, total ? QJsonValue(to) : QJsonValue()},
+        {"total"_L1, total},
+    };
+}
+
+MockResponse MockDataset::handle(const MockRequest &request)
+{
+    static const QString Prefix = QStringLiteral("/api/v1/");
+    if (!request.path.startsWith(Prefix))
+        return MockResponse::message(404, QStringLiteral("Not found"));
+    const QStringList parts = request.path.mid(Prefix.size()).split('/'_L1, Qt::SkipEmptyParts);
+    if (parts.isEmpty())
+        return MockResponse::message(404, QStringLiteral("Not found"));
+
+    bool numeric = false;
+    if (parts.size() == 2)
+        parts.at(1).toInt(&numeric);
+    if (Collection *c = collection(parts.first()); c && (parts.size() == 1 || numeric))
+        return handleCollection(*c, request, parts);
+    return handleSpecial(request, parts);
+}
+
+MockResponse MockDataset::handleCollection(Collection &collection, const MockRequest &request,
+                                           const QStringList &parts)
+{
+    const QJsonObject body = QJsonDocument::fromJson(request.body).object();
+
+    if (parts.size() == 1) {
+        if (request.method == "GET")
+            return MockResponse::json({{collection.plural, page(collection, request.query, request.path)}});
+        if (request.method == "POST") {
+            const int id = collection.nextId++;
+            QJsonObject created = collection.generate(id);
+            for (auto it = body.begin(); it != body.end(); ++it)
+                created.insert(it.key(), it.value());
+            created["id"_L1] = id;
+            collection.changed.insert(id, created);
+            return MockResponse::json({{collection.singular, created}, {"message"_L1, QStringLiteral("Created")}}, 201);
+        }
+        return MockResponse::message(405, QStringLiteral("Method not allowed"));
+    }
+
+    const int id = parts.at(1).toInt();
+    if (!exists(collection, id))
+        return MockResponse::message(404, QStringLiteral("No query results for model %1").arg(id));
+
+    if (request.method == "GET")
+        return MockResponse::json({{collection.singular, entity(collection, id)}});
+    if (request.method == "PUT" || request.method == "PATCH") {
+        QJsonObject updated = entity(collection, id);
+        for (auto it = body.begin(); it != body.end(); ++it)
+            updated.insert(it.key(), it.value());
+        updated["id"_L1] = id;
+        updated["updated_at"_L1] = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
+        collection.changed.insert(id, updated);
+        return MockResponse::json({{collection.singular, updated}, {"message"_L1, QStringLiteral("Updated")}});
+    }
+    if (request.method == "DELETE") {
+        collection.changed.remove(id);
+        collection.deleted.insert(id);
+        return MockResponse::message(200, QStringLiteral("Deleted"));
+    }
+    return MockResponse::message(405, QStringLiteral("Method not allowed"));
+}
+
+MockResponse MockDataset::handleSpecial(const MockRequest &request, const QStringList &parts)
+{
+    const QString route = parts.join('/'_L1);
+    const QString first = parts.first();
+    const int id = parts.size() > 1 ? parts.at(1).toInt() : 0;
+    const QString action = parts.size() > 2 ? parts.at(2) : QString();
+    const QJsonObject body = QJsonDocument::fromJson(request.body).object();
+
+    if (route == "login"_L1 || route == "register"_L1) {
+        return MockResponse::json({{"accessToken"_L1, QStringLiteral("mock-token")},
+                                   {"user"_L1, QJsonObject{{"id"_L1, 1},
+                                                           {"name"_L1, QStringLiteral("Mock User")},
+                                                           {"email"_L1, body["email"_L1].toString()},
+                                                           {"team_id"_L1, 1}}}});
+    }
+    if (route == "logout"_L1)
+        return MockResponse::message(200, QStringLiteral("Logged out"));
+    if (route == "user"_L1) {
+        return MockResponse::json({{"id"_L1, 1}, {"name"_L1, QStringLiteral("Mock User")},
+                                   {"email"_L1, QStringLiteral("mock@example.invalid")}, {"team_id"_L1, 1}});
+    }
+    if (route == "subscription/status"_L1) {
+        return MockResponse::json({{"subscription"_L1,
+                                    QJsonObject{{"type"_L1, QStringLiteral("premium")},
+                                                {"status"_L1, QStringLiteral("active")},
+                                                {"start_date"_L1, CreatedAt},
+                                                {"expiration_date"_L1, QStringLiteral("2030-01-01T00:00:00.000000Z")},
+                                                {"days_until_expiration"_L1, 1000},
+                                                {"is_active"_L1, true},
+                                                {"plan_details"_L1, QJsonObject{{"name"_L1, QStringLiteral("Premium")}}}}}});
+    }
+    if (route == "product-units"_L1) {
+        QJsonArray units;
+        const QStringList names{QStringLiteral("piece"), QStringLiteral("kg"), QStringLiteral("litre"), QStringLiteral("box")};
+        for (int i = 0; i < names.size(); ++i)
+            units.append(QJsonObject{{"id"_L1, i + 1}, {"name"_L1, names.at(i)}, {"team_id"_L1, 1}});
+        return MockResponse::json({{"units"_L1, units}});
+    }
+    if (first == "dashboard"_L1 && parts.size() == 2)
+        return MockResponse::json({{"data"_L1, analytics(parts.at(1))}});
+    if (parts.size() == 2 && parts.at(1) == "summary"_L1)
+        return MockResponse::json({{"summary"_L1, summary()}});
+
+    // Generated documents
+    if (route == "barcodes/generate"_L1 || route == "sales/receipts/test"_L1
+        || (first == "sales"_L1 && action == "receipt"_L1) || (first == "invoices"_L1 && action == "download"_L1)) {
+        MockResponse response;
+        response.contentType = "application/pdf";
+        response.headers = {{"X-Paper-Width-MM", "80"}, {"X-Paper-Height-MM", "200"}};
+        response.body = pdf(route);
+        return response;
+    }
+
+    if (first == "products"_L1) {
+        Collection &products = *collection(QStringLiteral("products"));
+        if (route == "products/low-stock"_L1) {
+            QJsonArray low;
+            for (int i = 1; i <= qMin(products.count, 2000) && low.size() < 50; ++i) {
+                const QJsonObject p = entity(products, i);
+                if (p["quantity"_L1].toInt() <= p["reorder_point"_L1].toInt())
+                    low.append(p);
+            }
+            return MockResponse::json({{"products"_L1, low}});
+        }
+        if (!exists(products, id))
+            return MockResponse::message(404, QStringLiteral("Product not found"));
+        QJsonObject product = entity(products, id);
+        if (action == "stock"_L1) {
+            const int quantity = body["quantity"_L1].toInt();
+            const int current = product["quantity"_L1].toInt();
+            product["quantity"_L1] = body["operation"_L1].toString() == "remove"_L1 ? current - quantity : current + quantity;
+            products.changed.insert(id, product);
+            return MockResponse::json({{"product"_L1, product}});
+        }
+        if (action == "image"_L1) {
+            product["image_path"_L1] = QStringLiteral("products/%1.png").arg(id);
+            products.changed.insert(id, product);
+            return MockResponse::json({{"product"_L1, product}});
+        }
+        if (action == "barcodes"_L1) {
+            QJsonArray barcodes = product["barcodes"_L1].toArray();
+            if (request.method == "GET")
+                return MockResponse::json({{"barcodes"_L1, barcodes}});
+            if (request.method == "POST") {
+                const QJsonObject barcode{{"id"_L1, id * 10 + int(barcodes.size()) + 1},
+                                          {"barcode"_L1, body["barcode"_L1]}};
+                barcodes.append(barcode);
+                product["barcodes"_L1] = barcodes;
+                products.changed.insert(id, product);
+                return MockResponse::json({{"barcode"_L1, barcode}}, 201);
+            }
+            if (request.method == "DELETE" && parts.size() == 4) {
+                const int barcodeId = parts.at(3).toInt();
+                for (qsizetype i = 0; i < barcodes.size(); ++i) {
+                    if (barcodes.at(i)["id"_L1].toInt() == barcodeId) {
+                        barcodes.removeAt(i);
+                        break;
+                    }
+                }
+                product["barcodes"_L1] = barcodes;
+                products.changed.insert(id, product);
+                return MockResponse::message(200, QStringLiteral("Deleted"));
+            }
+        }
+    }
+
+    if (first == "sales"_L1 || first == "purchases"_L1 || first == "invoices"_L1) {
+        Collection &documents = *collection(first);
+        if (!exists(documents, id))
+            return MockResponse::message(404, QStringLiteral("No query results for model %1").arg(id));
+        QJsonObject document = entity(documents, id);
+        const QJsonObject payment{{"id"_L1, id},
+                                  {"amount"_L1, body["amount"_L1]},
+                                  {"payment_method"_L1, body["payment_method"_L1]},
+                                  {"reference_number"_L1, body["reference_number"_L1]},
+                                  {"payment_date"_L1, CreatedAt}};
+        if (action == "add-payment"_L1 || action == "payments"_L1) {
+            document["paid_amount"_L1] = document["total_amount"_L1];
+            document["payment_status"_L1] = QStringLiteral("paid");
+            documents.changed.insert(id, document);
+            return MockResponse::json({{"payment"_L1, payment}, {documents.singular, document}});
+        }
+        if (action == "generate-invoice"_L1)
+            return MockResponse::json({{"invoice"_L1, invoice(id)}});
+        if (action == "convert-to-sale"_L1) {
+            document["type"_L1] = QStringLiteral("sale");
+            documents.changed.insert(id, document);
+            return MockResponse::json({{"sale"_L1, document}});
+        }
+        if (action.startsWith("mark-"_L1) || action == "send"_L1) {
+            if (action == "mark-as-paid"_L1)
+                document["payment_status"_L1] = QStringLiteral("paid");
+            else if (action == "mark-as-sent"_L1)
+                document["status"_L1] = QStringLiteral("sent");
+            else
+                document["is_email_sent"_L1] = true;
+            documents.changed.insert(id, document);
+            return MockResponse::json({{"invoice"_L1, document}});
+        }
+    }
+
+    if (first == "clients"_L1) {
+        if (!exists(*collection(QStringLiteral("clients")), id))
+            return MockResponse::message(404, QStringLiteral("Client not found"));
+        if (action == "sales"_L1)
+            return MockResponse::json({{"sales"_L1, page(*collection(QStringLiteral("sales")), request.query, request.path)}});
+        if (action == "transactions"_L1) {
+            QJsonArray transactions;
+            for (int i = 1; i <= 10; ++i)
+                transactions.append(transaction(id * 10 + i));
+            return MockResponse::json({{"transactions"_L1, transactions}});
+        }
+        if (action == "statement"_L1) {
+            return MockResponse::json({{"client"_L1, client(id)},
+                                       {"opening_balance"_L1, money(0)},
+                                       {"closing_balance"_L1, money(id * 12.5)},
+                                       {"transactions"_L1, QJsonArray{transaction(id)}}});
+        }
+    }
+
+    if (first == "cash-sources"_L1 && (action == "deposit"_L1 || action == "withdraw"_L1 || action == "transfer"_L1)) {
+        Collection &sources = *collection(QStringLiteral("cash-sources"));
+        if (!exists(sources, id))
+            return MockResponse::message(404, QStringLiteral("Cash source not found"));
+        QJsonObject source = entity(sources, id);
+        const double amount = body["amount"_L1].toDouble();
+        const double balance = source["balance"_L1].toString().toDouble();
+        source["balance"_L1] = money(action == "deposit"_L1 ? balance + amount : balance - amount);
+        sources.changed.insert(id, source);
+        QJsonObject movement = transaction(id);
+        movement["type"_L1] = action;
+        movement["amount"_L1] = money(amount);
+        return MockResponse::json({{"cash_source"_L1, source}, {"transaction"_L1, movement}});
+    }
+
+    if (route.startsWith("transactions/by-source/"_L1)) {
+        return MockResponse::json(
+            {{"transactions"_L1, page(*collection(QStringLiteral("transactions")), request.query, request.path)}});
+    }
+
+    if (first == "activity-logs"_L1) {
+        if (route == "activity-logs/filter-options"_L1) {
+            return MockResponse::json({{"log_types"_L1, QJsonArray{QStringLiteral("create"), QStringLiteral("update"), QStringLiteral("delete")}},
+                                       {"model_types"_L1, QJsonArray{QStringLiteral("Product"), QStringLiteral("Sale"), QStringLiteral("Client")}}});
+        }
+        if (route == "activity-logs/statistics"_L1) {
+            const int days = request.query.queryItemValue(QStringLiteral("days")).toInt();
+            return MockResponse::json(
+                {{"total_logs"_L1, collection(QStringLiteral("activity-logs"))->count},
+                 {"analysis_period_days"_L1, days ? days : 30},
+                 {"log_type_distribution"_L1,
+                  QJsonArray{QJsonObject{{"log_type"_L1, QStringLiteral("create")}, {"count"_L1, 12}},
+                             QJsonObject{{"log_type"_L1, QStringLiteral("update")}, {"count"_L1, 30}}}},
+                 {"most_active_models"_L1,
+                  QJsonArray{QJsonObject{{"model_type"_L1, QStringLiteral("Product")},
+                                         {"model_identifier"_L1, QStringLiteral("Product 1")},
+                                         {"count"_L1, 9}}}}});
+        }
+        if (route == "activity-logs/cleanup"_L1)
+            return MockResponse::json({{"deleted_logs_count"_L1, 0}});
+    }
+
+    if (first == "teams"_L1) {
+        QJsonObject current = team(id ? id : 1);
+        if (action == "language"_L1)
+            return MockResponse::json({{"language"_L1, body["lang"_L1].toString(QStringLiteral("en"))}});
+        if (action == "image"_L1) {
+            current["image_path"_L1] = QStringLiteral("teams/%1.png").arg(id);
+            return MockResponse::json({{"team"_L1, current}});
+        }
+    }
+
+    return MockResponse::message(404, QStringLiteral("No mock for %1 %2").arg(QString::fromLatin1(request.method), request.path));
+}
+
+QJsonObject MockDataset::product(int id)
+{
+    const int price = 500 + (id * 37) % 9500;
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"reference"_L1, QStringLiteral("REF-%1").arg(id, 6, 10, '0'_L1)},
+        {"name"_L1, QStringLiteral("Product %1").arg(id)},
+        {"description"_L1, QStringLiteral("Synthetic product number %1").arg(id)},
+        {"price"_L1, price},
+        {"purchase_price"_L1, price * 4 / 5},
+        {"expired_date"_L1, QStringLiteral("2027-03-01T00:00:00.000000Z")},
+        {"quantity"_L1, (id * 7) % 200},
+        {"product_unit_id"_L1, 1},
+        {"sku"_L1, QStringLiteral("SKU%1").arg(id)},
+        {"min_stock_level"_L1, 5},
+        {"max_stock_level"_L1, 150},
+        {"reorder_point"_L1, 10},
+        {"location"_L1, QStringLiteral("Aisle %1").arg(id % 20 + 1)},
+        {"image_path"_L1, QJsonValue::Null},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+        {"deleted_at"_L1, QJsonValue::Null},
+        {"unit"_L1, QJsonObject{{"id"_L1, 1}, {"name"_L1, QStringLiteral("piece")}, {"team_id"_L1, 1}}},
+        {"barcodes"_L1, QJsonArray{QJsonObject{{"id"_L1, id * 10}, {"barcode"_L1, QStringLiteral("613%1").arg(id, 9, 10, '0'_L1)}}}},
+        {"packages"_L1, QJsonArray{QJsonObject{{"id"_L1, id},
+                                               {"name"_L1, QStringLiteral("Box")},
+                                               {"pieces_per_package"_L1, 12},
+                                               {"purchase_price"_L1, price * 12 * 0.8},
+                                               {"selling_price"_L1, price * 12 * 0.95},
+                                               {"barcode"_L1, QStringLiteral("99%1").arg(id, 9, 10, '0'_L1)}}}},
+    };
+}
+
+QJsonObject MockDataset::client(int id)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"name"_L1, QStringLiteral("Client %1").arg(id)},
+        {"email"_L1, QStringLiteral("client%1@example.invalid").arg(id)},
+        {"phone"_L1, QStringLiteral("+213 555 %1").arg(id, 6, 10, '0'_L1)},
+        {"address"_L1, QStringLiteral("%1 Main Street").arg(id)},
+        {"tax_number"_L1, QStringLiteral("TX%1").arg(id)},
+        {"if_number"_L1, QString()},
+        {"rc_number"_L1, QString()},
+        {"cnss_number"_L1, QString()},
+        {"tp_number"_L1, QString()},
+        {"nis_number"_L1, QString()},
+        {"nif_number"_L1, QString()},
+        {"ai_number"_L1, QString()},
+        {"payment_terms"_L1, QStringLiteral("30 days")},
+        {"notes"_L1, QString()},
+        {"status"_L1, QStringLiteral("active")},
+        {"balance"_L1, money(id * 12.5)},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+QJsonObject MockDataset::supplier(int id)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"name"_L1, QStringLiteral("Supplier %1").arg(id)},
+        {"email"_L1, QStringLiteral("supplier%1@example.invalid").arg(id)},
+        {"phone"_L1, QStringLiteral("+213 666 %1").arg(id, 6, 10, '0'_L1)},
+        {"address"_L1, QStringLiteral("%1 Industrial Road").arg(id)},
+        {"tax_number"_L1, QStringLiteral("TS%1").arg(id)},
+        {"payment_terms"_L1, QStringLiteral("60 days")},
+        {"notes"_L1, QString()},
+        {"status"_L1, QStringLiteral("active")},
+        {"balance"_L1, money(id * 40.0)},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+static QJsonArray lineItems(int id, int products, bool purchase)
+{
+    QJsonArray items;
+    const int count = 1 + id % 4;
+    for (int i = 0; i < count; ++i) {
+        const int productId = 1 + (id * 13 + i * 7) % qMax(1, products);
+        const int quantity = 1 + (id + i) % 5;
+        const double unitPrice = 500 + (productId * 37) % 9500;
+        QJsonObject item{
+            {"id"_L1, id * 10 + i},
+            {"product_id"_L1, productId},
+            {"product_name"_L1, QStringLiteral("Product %1").arg(productId)},
+            {"quantity"_L1, quantity},
+            {"unit_price"_L1, money(unitPrice)},
+            {"total_price"_L1, money(unitPrice * quantity)},
+            {"tax_rate"_L1, money(0)},
+            {"tax_amount"_L1, money(0)},
+            {"discount_amount"_L1, money(0)},
+            {"notes"_L1, QString()},
+            {"is_package"_L1, false},
+            {"package_id"_L1, QJsonValue::Null},
+            {"total_pieces"_L1, quantity},
+        };
+        if (purchase) {
+            item["package_purchase_price"_L1] = money(0);
+            item["package_selling_price"_L1] = money(0);
+        }
+        items.append(item);
+    }
+    return items;
+}
+
+static double itemsTotal(const QJsonArray &items)
+{
+    double total = 0;
+    for (const QJsonValue &item : items)
+        total += item["total_price"_L1].toString().toDouble();
+    return total;
+}
+
+QJsonObject MockDataset::sale(int id, int products)
+{
+    const QJsonArray items = lineItems(id, products, false);
+    const double total = itemsTotal(items);
+    const bool paid = id % 3 != 0;
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"client_id"_L1, 1 + id % 50},
+        {"cash_source_id"_L1, 1},
+        {"reference_number"_L1, QStringLiteral("SAL-%1").arg(id, 6, 10, '0'_L1)},
+        {"total_amount"_L1, money(total)},
+        {"paid_amount"_L1, money(paid ? total : 0)},
+        {"tax_amount"_L1, money(0)},
+        {"discount_amount"_L1, money(0)},
+        {"payment_status"_L1, paid ? QStringLiteral("paid") : QStringLiteral("unpaid")},
+        {"status"_L1, QStringLiteral("completed")},
+        {"type"_L1, id % 10 == 0 ? QStringLiteral("quote") : QStringLiteral("sale")},
+        {"sale_date"_L1, dateFor(id)},
+        {"due_date"_L1, QJsonValue::Null},
+        {"notes"_L1, QString()},
+        {"client"_L1, QJsonObject{{"id"_L1, 1 + id % 50}, {"name"_L1, QStringLiteral("Client %1").arg(1 + id % 50)}}},
+        {"items"_L1, items},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+QJsonObject MockDataset::purchase(int id, int products)
+{
+    const QJsonArray items = lineItems(id, products, true);
+    const double total = itemsTotal(items);
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"supplier_id"_L1, 1 + id % 20},
+        {"cash_source_id"_L1, 1},
+        {"reference_number"_L1, QStringLiteral("PUR-%1").arg(id, 6, 10, '0'_L1)},
+        {"total_amount"_L1, money(total)},
+        {"paid_amount"_L1, money(total)},
+        {"tax_amount"_L1, money(0)},
+        {"discount_amount"_L1, money(0)},
+        {"payment_status"_L1, QStringLiteral("paid")},
+        {"status"_L1, QStringLiteral("received")},
+        {"purchase_date"_L1, dateFor(id)},
+        {"notes"_L1, QString()},
+        {"supplier"_L1, QJsonObject{{"id"_L1, 1 + id % 20}, {"name"_L1, QStringLiteral("Supplier %1").arg(1 + id % 20)}}},
+        {"items"_L1, items},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+QJsonObject MockDataset::invoice(int id)
+{
+    QJsonArray items;
+    for (int i = 0; i < 1 + id % 3; ++i) {
+        items.append(QJsonObject{{"id"_L1, id * 10 + i},
+                                 {"description"_L1, QStringLiteral("Line %1").arg(i + 1)},
+                                 {"quantity"_L1, 1 + i},
+                                 {"unit_price"_L1, 100.0 * (i + 1)},
+                                 {"total_price"_L1, 100.0 * (i + 1) * (i + 1)}});
+    }
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"reference_number"_L1, QStringLiteral("INV-%1").arg(id, 6, 10, '0'_L1)},
+        {"invoiceable_type"_L1, QStringLiteral("App\\Models\\Sale")},
+        {"invoiceable_id"_L1, id},
+        {"invoiceable"_L1, QJsonObject{{"id"_L1, id}, {"reference_number"_L1, QStringLiteral("SAL-%1").arg(id, 6, 10, '0'_L1)}}},
+        {"total_amount"_L1, money(100.0 * id)},
+        {"tax_amount"_L1, money(0)},
+        {"discount_amount"_L1, money(0)},
+        {"status"_L1, QStringLiteral("draft")},
+        {"payment_status"_L1, QStringLiteral("unpaid")},
+        {"issue_date"_L1, dateFor(id)},
+        {"due_date"_L1, QDate(2025, 2, 1).addDays(id % 365).toString(Qt::ISODate)},
+        {"notes"_L1, QString()},
+        {"is_email_sent"_L1, false},
+        {"meta_data"_L1, QJsonObject()},
+        {"items"_L1, items},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+QJsonObject MockDataset::cashSource(int id)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"name"_L1, QStringLiteral("Register %1").arg(id)},
+        {"type"_L1, id % 2 ? QStringLiteral("cash") : QStringLiteral("bank")},
+        {"description"_L1, QString()},
+        {"balance"_L1, money(10000.0 * id)},
+        {"initial_balance"_L1, money(1000)},
+        {"account_number"_L1, id % 2 ? QString() : QStringLiteral("ACC%1").arg(id)},
+        {"bank_name"_L1, id % 2 ? QString() : QStringLiteral("Mock Bank")},
+        {"status"_L1, QStringLiteral("active")},
+        {"is_default"_L1, id == 1},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+QJsonObject MockDataset::transaction(int id)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"team_id"_L1, 1},
+        {"cash_source_id"_L1, 1},
+        {"reference_number"_L1, QStringLiteral("TRX-%1").arg(id, 6, 10, '0'_L1)},
+        {"type"_L1, id % 2 ? QStringLiteral("deposit") : QStringLiteral("withdrawal")},
+        {"amount"_L1, money(25.0 * (1 + id % 40))},
+        {"category"_L1, QStringLiteral("sales")},
+        {"payment_method"_L1, QStringLiteral("cash")},
+        {"description"_L1, QStringLiteral("Transaction %1").arg(id)},
+        {"transaction_date"_L1, dateFor(id)},
+        {"cash_source"_L1, QJsonObject{{"id"_L1, 1}, {"name"_L1, QStringLiteral("Register 1")}}},
+        {"transfer_destination"_L1, QJsonValue::Null},
+        {"created_at"_L1, CreatedAt},
+        {"updated_at"_L1, UpdatedAt},
+    };
+}
+
+QJsonObject MockDataset::activityLog(int id)
+{
+    static const QStringList types{QStringLiteral("create"), QStringLiteral("update"), QStringLiteral("delete")};
+    return QJsonObject{
+        {"id"_L1, id},
+        {"log_type"_L1, types.at(id % types.size())},
+        {"model_type"_L1, QStringLiteral("Product")},
+        {"model_identifier"_L1, QStringLiteral("Product %1").arg(id)},
+        {"user_identifier"_L1, QStringLiteral("Mock User")},
+        {"details"_L1, QJsonObject{{"field"_L1, QStringLiteral("quantity")}}},
+        {"created_at"_L1, CreatedAt},
+    };
+}
+
+QJsonObject MockDataset::team(int id)
+{
+    return QJsonObject{
+        {"id"_L1, id},
+        {"name"_L1, QStringLiteral("Mock Team")},
+        {"email"_L1, QStringLiteral("team@example.invalid")},
+        {"phone"_L1, QStringLiteral("+213 555 000000")},
+        {"address"_L1, QStringLiteral("1 Main Street")},
+        {"image_path"_L1, QJsonValue::Null},
+        {"locale"_L1, QStringLiteral("en")},
+    };
+}
+
+QJsonObject MockDataset::analytics(const QString &kind)
+{
+    QJsonArray history;
+    for (int i = 0; i < 12; ++i)
+        history.append(money(1000.0 + i * 150));
+    const QJsonObject periodInfo{{"start_date"_L1, QStringLiteral("2025-01-01")}, {"end_date"_L1, QStringLiteral("2025-12-31")},
+                                 {"period"_L1, QStringLiteral("year")}};
+
+    if (kind == "sales-analytics"_L1) {
+        QJsonArray top;
+        for (int i = 1; i <= 5; ++i)
+            top.append(QJsonObject{{"id"_L1, i}, {"name"_L1, QStringLiteral("Product %1").arg(i)}, {"total_quantity"_L1, 100 - i * 10}});
+        return {{"summary"_L1, QJsonObject{{"total_sales"_L1, 120}, {"total_revenue"_L1, money(45000)},
+                                           {"average_sale"_L1, money(375)}, {"total_orders"_L1, 120}}},
+                {"all_time"_L1, QJsonObject{{"total_sales"_L1, 1400}, {"total_revenue"_L1, money(520000)},
+                                            {"average_sale"_L1, money(371.43)}, {"total_orders"_L1, 1400}}},
+                {"history"_L1, history},
+                {"top_products"_L1, top},
+                {"period_info"_L1, periodInfo}};
+    }
+    if (kind == "purchase-analytics"_L1) {
+        QJsonArray top;
+        for (int i = 1; i <= 5; ++i)
+            top.append(QJsonObject{{"id"_L1, i}, {"name"_L1, QStringLiteral("Supplier %1").arg(i)}, {"total_amount"_L1, money(9000 - i * 1000)}});
+        return {{"summary"_L1, QJsonObject{{"total_purchases"_L1, 40}, {"total_cost"_L1, money(30000)},
+                                           {"average_purchase"_L1, money(750)}}},
+                {"all_time"_L1, QJsonObject{{"total_purchases"_L1, 500}, {"total_cost"_L1, money(380000)},
+                                            {"average_purchase"_L1, money(760)}}},
+                {"history"_L1, history},
+                {"top_suppliers"_L1, top},
+                {"period_info"_L1, periodInfo}};
+    }
+    if (kind == "inventory-analytics"_L1) {
+        QJsonArray alerts;
+        for (int i = 1; i <= 5; ++i)
+            alerts.append(QJsonObject{{"id"_L1, i}, {"name"_L1, QStringLiteral("Product %1").arg(i)}, {"quantity"_L1, i}});
+        return {{"current"_L1, QJsonObject{{"total_products"_L1, 1000}, {"total_stock"_L1, 99500},
+                                           {"average_stock"_L1, money(99.5)}}},
+                {"low_stock_alerts"_L1, alerts},
+                {"movements"_L1, QJsonArray{QJsonObject{{"date"_L1, QStringLiteral("2025-06-01")}, {"in"_L1, 40}, {"out"_L1, 35}}}},
+                {"period_info"_L1, periodInfo}};
+    }
+    if (kind == "overall"_L1) {
+        return {{"period_stats"_L1, QJsonObject{{"sales"_L1, money(45000)}, {"purchases"_L1, money(30000)},
+                                                {"orders"_L1, 120}}},
+                {"all_time"_L1, QJsonObject{{"total_sales"_L1, money(520000)}, {"total_purchases"_L1, money(380000)},
+                                            {"total_orders"_L1, 1400}}},
+                {"current_status"_L1, QJsonObject{{"low_stock_alerts"_L1, 5}, {"cash_balance"_L1, money(65000)}}},
+                {"period_info"_L1, periodInfo}};
+    }
+    // customer-analytics
+    QJsonArray top;
+    for (int i = 1; i <= 5; ++i)
+        top.append(QJsonObject{{"id"_L1, i}, {"name"_L1, QStringLiteral("Client %1").arg(i)}, {"total_amount"_L1, money(8000 - i * 900)}});
+    return {{"summary"_L1, QJsonObject{{"total_customers"_L1, 200}, {"new_customers"_L1, 12},
+                                       {"average_order_value"_L1, money(375)}}},
+            {"top_customers"_L1, top},
+            {"period_info"_L1, periodInfo}};
+}
+
+QJsonObject MockDataset::summary()
+{
+    return QJsonObject{
+        {"total_count"_L1, 200},
+        {"total_amount"_L1, money(75000)},
+        {"paid_amount"_L1, money(60000)},
+        {"unpaid_amount"_L1, money(15000)},
+        {"total_paid"_L1, money(60000)},
+        {"total_unpaid"_L1, money(15000)},
+    };
+}
+
+QByteArray MockDataset::pdf(const QString &title)
+{
+    // Smallest well-formed single page document; enough for the viewers
+    const QByteArray text = title.toLatin1().replace('(', ' ').replace(')', ' ');
+    const QByteArray stream = "BT /F1 12 Tf 20 560 Td (" + text + ") Tj ET";
+    const QList<QByteArray> objects{
+        "<< /Type /Catalog /Pages 2 0 R >>",
+        "<< /Type /Pages /Kids [3 0 R] /Count 1 >>",
+        "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 227 567] /Contents 4 0 R "
+        "/Resources << /Font << /F1 5 0 R >> >> >>",
+        "<< /Length " + QByteArray::number(stream.size()) + " >>\nstream\n" + stream + "\nendstream",
+        "<< /Type /Font /Subtype /Type1 /BaseFont /Helvetica >>",
+    };
+
+    QByteArray pdf = "%PDF-1.4\n";
+    QList<qsizetype> offsets;
+    for (qsizetype i = 0; i < objects.size(); ++i) {
+        offsets.append(pdf.size());
+        pdf += QByteArray::number(i + 1) + " 0 obj\n" + objects.at(i) + "\nendobj\n";
+    }
+    const qsizetype xref = pdf.size();
+    pdf += "xref\n0 " + QByteArray::number(objects.size() + 1) + "\n0000000000 65535 f \n";
+    for (qsizetype offset : offsets)
+        pdf += QByteArray::number(offset).rightJustified(10, '0') + " 00000 n \n";
+    pdf += "trailer\n<< /Size " + QByteArray::number(objects.size() + 1) + " /Root 1 0 R >>\nstartxref\n"
+        + QByteArray::number(xref) + "\n%%EOF\n";
+    return pdf;
+}
+
+} // namespace MockApi
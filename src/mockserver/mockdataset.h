@@ -0,0 +1,92 @@
+// mockdataset.h
+#ifndef MOCKDATASET_H
+#define MOCKDATASET_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QUrlQuery>
+#include <functional>
+
+namespace MockApi {
+
+struct MockRequest {
+    QByteArray method;
+    QString path;      // without the query, e.g. /api/v1/products/12
+    QUrlQuery query;
+    QList<QPair<QByteArray, QByteArray>> headers;
+    QByteArray body;
+
+    QByteArray header(QByteArrayView name) const;
+};
+
+struct MockResponse {
+    int status = 200;
+    QByteArray contentType = "application/json";
+    QList<QPair<QByteArray, QByteArray>> headers;
+    QByteArray body;
+
+    static MockResponse json(const QJsonObject &object, int status = 200);
+    static MockResponse message(int status, const QString &message);
+};
+
+// Synthetic data for every /api/v1 route the client uses. Entities are
+// derived from their id, so a dataset of 100k products costs nothing until
+// a page of it is requested; creations, updates and deletions are kept in
+// memory on top of that.
+class MockDataset
+{
+public:
+    struct Sizes {
+        int products = 1000;
+        int records = 200; // every other collection
+    };
+
+    explicit MockDataset(const Sizes &sizes);
+
+    MockResponse handle(const MockRequest &request);
+
+private:
+    struct Collection {
+        QString plural;   // envelope of list responses
+        QString singular; // envelope of single entities
+        int count = 0;
+        int nextId = 0;
+        QHash<int, QJsonObject> changed;
+        QSet<int> deleted;
+        std::function<QJsonObject(int)> generate;
+        std::function<QString(int)> name; // what ?search= matches
+    };
+
+    Collection *collection(const QString &segment);
+    bool exists(const Collection &collection, int id) const;
+    QJsonObject entity(const Collection &collection, int id) const;
+    QJsonObject page(const Collection &collection, const QUrlQuery &query, const QString &basePath) const;
+
+    MockResponse handleCollection(Collection &collection, const MockRequest &request, const QStringList &parts);
+    MockResponse handleSpecial(const MockRequest &request, const QStringList &parts);
+
+    static QJsonObject product(int id);
+    static QJsonObject client(int id);
+    static QJsonObject supplier(int id);
+    static QJsonObject sale(int id, int products);
+    static QJsonObject purchase(int id, int products);
+    static QJsonObject invoice(int id);
+    static QJsonObject cashSource(int id);
+    static QJsonObject transaction(int id);
+    static QJsonObject activityLog(int id);
+    static QJsonObject team(int id);
+    static QJsonObject analytics(const QString &kind);
+    static QJsonObject summary();
+    static QByteArray pdf(const QString &title);
+
+    QHash<QString, Collection> m_collections;
+};
+
+} // namespace MockApi
+
+#endif // MOCKDATASET_H
@@ -0,0 +1,313 @@
+// mockserver.cpp
+#include "mockserver.h"
+#include <QCborValue>
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QTcpSocket>
+#include <QTimer>
+#include <utility>
+
+using namespace Qt::StringLiterals;
+
+namespace MockApi {
+
+// Pacing granularity for --bandwidth
+static constexpr int TickMs = 50;
+
+static QByteArray reasonPhrase(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 204: return "No Content";
+    case 304: return "Not Modified";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 422: return "Unprocessable Content";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 504: return "Gateway Timeout";
+    default: return "Status";
+    }
+}
+
+static QByteArray entityTag(const QByteArray &body)
+{
+    return '"' + QCryptographicHash::hash(body, QCryptographicHash::Sha1).toHex().left(20) + '"';
+}
+
+MockServer::MockServer(const Options &options, const MockDataset::Sizes &sizes, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_dataset(sizes)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &MockServer::acceptConnections);
+}
+
+bool MockServer::listen(const QHostAddress &address, quint16 port)
+{
+    if (!m_server.listen(address, port)) {
+        qWarning() << "MockServer: cannot listen on port" << port << m_server.errorString();
+        return false;
+    }
+    return true;
+}
+
+void MockServer::acceptConnections()
+{
+    while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+        m_connections.insert(socket, Connection());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            readRequests(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockServer::readRequests(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end())
+        return;
+    it->buffer += socket->readAll();
+    // One response at a time per connection, like a real server would order them
+    if (it->busy)
+        return;
+
+    MockRequest request;
+    bool keepAlive = true;
+    if (!takeRequest(it->buffer, request, keepAlive))
+        return;
+    it->busy = true;
+
+    int delay = m_options.latencyMs;
+    if (m_options.jitterMs > 0)
+        delay += QRandomGenerator::global()->bounded(m_options.jitterMs + 1);
+
+    const bool failed = m_options.errorRate > 0 && QRandomGenerator::global()->generateDouble() < m_options.errorRate;
+    if (failed && m_options.errorStatus == 0) {
+        qInfo().noquote() << request.method << request.path << "-> dropped";
+        QTimer::singleShot(delay, socket, [socket]() { socket->abort(); });
+        return;
+    }
+
+    MockResponse response;
+    if (failed) {
+        response = MockResponse::message(m_options.errorStatus, QStringLiteral("Injected failure"));
+        if (m_options.errorStatus == 503 || m_options.errorStatus == 429)
+            response.headers.append({"Retry-After", "1"});
+    } else {
+        response = respond(request);
+    }
+
+    const QByteArray data = serialise(request, response, keepAlive);
+    qInfo().noquote() << request.method << request.path << "->" << response.status << data.size() << "bytes";
+    QTimer::singleShot(delay, socket, [this, socket, data, keepAlive]() {
+        deliver(socket, data, keepAlive);
+    });
+}
+
+bool MockServer::takeRequest(QByteArray &buffer, MockRequest &request, bool &keepAlive) const
+{
+    const qsizetype headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0)
+        return false;
+
+    const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+    const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+    if (requestLine.size() < 3) {
+        buffer.clear();
+        return false;
+    }
+
+    qsizetype contentLength = 0;
+    request.headers.clear();
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const QByteArray line = lines.at(i).trimmed();
+        const qsizetype colon = line.indexOf(':');
+        if (colon <= 0)
+            continue;
+        const QByteArray name = line.left(colon).trimmed();
+        const QByteArray value = line.mid(colon + 1).trimmed();
+        if (name.compare("Content-Length", Qt::CaseInsensitive) == 0)
+            contentLength = value.toLongLong();
+        request.headers.append({name, value});
+    }
+
+    const qsizetype bodyStart = headerEnd + 4;
+    if (buffer.size() < bodyStart + contentLength)
+        return false;
+
+    request.method = requestLine.at(0);
+    const QUrl target(QString::fromLatin1(requestLine.at(1)));
+    request.path = target.path();
+    request.query = QUrlQuery(target);
+    request.body = buffer.mid(bodyStart, contentLength);
+    buffer.remove(0, bodyStart + contentLength);
+
+    const QByteArray connection = request.header("Connection").toLower();
+    keepAlive = requestLine.at(2) == "HTTP/1.1" ? connection != "close" : connection == "keep-alive";
+    return true;
+}
+
+MockResponse MockServer::respond(const MockRequest &request)
+{
+    if (request.method == "POST" && request.path == "/api/v1/batch"_L1)
+        return respondBatch(request);
+    MockResponse response;
+    if (fromFixture(request, response))
+        return response;
+    return m_dataset.handle(request);
+}
+
+MockResponse MockServer::respondBatch(const MockRequest &request)
+{
+    // Same contract as RequestBatch: every call answered inline, JSON bodies
+    // embedded as JSON
+    const QJsonArray calls = QJsonDocument::fromJson(request.body).object().value("requests"_L1).toArray();
+    QJsonArray responses;
+    for (const QJsonValue &value : calls) {
+        const QJsonObject call = value.toObject();
+        MockRequest inner;
+        inner.method = call.value("method"_L1).toString(QStringLiteral("GET")).toLatin1();
+        const QUrl target(call.value("path"_L1).toString());
+        inner.path = target.path();
+        inner.query = QUrlQuery(target);
+        const QJsonObject headers = call.value("headers"_L1).toObject();
+        for (auto it = headers.begin(); it != headers.end(); ++it)
+            inner.headers.append({it.key().toLatin1(), it.value().toString().toLatin1()});
+
+        MockResponse response = respond(inner);
+        QJsonObject responseHeaders{{"Content-Type"_L1, QString::fromLatin1(response.contentType)}};
+        const QByteArray etag = entityTag(response.body);
+        if (inner.method == "GET" && response.status == 200) {
+            responseHeaders.insert("ETag"_L1, QString::fromLatin1(etag));
+            if (inner.header("If-None-Match") == etag) {
+                response.status = 304;
+                response.body.clear();
+            }
+        }
+        for (const auto &header : std::as_const(response.headers))
+            responseHeaders.insert(QString::fromLatin1(header.first), QString::fromLatin1(header.second));
+
+        const QJsonDocument document = QJsonDocument::fromJson(response.body);
+        QJsonValue body = QString::fromUtf8(response.body);
+        if (document.isObject())
+            body = document.object();
+        else if (document.isArray())
+            body = document.array();
+
+        responses.append(QJsonObject{{"id"_L1, call.value("id"_L1)},
+                                     {"status"_L1, response.status},
+                                     {"headers"_L1, responseHeaders},
+                                     {"body"_L1, body}});
+    }
+    return MockResponse::json({{"responses"_L1, responses}});
+}
+
+bool MockServer::fromFixture(const MockRequest &request, MockResponse &response) const
+{
+    if (m_options.fixtures.isEmpty())
+        return false;
+    const QString base = QDir(m_options.fixtures).filePath(QString::fromLatin1(request.method) + request.path);
+    for (const auto &[suffix, type] : {std::pair{".json"_L1, "application/json"}, std::pair{".pdf"_L1, "application/pdf"}}) {
+        QFile file(base + suffix);
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        response.status = 200;
+        response.contentType = type;
+        response.body = file.readAll();
+        return true;
+    }
+    return false;
+}
+
+QByteArray MockServer::serialise(const MockRequest &request, MockResponse response, bool keepAlive) const
+{
+    QList<QPair<QByteArray, QByteArray>> headers = response.headers;
+
+    // Conditional GETs, so the client's ETag revalidation has something to hit
+    if (request.method == "GET" && response.status == 200) {
+        const QByteArray etag = entityTag(response.body);
+        headers.append({"ETag", etag});
+        if (request.header("If-None-Match") == etag) {
+            response.status = 304;
+            response.body.clear();
+        }
+    }
+
+    const bool json = response.contentType == "application/json";
+    if (json && !response.body.isEmpty() && request.header("Accept").contains("application/cbor")) {
+        response.body = QCborValue::fromJsonValue(QJsonDocument::fromJson(response.body).object()).toCbor();
+        response.contentType = "application/cbor";
+    }
+    if (m_options.compress && response.body.size() > 512 && request.header("Accept-Encoding").contains("deflate")) {
+        // qCompress() is a zlib stream behind a four byte length prefix
+        response.body = qCompress(response.body).mid(4);
+        headers.append({"Content-Encoding", "deflate"});
+    }
+    headers.append({"Vary", "Accept, Accept-Encoding"});
+
+    QByteArray data = "HTTP/1.1 " + QByteArray::number(response.status) + ' ' + reasonPhrase(response.status) + "\r\n";
+    if (response.status != 304)
+        data += "Content-Type: " + response.contentType + "\r\n";
+    data += "Content-Length: " + QByteArray::number(response.body.size()) + "\r\n";
+    data += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    for (const auto &header : std::as_const(headers))
+        data += header.first + ": " + header.second + "\r\n";
+    data += "\r\n" + response.body;
+    return data;
+}
+
+void MockServer::deliver(QTcpSocket *socket, const QByteArray &data, bool keepAlive)
+{
+    if (m_options.bandwidth <= 0) {
+        socket->write(data);
+        finished(socket, keepAlive);
+        return;
+    }
+    writePaced(socket, data, keepAlive);
+}
+
+void MockServer::writePaced(QTcpSocket *socket, QByteArray remaining, bool keepAlive)
+{
+    const qsizetype chunk = qMax(1, m_options.bandwidth * TickMs / 1000);
+    socket->write(remaining.left(chunk));
+    remaining.remove(0, chunk);
+    if (remaining.isEmpty()) {
+        finished(socket, keepAlive);
+        return;
+    }
+    QTimer::singleShot(TickMs, socket, [this, socket, remaining, keepAlive]() {
+        writePaced(socket, remaining, keepAlive);
+    });
+}
+
+void MockServer::finished(QTcpSocket *socket, bool keepAlive)
+{
+    if (!keepAlive) {
+        socket->disconnectFromHost();
+        return;
+    }
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end())
+        return;
+    it->busy = false;
+    // Pipelined requests that arrived meanwhile
+    if (!it->buffer.isEmpty())
+        QMetaObject::invokeMethod(socket, [this, socket]() { readRequests(socket); }, Qt::QueuedConnection);
+}
+
+} // namespace MockApi
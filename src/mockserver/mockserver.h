@@ -0,0 +1,63 @@
+// mockserver.h
+#ifndef MOCKSERVER_H
+#define MOCKSERVER_H
+
+#include "mockdataset.h"
+#include <QHash>
+#include <QObject>
+#include <QTcpServer>
+
+class QTcpSocket;
+
+namespace MockApi {
+
+// A minimal HTTP/1.1 server (keep-alive, Content-Length bodies) that answers
+// the /api/v1 routes from fixtures or the synthetic dataset, with the
+// network conditions of a real deployment layered on top.
+class MockServer : public QObject
+{
+    Q_OBJECT
+public:
+    struct Options {
+        int latencyMs = 0;        // added before every response
+        int jitterMs = 0;         // random extra latency, 0..jitterMs
+        int bandwidth = 0;        // bytes per second, 0 for unlimited
+        double errorRate = 0;     // share of requests answered with errorStatus
+        int errorStatus = 503;    // 0 drops the connection instead
+        bool compress = true;     // deflate bodies when the client accepts it
+        QString fixtures;         // <dir>/<METHOD>/api/v1/<path>.json wins over the dataset
+    };
+
+    MockServer(const Options &options, const MockDataset::Sizes &sizes, QObject *parent = nullptr);
+
+    bool listen(const QHostAddress &address, quint16 port);
+    quint16 port() const { return m_server.serverPort(); }
+
+private:
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;
+    };
+
+    void acceptConnections();
+    void readRequests(QTcpSocket *socket);
+    bool takeRequest(QByteArray &buffer, MockRequest &request, bool &keepAlive) const;
+
+    MockResponse respond(const MockRequest &request);
+    MockResponse respondBatch(const MockRequest &request);
+    bool fromFixture(const MockRequest &request, MockResponse &response) const;
+    QByteArray serialise(const MockRequest &request, MockResponse response, bool keepAlive) const;
+
+    void deliver(QTcpSocket *socket, const QByteArray &data, bool keepAlive);
+    void writePaced(QTcpSocket *socket, QByteArray remaining, bool keepAlive);
+    void finished(QTcpSocket *socket, bool keepAlive);
+
+    Options m_options;
+    MockDataset m_dataset;
+    QTcpServer m_server;
+    QHash<QTcpSocket *, Connection> m_connections;
+};
+
+} // namespace MockApi
+
+#endif // MOCKSERVER_H
@@ -178,9 +178,7 @@ void ActivityLogModel::setSortDirection(const QString &direction)
 
 void ActivityLogModel::handleLogsReceived(const PaginatedLogs &logs)
 {
-    beginResetModel();
-    m_logs = logs.data;
-    endResetModel();
+    RowDiff<ActivityLogModel>::apply(*this, m_logs, logs.data);
 
     m_totalItems = logs.total;
     Q_EMIT totalItemsChanged();
@@ -193,8 +191,6 @@ void ActivityLogModel::handleLogsReceived(const PaginatedLogs &logs)
 
     setLoading(false);
     setErrorMessage(QString());
-
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
 }
 
 void ActivityLogModel::handleLogError(const QString &message, ApiStatus status)
@@ -3,6 +3,7 @@
 #define ACTIVITYLOGMODEL_H
 
 #include "../api/activitylogapi.h"
+#include "rowdiff.h"
 #include <QAbstractTableModel>
 #include <QQmlEngine>
 
@@ -11,6 +12,7 @@ namespace NetworkApi {
 class ActivityLogModel : public QAbstractTableModel
 {
     Q_OBJECT
+    friend struct RowDiff<ActivityLogModel>;
 
     Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
     Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
@@ -3,16 +3,43 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+QVariant initialBalance(const CashSource &source)
+{
+    return QString::number(source.initial_balance, 'f', 2);
+}
+
+constexpr ModelRole<CashSource> CashSourceRoleTable[] = {
+    memberRole<&CashSource::id>(CashSourceModel::IdRole, "id"),
+    memberRole<&CashSource::name>(CashSourceModel::NameRole, "name"),
+    memberRole<&CashSource::description>(CashSourceModel::DescriptionRole, "description"),
+    memberRole<&CashSource::type>(CashSourceModel::TypeRole, "type"),
+    memberRole<&CashSource::balance>(CashSourceModel::BalanceRole, "balance"),
+    {CashSourceModel::InitialBalanceRole, "initialBalance", &initialBalance},
+    memberRole<&CashSource::account_number>(CashSourceModel::AccountNumberRole, "account_number"),
+    memberRole<&CashSource::bank_name>(CashSourceModel::BankNameRole, "bank_name"),
+    memberRole<&CashSource::status>(CashSourceModel::StatusRole, "status"),
+    memberRole<&CashSource::is_default>(CashSourceModel::IsDefaultRole, "isDefault"),
+};
+
+constexpr ModelColumn<CashSource> CashSourceColumns[] = {
+    memberColumn<&CashSource::id>(QT_TRANSLATE_NOOP("NetworkApi::CashSourceModel", "ID")),
+    memberColumn<&CashSource::name>(QT_TRANSLATE_NOOP("NetworkApi::CashSourceModel", "Name")),
+    memberColumn<&CashSource::type>(QT_TRANSLATE_NOOP("NetworkApi::CashSourceModel", "Type")),
+    memberColumn<&CashSource::balance>(QT_TRANSLATE_NOOP("NetworkApi::CashSourceModel", "Balance")),
+    memberColumn<&CashSource::initial_balance>(QT_TRANSLATE_NOOP("NetworkApi::CashSourceModel", "Initial Balance")),
+    memberColumn<&CashSource::status>(QT_TRANSLATE_NOOP("NetworkApi::CashSourceModel", "Status")),
+};
+
+} // namespace
+
 CashSourceModel::CashSourceModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<CashSource>(CashSourceRoleTable, CashSourceColumns, CheckedRole,
+                                       QStringLiteral("name"), QStringLiteral("asc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("name"))
-    , m_sortDirection(QStringLiteral("asc"))
-    , m_hasCheckedItems(false)
 {
 }
 
@@ -35,102 +62,6 @@ void CashSourceModel::setApi(CashSourceApi* api)
      refresh();
 }
 
-int CashSourceModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_sources.count();
-}
-
-int CashSourceModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 7; // ID, Name, Type, Balance, Status
-}
-
-QVariant CashSourceModel::data(const QModelIndex &index, int role) const
-{
-    if (!index.isValid() || index.row() >= m_sources.count())
-        return QVariant();
-
-    const CashSource &source = m_sources.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return source.id;
-        case 1: return source.name;
-        case 2: return source.type;
-        case 3: return source.balance;
-        case 4: return source.initial_balance;
-        case 5: return source.status;
-        }
-    } else {
-        switch (role) {
-        case IdRole: return source.id;
-        case NameRole: return source.name;
-        case DescriptionRole: return source.description;
-        case TypeRole: return source.type;
-        case BalanceRole: return source.balance;
-        case InitialBalanceRole: return  QString::number(source.initial_balance, 'f', 2);
-        case AccountNumberRole: return source.account_number;
-        case BankNameRole: return source.bank_name;
-        case StatusRole: return source.status;
-        case IsDefaultRole: return source.is_default;
-        case CheckedRole: return source.checked;
-        }
-    }
-
-    return QVariant();
-}
-
-QHash<int, QByteArray> CashSourceModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[NameRole] = "name";
-    roles[DescriptionRole] = "description";
-    roles[TypeRole] = "type";
-    roles[BalanceRole] = "balance";
-    roles[InitialBalanceRole] = "initialBalance";
-    roles[AccountNumberRole] = "account_number";
-    roles[BankNameRole] = "bank_name";
-    roles[StatusRole] = "status";
-    roles[IsDefaultRole] = "isDefault";
-    roles[CheckedRole] = "checked";
-    return roles;
-}
-
-QVariant CashSourceModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("ID");
-        case 1: return tr("Name");
-        case 2: return tr("Type");
-        case 3: return tr("Balance");
-        case 4: return tr("Status");
-        }
-    }
-    return QVariant();
-}
-
-bool CashSourceModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_sources.count()) {
-            m_sources[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
-}
-
 void CashSourceModel::refresh()
 {
     if (!m_api)
@@ -140,15 +71,6 @@ void CashSourceModel::refresh()
     m_api->getCashSources(m_searchQuery, m_sortField, m_sortDirection, m_currentPage);
 }
 
-void CashSourceModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void CashSourceModel::createCashSource(const QVariantMap &sourceData)
 {
     if (!m_api)
@@ -198,10 +120,10 @@ void CashSourceModel::deleteCashSource(int id)
 
 QVariantMap CashSourceModel::getCashSource(int row) const
 {
-    if (row < 0 || row >= m_sources.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return cashSourceToVariantMap(m_sources.at(row));
+    return cashSourceToVariantMap(m_rows.at(row));
 }
 
 void CashSourceModel::deposit(int id, double amount, const QString &notes)
@@ -240,107 +162,10 @@ TransferData CashSourceModel::transferDataFromVariantMap(const QVariantMap &map)
     return data;
 }
 
-// Selection methods
-void CashSourceModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_sources.count()) {
-        m_sources[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList CashSourceModel::getCheckedCashSourceIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &source : m_sources) {
-        if (source.checked) {
-            checkedIds.append(source.id);
-        }
-    }
-    return checkedIds;
-}
-
-void CashSourceModel::clearAllChecked()
-{
-    for (int i = 0; i < m_sources.count(); ++i) {
-        if (m_sources[i].checked) {
-            m_sources[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void CashSourceModel::toggleAllCashSourcesChecked()
-{
-    bool allChecked = true;
-    for (const auto &source : m_sources) {
-        if (!source.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_sources.count(); ++i) {
-        m_sources[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
-
-// Slots
-void CashSourceModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void CashSourceModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void CashSourceModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();
-    }
-}
-
 // Private slots
 void CashSourceModel::handleCashSourcesReceived(const PaginatedCashSources &sources)
 {
-    beginResetModel();
-    m_sources = sources.data;
-    endResetModel();
-
-    m_totalItems = sources.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = sources.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = sources.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    updateHasCheckedItems();
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
+    receivePage(sources);
 }
 
 void CashSourceModel::handleCashSourceError(const QString &message, ApiStatus status)
@@ -351,9 +176,7 @@ void CashSourceModel::handleCashSourceError(const QString &message, ApiStatus st
 
 void CashSourceModel::handleCashSourceCreated(const CashSource &source)
 {
-    beginInsertRows(QModelIndex(), m_sources.count(), m_sources.count());
-    m_sources.append(source);
-    endInsertRows();
+    appendEntity(source);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -362,14 +185,7 @@ void CashSourceModel::handleCashSourceCreated(const CashSource &source)
 
 void CashSourceModel::handleCashSourceUpdated(const CashSource &source)
 {
-    for (int i = 0; i < m_sources.count(); ++i) {
-        if (m_sources[i].id == source.id) {
-            m_sources[i] = source;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    replaceEntity(source);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -378,14 +194,7 @@ void CashSourceModel::handleCashSourceUpdated(const CashSource &source)
 
 void CashSourceModel::handleCashSourceDeleted(int id)
 {
-    for (int i = 0; i < m_sources.count(); ++i) {
-        if (m_sources[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_sources.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -417,22 +226,6 @@ void CashSourceModel::handleTransferCompleted(const QVariantMap &transaction)
 }
 
 // Private methods
-void CashSourceModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void CashSourceModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 CashSource CashSourceModel::cashSourceFromVariantMap(const QVariantMap &map) const
 {
     CashSource source;
@@ -472,20 +265,4 @@ QVariantMap CashSourceModel::cashSourceToVariantMap(const CashSource &source) co
     return map;
 }
 
-void CashSourceModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &source : m_sources) {
-        if (source.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
-
 } // namespace NetworkApi
@@ -16,7 +16,8 @@ void CashSourceModelFetch::loadPage(int page)
 
     if (page > 0 && page <= m_totalPages && !m_loading) {
         setLoading(true);
-        m_api->getCashSources(m_searchQuery, m_sortField, m_sortDirection, page);
+        m_appending = page > 1;
+        m_api->getCashSources(m_searchQuery, m_sortField, m_sortDirection, page, cursorFor(page));
     }
 }
 
@@ -25,8 +26,10 @@ void CashSourceModelFetch::refresh()
     if (!m_api)
         return;
 
+    // A cursor only leads forward, so refreshing starts over from the first page
     setLoading(true);
-    m_api->getCashSources(m_searchQuery, m_sortField, m_sortDirection, m_currentPage);
+    m_appending = false;
+    m_api->getCashSources(m_searchQuery, m_sortField, m_sortDirection, 1, cursorFor(1));
 }
 
 void CashSourceModelFetch::handleCashSourcesReceived(const PaginatedCashSources &sources)
@@ -35,34 +38,13 @@ void CashSourceModelFetch::handleCashSourcesReceived(const PaginatedCashSources
              << sources.currentPage << "of" << sources.lastPage
              << "Items count:" << sources.data.count();
 
-    if (sources.currentPage == 1) {
-        beginResetModel();
-        m_sources.clear();
-        endResetModel();
-    }
-
-    if (!sources.data.isEmpty()) {
-        beginInsertRows(QModelIndex(), m_sources.count(),
-                       m_sources.count() + sources.data.count() - 1);
-        m_sources.append(sources.data);
-        endInsertRows();
-    }
-
-    m_totalItems = sources.total;
-    m_currentPage = sources.currentPage;
-    m_totalPages = sources.lastPage;
-
-    Q_EMIT totalItemsChanged();
-    Q_EMIT currentPageChanged();
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
+    // The first page replaces the rows, matched by id; the others are appended
+    receiveFetchedPage(sources);
 
     qDebug() << "CashSourceModelFetch::handleCashSourcesReceived - After update:"
              << "Current page:" << m_currentPage
              << "Total items:" << m_totalItems
-             << "Total sources in model:" << m_sources.count();
+             << "Total sources in model:" << m_rows.count();
 }
 
 } // namespace NetworkApi
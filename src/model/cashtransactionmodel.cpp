@@ -3,20 +3,47 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+constexpr ModelRole<CashTransaction> CashTransactionRoleTable[] = {
+    memberRole<&CashTransaction::id>(CashTransactionModel::IdRole, "id"),
+    memberRole<&CashTransaction::reference_number>(CashTransactionModel::ReferenceNumberRole, "referenceNumber"),
+    memberRole<&CashTransaction::transaction_date>(CashTransactionModel::TransactionDateRole, "transactionDate"),
+    memberRole<&CashTransaction::cash_source_id>(CashTransactionModel::CashSourceIdRole, "cashSourceId"),
+    memberRole<&CashTransaction::type>(CashTransactionModel::TypeRole, "type"),
+    memberRole<&CashTransaction::amount>(CashTransactionModel::AmountRole, "amount"),
+    memberRole<&CashTransaction::category>(CashTransactionModel::CategoryRole, "category"),
+    memberRole<&CashTransaction::payment_method>(CashTransactionModel::PaymentMethodRole, "paymentMethod"),
+    memberRole<&CashTransaction::description>(CashTransactionModel::DescriptionRole, "description"),
+    memberRole<&CashTransaction::cash_source>(CashTransactionModel::CashSourceRole, "cashSource"),
+    memberRole<&CashTransaction::transfer_destination>(CashTransactionModel::TransferDestinationRole, "transferDestination"),
+};
+
+constexpr ModelColumn<CashTransaction> CashTransactionColumns[] = {
+    memberColumn<&CashTransaction::transaction_date>(QT_TRANSLATE_NOOP("NetworkApi::CashTransactionModel", "Date")),
+    memberColumn<&CashTransaction::reference_number>(QT_TRANSLATE_NOOP("NetworkApi::CashTransactionModel", "Reference")),
+    memberColumn<&CashTransaction::type>(QT_TRANSLATE_NOOP("NetworkApi::CashTransactionModel", "Type")),
+    memberColumn<&CashTransaction::category>(QT_TRANSLATE_NOOP("NetworkApi::CashTransactionModel", "Category")),
+    memberColumn<&CashTransaction::amount>(QT_TRANSLATE_NOOP("NetworkApi::CashTransactionModel", "Amount")),
+};
+
+} // namespace
+
 CashTransactionModel::CashTransactionModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<CashTransaction>(CashTransactionRoleTable, CashTransactionColumns, CheckedRole,
+                                            QStringLiteral("transaction_date"), QStringLiteral("desc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("transaction_date"))
-    , m_sortDirection(QStringLiteral("desc"))
     , m_cashSourceId(0)
-    , m_hasCheckedItems(false)
     , m_minAmount(0)
     , m_maxAmount(0)
 {
+    // A new search starts from the first page; emitted before the refresh
+    connect(this, &PaginatedModel::searchQueryChanged, this, [this]() {
+        m_currentPage = 1;
+        Q_EMIT currentPageChanged();
+    });
 }
 
 void CashTransactionModel::setApi(CashTransactionApi* api)
@@ -44,92 +71,6 @@ void CashTransactionModel::setApi(CashTransactionApi* api)
       refresh();
 }
 
-int CashTransactionModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_transactions.count();
-}
-
-int CashTransactionModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 5; // Date, Reference, Type, Category, Amount, Description
-}
-
-QVariant CashTransactionModel::data(const QModelIndex &index, int role) const
-{
-    if (!index.isValid() || index.row() >= m_transactions.count())
-        return QVariant();
-
-    const CashTransaction &transaction = m_transactions.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return transaction.transaction_date;
-        case 1: return transaction.reference_number;
-        case 2: return transaction.type;
-        case 3: return transaction.category;
-        case 4: return transaction.amount;
-        case 5: return transaction.description;
-        }
-    } else {
-        switch (role) {
-        case IdRole: return transaction.id;
-        case ReferenceNumberRole: return transaction.reference_number;
-        case TransactionDateRole: return transaction.transaction_date;
-        case CashSourceIdRole: return transaction.cash_source_id;
-        case TypeRole: return transaction.type;
-        case AmountRole: return transaction.amount;
-        case CategoryRole: return transaction.category;
-        case PaymentMethodRole: return transaction.payment_method;
-        case DescriptionRole: return transaction.description;
-        case CashSourceRole: return transaction.cash_source;
-        case TransferDestinationRole: return transaction.transfer_destination;
-        case CheckedRole: return transaction.checked;
-        }
-    }
-
-    return QVariant();
-}
-
-QHash<int, QByteArray> CashTransactionModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[ReferenceNumberRole] = "referenceNumber";
-    roles[TransactionDateRole] = "transactionDate";
-    roles[CashSourceIdRole] = "cashSourceId";
-    roles[TypeRole] = "type";
-    roles[AmountRole] = "amount";
-    roles[CategoryRole] = "category";
-    roles[PaymentMethodRole] = "paymentMethod";
-    roles[DescriptionRole] = "description";
-    roles[CashSourceRole] = "cashSource";
-    roles[TransferDestinationRole] = "transferDestination";
-    roles[CheckedRole] = "checked";
-    return roles;
-}
-
-QVariant CashTransactionModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("Date");
-        case 1: return tr("Reference");
-        case 2: return tr("Type");
-        case 3: return tr("Category");
-        case 4: return tr("Amount");
-        case 5: return tr("Description");
-        }
-    }
-    return QVariant();
-}
-
 void CashTransactionModel::refresh()
 {
     if (!m_api)
@@ -141,15 +82,6 @@ void CashTransactionModel::refresh()
                            m_minAmount, m_maxAmount, m_startDate, m_endDate);
 }
 
-void CashTransactionModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void CashTransactionModel::loadTransactionsBySource(int sourceId, int page)
 {
     if (!m_api)
@@ -161,10 +93,10 @@ void CashTransactionModel::loadTransactionsBySource(int sourceId, int page)
 
 QVariantMap CashTransactionModel::getTransaction(int row) const
 {
-    if (row < 0 || row >= m_transactions.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    const CashTransaction &transaction = m_transactions.at(row);
+    const CashTransaction &transaction = m_rows.at(row);
     QVariantMap map;
     map["id"_L1] = transaction.id;
     map["reference_number"_L1] = transaction.reference_number;
@@ -188,34 +120,10 @@ void CashTransactionModel::updateSummary(const QDateTime &startDate, const QDate
     setLoading(true);
     m_api->getSummary(startDate, endDate);
 }
-bool CashTransactionModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_transactions.count()) {
-            m_transactions[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
-}
+
 void CashTransactionModel::handleTransactionsReceived(const PaginatedCashTransactions &transactions)
 {
-    beginResetModel();
-    m_transactions = transactions.data;
-    endResetModel();
-
-    m_totalItems = transactions.total;
-    m_currentPage = transactions.currentPage;
-    m_totalPages = transactions.lastPage;
-
-    Q_EMIT totalItemsChanged();
-    Q_EMIT currentPageChanged();
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    updateHasCheckedItems();
+    receivePage(transactions);
 }
 
 void CashTransactionModel::handleTransactionsBySourceReceived(const PaginatedCashTransactions &transactions)
@@ -236,103 +144,7 @@ void CashTransactionModel::handleApiError(const QString &message, ApiStatus stat
     setLoading(false);
 }
 
-void CashTransactionModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void CashTransactionModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
-void CashTransactionModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_transactions.count()) {
-        m_transactions[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList CashTransactionModel::getCheckedTransactionIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &transaction : m_transactions) {
-        if (transaction.checked) {
-            checkedIds.append(transaction.id);
-        }
-    }
-    return checkedIds;
-}
-
-void CashTransactionModel::clearAllChecked()
-{
-    for (int i = 0; i < m_transactions.count(); ++i) {
-        if (m_transactions[i].checked) {
-            m_transactions[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void CashTransactionModel::toggleAllTransactionsChecked()
-{
-    bool allChecked = true;
-    for (const auto &transaction : m_transactions) {
-        if (!transaction.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_transactions.count(); ++i) {
-        m_transactions[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
-
 // Property setters
-void CashTransactionModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void CashTransactionModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void CashTransactionModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        m_currentPage = 1; // Reset to first page when searching
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void CashTransactionModel::setTransactionType(const QString &type)
 {
     if (m_transactionType != type) {
@@ -397,19 +209,4 @@ void CashTransactionModel::setEndDate(const QDateTime &date)
       //  refresh();
     }
 }
-void CashTransactionModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &transaction : m_transactions) {
-        if (transaction.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
 } // namespace NetworkApi
@@ -4,16 +4,37 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+constexpr ModelRole<Client> ClientRoleTable[] = {
+    memberRole<&Client::id>(ClientModel::IdRole, "id"),
+    memberRole<&Client::name>(ClientModel::NameRole, "name"),
+    memberRole<&Client::email>(ClientModel::EmailRole, "email"),
+    memberRole<&Client::phone>(ClientModel::PhoneRole, "phone"),
+    memberRole<&Client::address>(ClientModel::AddressRole, "address"),
+    memberRole<&Client::tax_number>(ClientModel::TaxNumberRole, "taxNumber"),
+    memberRole<&Client::payment_terms>(ClientModel::PaymentTermsRole, "paymentTerms"),
+    memberRole<&Client::notes>(ClientModel::NotesRole, "notes"),
+    memberRole<&Client::status>(ClientModel::StatusRole, "status"),
+    memberRole<&Client::balance>(ClientModel::BalanceRole, "balance"),
+};
+
+constexpr ModelColumn<Client> ClientColumns[] = {
+    memberColumn<&Client::id>(QT_TRANSLATE_NOOP("NetworkApi::ClientModel", "ID")),
+    memberColumn<&Client::name>(QT_TRANSLATE_NOOP("NetworkApi::ClientModel", "Name")),
+    memberColumn<&Client::email>(QT_TRANSLATE_NOOP("NetworkApi::ClientModel", "Email")),
+    memberColumn<&Client::phone>(QT_TRANSLATE_NOOP("NetworkApi::ClientModel", "Phone")),
+    memberColumn<&Client::status>(QT_TRANSLATE_NOOP("NetworkApi::ClientModel", "Type")),
+};
+
+} // namespace
+
 ClientModel::ClientModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<Client>(ClientRoleTable, ClientColumns, CheckedRole,
+                                   QStringLiteral("name"), QStringLiteral("asc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("name"))
-    , m_sortDirection(QStringLiteral("asc"))
-    , m_hasCheckedItems(false)
 {
 }
 
@@ -26,6 +47,7 @@ void ClientModel::setApi(ClientApi* api)
         connect(m_api, &ClientApi::errorClientsReceived, this, &ClientModel::handleClientError);
         connect(m_api, &ClientApi::clientCreated, this, &ClientModel::handleClientCreated);
         connect(m_api, &ClientApi::clientUpdated, this, &ClientModel::handleClientUpdated);
+        connect(m_api, &ClientApi::clientDetailsReceived, this, &ClientModel::handleClientDetails);
         connect(m_api, &ClientApi::clientDeleted, this, &ClientModel::handleClientDeleted);
 
 
@@ -33,105 +55,6 @@ void ClientModel::setApi(ClientApi* api)
       refresh();
 }
 
-int ClientModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_clients.count();
-}
-
-int ClientModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 5; // Adjust based on your needs
-}
-
-QVariant ClientModel::data(const QModelIndex &index, int role) const
-{
-    if (!index.isValid() || index.row() >= m_clients.count())
-        return QVariant();
-
-    const Client &client = m_clients.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return client.id;
-        case 1: return client.name;
-        case 2: return client.email;
-        case 3: return client.phone;
-        case 4: return client.status;
-        case 5: return client.balance;
-        }
-    } else {
-        switch (role) {
-        case IdRole: return client.id;
-        case NameRole: return client.name;
-        case EmailRole: return client.email;
-        case PhoneRole: return client.phone;
-        case AddressRole: return client.address;
-        case TaxNumberRole: return client.tax_number;
-        case PaymentTermsRole: return client.payment_terms;
-        case NotesRole: return client.notes;
-        case StatusRole: return client.status;
-        case BalanceRole: return client.balance;
-        case CheckedRole: return client.checked;
-        }
-    }
-
-    return QVariant();
-}
-
-QHash<int, QByteArray> ClientModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[NameRole] = "name";
-    roles[EmailRole] = "email";
-    roles[PhoneRole] = "phone";
-    roles[AddressRole] = "address";
-    roles[TaxNumberRole] = "taxNumber";
-    roles[PaymentTermsRole] = "paymentTerms";
-    roles[NotesRole] = "notes";
-    roles[StatusRole] = "status";
-    roles[BalanceRole] = "balance";
-    roles[CheckedRole] = "checked";
-    return roles;
-}
-
-
-QVariant ClientModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("ID");
-        case 1: return tr("Name");
-        case 2: return tr("Email");
-        case 3: return tr("Phone");
-        case 4: return tr("Type");
-        case 5: return tr("Balance");
-        case 6: return tr("Total Sales");
-        }
-    }
-    return QVariant();
-}
-
-bool ClientModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_clients.count()) {
-            m_clients[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
-}
-
 void ClientModel::refresh()
 {
     if (!m_api)
@@ -141,15 +64,6 @@ void ClientModel::refresh()
     m_api->getClients(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_currentType);
 }
 
-void ClientModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void ClientModel::createClient(const QVariantMap &clientData)
 {
     if (!m_api)
@@ -165,7 +79,16 @@ void ClientModel::updateClient(int id, const QVariantMap &clientData)
         return;
 
     setLoading(true);
-    m_api->updateClient(id, clientFromVariantMap(clientData));
+    Client client = clientFromVariantMap(clientData);
+    client.id = id;
+
+    // Only the members the user changed, so that edits made meanwhile on
+    // other tills are kept; a client never loaded in full is sent whole
+    const auto base = m_editBases.constFind(id);
+    if (base != m_editBases.cend())
+        m_api->patchClient(*base, client);
+    else
+        m_api->updateClient(id, client);
 }
 
 void ClientModel::deleteClient(int id)
@@ -179,94 +102,13 @@ void ClientModel::deleteClient(int id)
 
 QVariantMap ClientModel::getClient(int row) const
 {
-    if (row < 0 || row >= m_clients.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return clientToVariantMap(m_clients.at(row));
-}
-
-
-
-// Selection methods
-void ClientModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_clients.count()) {
-        m_clients[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList ClientModel::getCheckedClientIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &client : m_clients) {
-        if (client.checked) {
-            checkedIds.append(client.id);
-        }
-    }
-    return checkedIds;
-}
-
-void ClientModel::clearAllChecked()
-{
-    for (int i = 0; i < m_clients.count(); ++i) {
-        if (m_clients[i].checked) {
-            m_clients[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void ClientModel::toggleAllClientsChecked()
-{
-    bool allChecked = true;
-    for (const auto &client : m_clients) {
-        if (!client.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_clients.count(); ++i) {
-        m_clients[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
+    return clientToVariantMap(m_rows.at(row));
 }
 
 // Slots
-void ClientModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void ClientModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void ClientModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();
-    }
-}
-
 void ClientModel::filterByType(const QString &type)
 {
     if (m_currentType != type) {
@@ -278,24 +120,7 @@ void ClientModel::filterByType(const QString &type)
 // Private slots
 void ClientModel::handleClientsReceived(const PaginatedClients &clients)
 {
-    beginResetModel();
-    m_clients = clients.data;
-    endResetModel();
-
-    m_totalItems = clients.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = clients.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = clients.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    updateHasCheckedItems();
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
+    receivePage(clients);
 }
 
 void ClientModel::handleClientError(const QString &message, ApiStatus status)
@@ -306,9 +131,7 @@ void ClientModel::handleClientError(const QString &message, ApiStatus status)
 
 void ClientModel::handleClientCreated(const Client &client)
 {
-    beginInsertRows(QModelIndex(), m_clients.count(), m_clients.count());
-    m_clients.append(client);
-    endInsertRows();
+    appendEntity(client);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -317,54 +140,32 @@ void ClientModel::handleClientCreated(const Client &client)
 
 void ClientModel::handleClientUpdated(const Client &client)
 {
-    for (int i = 0; i < m_clients.count(); ++i) {
-        if (m_clients[i].id == client.id) {
-            m_clients[i] = client;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    if (m_editBases.contains(client.id))
+        m_editBases.insert(client.id, client);
+    replaceEntity(client);
 
     setLoading(false);
     setErrorMessage(QString());
     Q_EMIT clientUpdated();
 }
 
+void ClientModel::handleClientDetails(const Client &client)
+{
+    m_editBases.insert(client.id, client);
+    replaceEntity(client);
+}
+
 void ClientModel::handleClientDeleted(int id)
 {
-    for (int i = 0; i < m_clients.count(); ++i) {
-        if (m_clients[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_clients.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    m_editBases.remove(id);
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
     Q_EMIT clientDeleted();
 }
 
-
 // Private methods
-void ClientModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void ClientModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 Client ClientModel::clientFromVariantMap(const QVariantMap &map) const
 {
     Client client;
@@ -412,20 +213,4 @@ QVariantMap ClientModel::clientToVariantMap(const Client &client) const
 }
 
 
-void ClientModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &client : m_clients) {
-        if (client.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
-
 } // namespace NetworkApi
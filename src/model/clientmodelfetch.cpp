@@ -15,8 +15,10 @@ void ClientModelFetch::loadPage(int page)
 
     if (page > 0 && page <= m_totalPages && !m_loading) {
         setLoading(true);
+        m_appending = page > 1;
         // Pass the requested page instead of m_currentPage
-        m_api->getClients(m_searchQuery, m_sortField, m_sortDirection, page, m_currentType);
+        m_api->getClients(m_searchQuery, m_sortField, m_sortDirection, page, m_currentType,
+                          cursorFor(page));
     }
 }
 
@@ -26,37 +28,13 @@ void ClientModelFetch::handleClientsReceived(const PaginatedClients &clients)
              << clients.currentPage << "of" << clients.lastPage
              << "Items count:" << clients.data.count();
 
-    // Only clear for first page
-    if (clients.currentPage == 1) {
-        beginResetModel();
-        m_clients.clear();
-        endResetModel();
-    }
-
-    // Insert new rows
-    if (!clients.data.isEmpty()) {
-        beginInsertRows(QModelIndex(), m_clients.count(),
-                       m_clients.count() + clients.data.count() - 1);
-        m_clients.append(clients.data);
-        endInsertRows();
-    }
-
-    // Update pagination info after adding new data
-    m_totalItems = clients.total;
-    m_currentPage = clients.currentPage; // Update current page to received page
-    m_totalPages = clients.lastPage;
-
-    Q_EMIT totalItemsChanged();
-    Q_EMIT currentPageChanged();
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
+    // The first page replaces the rows, matched by id; the others are appended
+    receiveFetchedPage(clients);
 
     qDebug() << "ClientModelFetch::handleClientsReceived - After update:"
              << "Current page:" << m_currentPage
              << "Total items:" << m_totalItems
-             << "Total clients in model:" << m_clients.count();
+             << "Total clients in model:" << m_rows.count();
 }
 
 void ClientModelFetch::refresh()
@@ -64,10 +42,10 @@ void ClientModelFetch::refresh()
     if (!m_api)
         return;
 
+    // A cursor only leads forward, so refreshing starts over from the first page
     setLoading(true);
-    // Always use current page for refresh
-    m_api->getClients(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_currentType);
+    m_appending = false;
+    m_api->getClients(m_searchQuery, m_sortField, m_sortDirection, 1, m_currentType, cursorFor(1));
 }
 
-
 }
@@ -67,11 +67,14 @@ void DashboardModel::updateData()
     QString endDateStr = m_endDate.toString(QStringLiteral("yyyy-MM-dd"));
     qDebug() << "Updating dashboard data for timeframe:" << m_timeframe;
 
-    m_api->getOverallDashboard(m_timeframe);
-    m_api->getSalesAnalytics(m_timeframe, m_startDate, m_endDate);
-    m_api->getPurchaseAnalytics(m_timeframe, m_startDate, m_endDate);
-    m_api->getCustomerAnalytics(m_timeframe, m_startDate, m_endDate);
-    m_api->getInventoryAnalytics(m_timeframe, m_startDate, m_endDate);
+    // One round trip for the whole dashboard where the server allows it
+    m_api->batch([this]() {
+        m_api->getOverallDashboard(m_timeframe);
+        m_api->getSalesAnalytics(m_timeframe, m_startDate, m_endDate);
+        m_api->getPurchaseAnalytics(m_timeframe, m_startDate, m_endDate);
+        m_api->getCustomerAnalytics(m_timeframe, m_startDate, m_endDate);
+        m_api->getInventoryAnalytics(m_timeframe, m_startDate, m_endDate);
+    });
 }
 
 void DashboardModel::handleOverallDashboard(const DashboardOverview &data)
@@ -2,16 +2,94 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+QVariantMap invoiceItemToVariantMap(const InvoiceItem &item)
+{
+    QVariantMap map;
+    map["id"_L1] = item.id;
+    map["description"_L1] = item.description;
+    map["quantity"_L1] = item.quantity;
+    map["unitPrice"_L1] = item.unit_price;
+    map["totalPrice"_L1] = item.total_price;
+    map["notes"_L1] = item.notes;
+    return map;
+}
+
+QVariant invoiceItems(const Invoice &invoice)
+{
+    QVariantList items;
+    for (const auto &item : invoice.items) {
+        items.append(invoiceItemToVariantMap(item));
+    }
+    return items;
+}
+
+QVariant isQuote(const Invoice &invoice)
+{
+    return invoice.isQuote();
+}
+
+QVariant isInvoice(const Invoice &invoice)
+{
+    return invoice.isInvoice();
+}
+
+QVariant invoiceable(const Invoice &invoice)
+{
+    return QStringLiteral("%1 #%2").arg(invoice.invoiceable_type).arg(invoice.invoiceable_id);
+}
+
+QVariant paidAmount(const Invoice &invoice)
+{
+    return invoice.getPaidAmount();
+}
+
+QVariant actions(const Invoice &)
+{
+    return QString();
+}
+
+constexpr ModelRole<Invoice> InvoiceRoleTable[] = {
+    memberRole<&Invoice::id>(InvoiceModel::IdRole, "id"),
+    memberRole<&Invoice::team_id>(InvoiceModel::TeamIdRole, "teamId"),
+    memberRole<&Invoice::reference_number>(InvoiceModel::ReferenceNumberRole, "referenceNumber"),
+    memberRole<&Invoice::type>(InvoiceModel::TypeRole, "type"),
+    memberRole<&Invoice::invoiceable_type>(InvoiceModel::InvoiceableTypeRole, "invoiceableType"),
+    memberRole<&Invoice::invoiceable_id>(InvoiceModel::InvoiceableIdRole, "invoiceableId"),
+    memberRole<&Invoice::total_amount>(InvoiceModel::TotalAmountRole, "totalAmount"),
+    memberRole<&Invoice::tax_amount>(InvoiceModel::TaxAmountRole, "taxAmount"),
+    memberRole<&Invoice::discount_amount>(InvoiceModel::DiscountAmountRole, "discountAmount"),
+    memberRole<&Invoice::status>(InvoiceModel::StatusRole, "status"),
+    memberRole<&Invoice::payment_status>(InvoiceModel::PaymentStatusRole, "paymentStatus"),
+    memberRole<&Invoice::is_email_sent>(InvoiceModel::IsEmailSentRole, "isEmailSent"),
+    memberRole<&Invoice::issue_date>(InvoiceModel::IssueDateRole, "issueDate"),
+    memberRole<&Invoice::due_date>(InvoiceModel::DueDateRole, "dueDate"),
+    memberRole<&Invoice::notes>(InvoiceModel::NotesRole, "notes"),
+    memberRole<&Invoice::meta_data>(InvoiceModel::MetaDataRole, "metaData"),
+    {InvoiceModel::ItemsRole, "items", &invoiceItems},
+    {InvoiceModel::IsQuoteRole, "isQuote", &isQuote},
+    {InvoiceModel::IsInvoiceRole, "isInvoice", &isInvoice},
+};
+
+constexpr ModelColumn<Invoice> InvoiceColumns[] = {
+    memberColumn<&Invoice::issue_date>(QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Date")),
+    memberColumn<&Invoice::reference_number>(QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Reference")),
+    {QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Invoiceable"), &invoiceable},
+    memberColumn<&Invoice::status>(QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Status")),
+    memberColumn<&Invoice::total_amount>(QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Total")),
+    {QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Paid"), &paidAmount},
+    {QT_TRANSLATE_NOOP("NetworkApi::InvoiceModel", "Actions"), &actions},
+};
+
+} // namespace
+
 InvoiceModel::InvoiceModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<Invoice>(InvoiceRoleTable, InvoiceColumns, CheckedRole,
+                                    QStringLiteral("created_at"), QStringLiteral("desc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("created_at"))
-    , m_sortDirection(QStringLiteral("desc"))
-    , m_hasCheckedItems(false)
 {
 }
 
@@ -38,19 +116,6 @@ void InvoiceModel::setApi(InvoiceApi* api)
     refresh();
 }
 
-int InvoiceModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_invoices.count();
-}
-
-int InvoiceModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 7; // Date, Reference, Invoiceable, Status, Total, Paid, Actions
-}
 void InvoiceModel::setStartDate(const QDateTime &date)
 {
     if (m_startDate != date) {
@@ -72,116 +137,6 @@ void InvoiceModel::setEndDate(const QDateTime &date)
         // refresh();
     }
 }
-QVariant InvoiceModel::data(const QModelIndex &index, int role) const
-{
-    if (!index.isValid() || index.row() >= m_invoices.count())
-        return QVariant();
-
-    const Invoice &invoice = m_invoices.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return invoice.issue_date;
-        case 1: return invoice.reference_number;
-        case 2: return QStringLiteral("%1 #%2").arg(invoice.invoiceable_type)
-                    .arg(invoice.invoiceable_id);
-        case 3: return invoice.status;
-        case 4: return invoice.total_amount;
-        case 5: return invoice.getPaidAmount();
-        case 6: return QString(); // Actions column
-        }
-    } else {
-        switch (role) {
-        case IdRole: return invoice.id;
-        case TeamIdRole: return invoice.team_id;
-        case ReferenceNumberRole: return invoice.reference_number;
-        case TypeRole: return invoice.type;
-        case InvoiceableTypeRole: return invoice.invoiceable_type;
-        case InvoiceableIdRole: return invoice.invoiceable_id;
-        case TotalAmountRole: return invoice.total_amount;
-        case TaxAmountRole: return invoice.tax_amount;
-        case DiscountAmountRole: return invoice.discount_amount;
-        case StatusRole: return invoice.status;
-        case PaymentStatusRole: return invoice.payment_status;  // New role
-        case IsEmailSentRole: return invoice.is_email_sent;     // New role
-        case IssueDateRole: return invoice.issue_date;
-        case DueDateRole: return invoice.due_date;
-        case NotesRole: return invoice.notes;
-        case MetaDataRole: return invoice.meta_data;
-        case ItemsRole: {
-            QVariantList items;
-            for (const auto &item : invoice.items) {
-                items.append(invoiceItemToVariantMap(item));
-            }
-            return items;
-        }
-        case CheckedRole: return invoice.checked;
-        case IsQuoteRole: return invoice.isQuote();  // New role
-        case IsInvoiceRole: return invoice.isInvoice();  // New role
-        }
-    }
-
-    return QVariant();
-}
-
-QHash<int, QByteArray> InvoiceModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[TeamIdRole] = "teamId";
-    roles[ReferenceNumberRole] = "referenceNumber";
-    roles[TypeRole] = "type";  // New role
-    roles[InvoiceableTypeRole] = "invoiceableType";
-    roles[InvoiceableIdRole] = "invoiceableId";
-    roles[TotalAmountRole] = "totalAmount";
-    roles[TaxAmountRole] = "taxAmount";
-    roles[DiscountAmountRole] = "discountAmount";
-    roles[StatusRole] = "status";
-    roles[PaymentStatusRole] = "paymentStatus";  // New role
-    roles[IsEmailSentRole] = "isEmailSent";      // New role
-    roles[IssueDateRole] = "issueDate";
-    roles[DueDateRole] = "dueDate";
-    roles[NotesRole] = "notes";
-    roles[MetaDataRole] = "metaData";
-    roles[ItemsRole] = "items";
-    roles[CheckedRole] = "checked";
-    roles[IsQuoteRole] = "isQuote";             // New role
-    roles[IsInvoiceRole] = "isInvoice";         // New role
-    return roles;
-}
-
-
-QVariant InvoiceModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("Date");
-        case 1: return tr("Reference");
-        case 2: return tr("Invoiceable");
-        case 3: return tr("Status");
-        case 4: return tr("Total");
-        case 5: return tr("Paid");
-        case 6: return tr("Actions");
-        }
-    }
-    return QVariant();
-}
-
-bool InvoiceModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_invoices.count()) {
-            m_invoices[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
-}
 
 void InvoiceModel::refresh()
 {
@@ -192,15 +147,6 @@ void InvoiceModel::refresh()
     m_api->getInvoices(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_status, m_paymentStatus, m_startDate, m_endDate);
 }
 
-void InvoiceModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void InvoiceModel::createInvoice(const QVariantMap &invoiceData)
 {
     if (!m_api)
@@ -230,10 +176,10 @@ void InvoiceModel::deleteInvoice(int id)
 
 QVariantMap InvoiceModel::getInvoice(int row) const
 {
-    if (row < 0 || row >= m_invoices.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return invoiceToVariantMap(m_invoices.at(row));
+    return invoiceToVariantMap(m_rows.at(row));
 }
 
 void InvoiceModel::addPayment(int id, const QVariantMap &paymentData)
@@ -298,84 +244,6 @@ void InvoiceModel::getSummary(const QString &period)
     m_api->getSummary(period);
 }
 
-void InvoiceModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_invoices.count()) {
-        m_invoices[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList InvoiceModel::getCheckedInvoiceIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &invoice : m_invoices) {
-        if (invoice.checked) {
-            checkedIds.append(invoice.id);
-        }
-    }
-    return checkedIds;
-}
-
-void InvoiceModel::clearAllChecked()
-{
-    for (int i = 0; i < m_invoices.count(); ++i) {
-        if (m_invoices[i].checked) {
-            m_invoices[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void InvoiceModel::toggleAllInvoicesChecked()
-{
-    bool allChecked = true;
-    for (const auto &invoice : m_invoices) {
-        if (!invoice.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_invoices.count(); ++i) {
-        m_invoices[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
-
-void InvoiceModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void InvoiceModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void InvoiceModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();
-    }
-}
-
 void InvoiceModel::setStatus(const QString &status)
 {
     if (m_status != status) {
@@ -397,23 +265,7 @@ void InvoiceModel::setPaymentStatus(const QString &paymentStatus)
 // Private slots
 void InvoiceModel::handleInvoicesReceived(const PaginatedInvoices &invoices)
 {
-    beginResetModel();
-    m_invoices = invoices.data;
-    endResetModel();
-
-    m_totalItems = invoices.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = invoices.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = invoices.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    updateHasCheckedItems();
+    receivePage(invoices);
     Q_EMIT rowCountChanged();
 }
 
@@ -425,9 +277,7 @@ void InvoiceModel::handleInvoiceError(const QString &message, ApiStatus status)
 
 void InvoiceModel::handleInvoiceCreated(const Invoice &invoice)
 {
-    beginInsertRows(QModelIndex(), m_invoices.count(), m_invoices.count());
-    m_invoices.append(invoice);
-    endInsertRows();
+    appendEntity(invoice);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -436,14 +286,7 @@ void InvoiceModel::handleInvoiceCreated(const Invoice &invoice)
 
 void InvoiceModel::handleInvoiceUpdated(const Invoice &invoice)
 {
-    for (int i = 0; i < m_invoices.count(); ++i) {
-        if (m_invoices[i].id == invoice.id) {
-            m_invoices[i] = invoice;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, createIndex(i, columnCount() - 1));
-            break;
-        }
-    }
+    replaceEntity(invoice);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -452,14 +295,7 @@ void InvoiceModel::handleInvoiceUpdated(const Invoice &invoice)
 
 void InvoiceModel::handleInvoiceDeleted(int id)
 {
-    for (int i = 0; i < m_invoices.count(); ++i) {
-        if (m_invoices[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_invoices.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -519,22 +355,6 @@ void InvoiceModel::handleInvoiceMarkedAsEmailSent(const QVariantMap &invoice)
 }
 
 // Private methods
-void InvoiceModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void InvoiceModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 Invoice InvoiceModel::invoiceFromVariantMap(const QVariantMap &map) const
 {
     Invoice invoice;
@@ -609,18 +429,6 @@ InvoiceItem InvoiceModel::invoiceItemFromVariantMap(const QVariantMap &map) cons
     return item;
 }
 
-QVariantMap InvoiceModel::invoiceItemToVariantMap(const InvoiceItem &item) const
-{
-    QVariantMap map;
-    map["id"_L1] = item.id;
-    map["description"_L1] = item.description;
-    map["quantity"_L1] = item.quantity;
-    map["unitPrice"_L1] = item.unit_price;
-    map["totalPrice"_L1] = item.total_price;
-    map["notes"_L1] = item.notes;
-    return map;
-}
-
 InvoicePayment InvoiceModel::paymentFromVariantMap(const QVariantMap &map) const
 {
     InvoicePayment payment;
@@ -632,20 +440,4 @@ InvoicePayment InvoiceModel::paymentFromVariantMap(const QVariantMap &map) const
     return payment;
 }
 
-void InvoiceModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &invoice : m_invoices) {
-        if (invoice.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
-
 } // namespace NetworkApi
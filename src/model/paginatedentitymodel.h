@@ -0,0 +1,228 @@
+// paginatedentitymodel.h
+#ifndef PAGINATEDENTITYMODEL_H
+#define PAGINATEDENTITYMODEL_H
+
+#include "paginatedmodel.h"
+#include "rowdiff.h"
+#include "rowindex.h"
+#include <QCoreApplication>
+#include <QList>
+#include <cstddef>
+#include <utility>
+
+namespace NetworkApi {
+
+// One role of an entity model: the name QML binds and how a row answers it.
+// Models describe their roles and table columns as constexpr tables of
+// these; see clientmodel.cpp.
+template<typename Row>
+struct ModelRole {
+    int role;
+    const char *name;
+    QVariant (*value)(const Row &row);
+};
+
+// One table column: its header, translated in the model's context
+// (QT_TRANSLATE_NOOP("NetworkApi::ClientModel", "Name")), and its DisplayRole
+// value
+template<typename Row>
+struct ModelColumn {
+    const char *title;
+    QVariant (*value)(const Row &row);
+};
+
+namespace ModelFields {
+
+template<auto Member>
+struct MemberTraits;
+
+template<typename S, typename V, V S::*Member>
+struct MemberTraits<Member> {
+    using Struct = S;
+};
+
+template<auto Member>
+using StructOf = typename MemberTraits<Member>::Struct;
+
+template<auto Member>
+QVariant memberValue(const StructOf<Member> &row)
+{
+    return QVariant::fromValue(row.*Member);
+}
+
+// A role or column showing the member as is
+template<auto Member>
+constexpr ModelRole<StructOf<Member>> memberRole(int role, const char *name)
+{
+    return {role, name, &memberValue<Member>};
+}
+template<auto Member>
+constexpr ModelColumn<StructOf<Member>> memberColumn(const char *title)
+{
+    return {title, &memberValue<Member>};
+}
+
+} // namespace ModelFields
+
+// The rows of a paginated entity model and everything that only depends on
+// them: data(), roleNames() and headerData() from the model's tables, the
+// checked role, lookups by id, and the page, create, update and delete
+// handling every entity model shares. Rows are structs with an `id` member;
+// the checked state is kept by PaginatedModel, not in them.
+//
+// A model derives from PaginatedEntityModel<Entity> with Q_OBJECT, passes
+// its tables to the constructor and adds its API calls and signals.
+template<typename Row>
+class PaginatedEntityModel : public PaginatedModel
+{
+    friend struct RowDiff<PaginatedEntityModel<Row>>;
+
+public:
+    // QAbstractTableModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : int(m_rows.size());
+    }
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override
+    {
+        return parent.isValid() ? 0 : int(m_columnCount);
+    }
+
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
+    {
+        if (!index.isValid() || index.row() >= m_rows.size())
+            return QVariant();
+
+        const Row &row = m_rows.at(index.row());
+        if (role == Qt::DisplayRole || role == Qt::EditRole) {
+            if (index.column() < int(m_columnCount))
+                return m_columns[index.column()].value(row);
+            return QVariant();
+        }
+        if (role == m_checkedRole)
+            return m_selection.isSelected(index.row());
+        for (std::size_t i = 0; i < m_roleCount; ++i) {
+            if (m_roles[i].role == role)
+                return m_roles[i].value(row);
+        }
+        return QVariant();
+    }
+
+    QHash<int, QByteArray> roleNames() const override
+    {
+        QHash<int, QByteArray> roles;
+        roles.reserve(qsizetype(m_roleCount) + 1);
+        for (std::size_t i = 0; i < m_roleCount; ++i)
+            roles[m_roles[i].role] = m_roles[i].name;
+        roles[m_checkedRole] = "checked";
+        return roles;
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+        if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+            return QVariant();
+        if (section < 0 || section >= int(m_columnCount))
+            return QVariant();
+        return QCoreApplication::translate(metaObject()->className(), m_columns[section].title);
+    }
+
+    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override
+    {
+        if (role != m_checkedRole || !index.isValid() || index.row() >= m_rows.size())
+            return false;
+        if (m_selection.setSelected(index.row(), value.toBool())) {
+            Q_EMIT dataChanged(index, index, {role});
+            updateHasCheckedItems();
+        }
+        return true;
+    }
+
+protected:
+    template<std::size_t RoleCount, std::size_t ColumnCount>
+    PaginatedEntityModel(const ModelRole<Row> (&roles)[RoleCount], const ModelColumn<Row> (&columns)[ColumnCount],
+                         int checkedRole, const QString &sortField, const QString &sortDirection, QObject *parent)
+        : PaginatedModel(sortField, sortDirection, checkedRole, parent)
+        , m_roles(roles)
+        , m_roleCount(RoleCount)
+        , m_columns(columns)
+        , m_columnCount(ColumnCount)
+        , m_rowIndex(this, [this](int row) { return m_rows.at(row).id; })
+    {
+    }
+
+    int rowId(int row) const override { return m_rows.at(row).id; }
+    // The row showing the entity, -1 when none does
+    int rowOf(int id) const { return m_rowIndex.row(id); }
+
+    // A page shown on its own (the tables) replaces the rows, matched by id
+    template<typename Page>
+    void receivePage(const Page &page)
+    {
+        RowDiff<PaginatedEntityModel<Row>>::apply(*this, m_rows, page.data);
+        setPageInfo(page.total, page.currentPage, page.lastPage);
+        setLoading(false);
+        setErrorMessage(QString());
+    }
+
+    // A page for an infinite scroll list: the first one replaces the rows,
+    // matched by id, every further one is appended
+    template<typename Page>
+    void receiveFetchedPage(const Page &page)
+    {
+        const bool append = std::exchange(m_appending, false) || page.currentPage > 1;
+        if (!append) {
+            RowDiff<PaginatedEntityModel<Row>>::apply(*this, m_rows, page.data);
+        } else if (!page.data.isEmpty()) {
+            beginInsertRows(QModelIndex(), int(m_rows.size()), int(m_rows.size() + page.data.size()) - 1);
+            m_rows.append(page.data);
+            endInsertRows();
+        }
+        setFetchedPageInfo(page.total, page.currentPage, page.lastPage, page.nextCursor, append);
+        setLoading(false);
+        setErrorMessage(QString());
+    }
+
+    void appendEntity(const Row &entity)
+    {
+        beginInsertRows(QModelIndex(), int(m_rows.size()), int(m_rows.size()));
+        m_rows.append(entity);
+        endInsertRows();
+    }
+
+    // Whether a row showed the entity
+    bool replaceEntity(const Row &entity)
+    {
+        const int row = m_rowIndex.row(entity.id);
+        if (row < 0)
+            return false;
+        m_rows[row] = entity;
+        Q_EMIT dataChanged(createIndex(row, 0), createIndex(row, columnCount() - 1));
+        return true;
+    }
+
+    bool removeEntity(int id)
+    {
+        const int row = m_rowIndex.row(id);
+        if (row < 0)
+            return false;
+        beginRemoveRows(QModelIndex(), row, row);
+        m_rows.removeAt(row);
+        endRemoveRows();
+        return true;
+    }
+
+    QList<Row> m_rows;
+
+private:
+    const ModelRole<Row> *m_roles;
+    std::size_t m_roleCount;
+    const ModelColumn<Row> *m_columns;
+    std::size_t m_columnCount;
+    RowIndex m_rowIndex; // row of each id
+};
+
+} // namespace NetworkApi
+
+#endif // PAGINATEDENTITYMODEL_H
@@ -0,0 +1,153 @@
+// paginatedmodel.cpp
+#include "paginatedmodel.h"
+
+namespace NetworkApi {
+
+PaginatedModel::PaginatedModel(const QString &sortField, const QString &sortDirection, int checkedRole, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_sortField(sortField)
+    , m_sortDirection(sortDirection)
+    , m_checkedRole(checkedRole)
+    , m_selection(this, [this]() { updateHasCheckedItems(); })
+{
+}
+
+void PaginatedModel::loadPage(int page)
+{
+    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
+        m_currentPage = page;
+        Q_EMIT currentPageChanged();
+        refresh();
+    }
+}
+
+// Selection methods
+void PaginatedModel::setChecked(int row, bool checked)
+{
+    if (m_selection.setSelected(row, checked)) {
+        QModelIndex index = createIndex(row, 0);
+        Q_EMIT dataChanged(index, index, {m_checkedRole});
+        updateHasCheckedItems();
+    }
+}
+
+void PaginatedModel::clearAllChecked()
+{
+    const RowSelection::Span span = m_selection.clear();
+    if (!span.isEmpty())
+        Q_EMIT dataChanged(createIndex(span.first, 0), createIndex(span.last, 0), {m_checkedRole});
+    updateHasCheckedItems();
+}
+
+void PaginatedModel::toggleAllChecked()
+{
+    const RowSelection::Span span = m_selection.isFull() ? m_selection.clear() : m_selection.selectAll();
+    if (!span.isEmpty())
+        Q_EMIT dataChanged(createIndex(span.first, 0), createIndex(span.last, 0), {m_checkedRole});
+    updateHasCheckedItems();
+}
+
+QVariantList PaginatedModel::checkedIds() const
+{
+    QVariantList checkedIds;
+    const QList<int> rows = m_selection.rows();
+    checkedIds.reserve(rows.size());
+    for (int row : rows)
+        checkedIds.append(rowId(row));
+    return checkedIds;
+}
+
+// Slots
+void PaginatedModel::setSortField(const QString &field)
+{
+    if (m_sortField != field) {
+        m_sortField = field;
+        Q_EMIT sortFieldChanged();
+        refresh();
+    }
+}
+
+void PaginatedModel::setSortDirection(const QString &direction)
+{
+    if (m_sortDirection != direction) {
+        m_sortDirection = direction;
+        Q_EMIT sortDirectionChanged();
+        refresh();
+    }
+}
+
+void PaginatedModel::setSearchQuery(const QString &query)
+{
+    if (m_searchQuery != query) {
+        m_searchQuery = query;
+        Q_EMIT searchQueryChanged();
+        refresh();
+    }
+}
+
+// Protected methods
+void PaginatedModel::setLoading(bool loading)
+{
+    if (m_loading != loading) {
+        m_loading = loading;
+        Q_EMIT loadingChanged();
+    }
+}
+
+void PaginatedModel::setErrorMessage(const QString &message)
+{
+    if (m_errorMessage != message) {
+        m_errorMessage = message;
+        Q_EMIT errorMessageChanged();
+    }
+}
+
+void PaginatedModel::updateHasCheckedItems()
+{
+    const bool hasChecked = !m_selection.isEmpty();
+    if (hasChecked != m_hasCheckedItems) {
+        m_hasCheckedItems = hasChecked;
+        Q_EMIT hasCheckedItemsChanged();
+    }
+}
+
+void PaginatedModel::setPageInfo(int total, int currentPage, int lastPage)
+{
+    m_totalItems = total;
+    Q_EMIT totalItemsChanged();
+
+    m_currentPage = currentPage;
+    Q_EMIT currentPageChanged();
+
+    m_totalPages = lastPage;
+    Q_EMIT totalPagesChanged();
+}
+
+void PaginatedModel::setFetchedPageInfo(int total, int currentPage, int lastPage, const QString &nextCursor, bool appended)
+{
+    m_nextCursor = nextCursor;
+    if (lastPage > 0) {
+        m_totalItems = total;
+        m_currentPage = currentPage;
+        m_totalPages = lastPage;
+    } else {
+        m_totalItems = rowCount();
+        m_currentPage = appended ? m_currentPage + 1 : 1;
+        m_totalPages = m_nextCursor.isEmpty() ? m_currentPage : m_currentPage + 1;
+    }
+
+    Q_EMIT totalItemsChanged();
+    Q_EMIT currentPageChanged();
+    Q_EMIT totalPagesChanged();
+}
+
+std::optional<QString> PaginatedModel::cursorFor(int page) const
+{
+    if (page == 1)
+        return QString();
+    if (!m_nextCursor.isEmpty())
+        return m_nextCursor;
+    return std::nullopt;
+}
+
+} // namespace NetworkApi
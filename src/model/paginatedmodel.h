@@ -0,0 +1,112 @@
+// paginatedmodel.h
+#ifndef PAGINATEDMODEL_H
+#define PAGINATEDMODEL_H
+
+#include "rowselection.h"
+#include <QAbstractTableModel>
+#include <optional>
+
+namespace NetworkApi {
+
+// What every paginated entity model shows QML besides its rows: loading and
+// error state, page numbers and totals, sort and search, and which rows are
+// checked. Not a template so that moc can see the properties and signals;
+// the rows themselves live in PaginatedEntityModel<Row>.
+class PaginatedModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
+    Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
+    Q_PROPERTY(int totalItems READ totalItems NOTIFY totalItemsChanged)
+    Q_PROPERTY(int currentPage READ currentPage NOTIFY currentPageChanged)
+    Q_PROPERTY(int totalPages READ totalPages NOTIFY totalPagesChanged)
+    Q_PROPERTY(QString sortField READ sortField WRITE setSortField NOTIFY sortFieldChanged)
+    Q_PROPERTY(QString sortDirection READ sortDirection WRITE setSortDirection NOTIFY sortDirectionChanged)
+    Q_PROPERTY(QString searchQuery READ searchQuery WRITE setSearchQuery NOTIFY searchQueryChanged)
+    Q_PROPERTY(bool hasCheckedItems READ hasCheckedItems NOTIFY hasCheckedItemsChanged)
+    Q_PROPERTY(int rowCount READ rowCount NOTIFY rowCountChanged)
+
+public:
+    // Properties
+    bool loading() const { return m_loading; }
+    QString errorMessage() const { return m_errorMessage; }
+    int totalItems() const { return m_totalItems; }
+    int currentPage() const { return m_currentPage; }
+    int totalPages() const { return m_totalPages; }
+    QString sortField() const { return m_sortField; }
+    QString sortDirection() const { return m_sortDirection; }
+    QString searchQuery() const { return m_searchQuery; }
+    bool hasCheckedItems() const { return m_hasCheckedItems; }
+
+    // Asks the API for the current page with the current sort and search
+    Q_INVOKABLE virtual void refresh() = 0;
+    Q_INVOKABLE virtual void loadPage(int page);
+
+    // Selection methods
+    Q_INVOKABLE void setChecked(int row, bool checked);
+    Q_INVOKABLE void clearAllChecked();
+    // Unchecks every row when all are checked, checks them all otherwise
+    Q_INVOKABLE void toggleAllChecked();
+    // Ids of the checked rows, in row order
+    Q_INVOKABLE QVariantList checkedIds() const;
+
+public Q_SLOTS:
+    void setSortField(const QString &field);
+    void setSortDirection(const QString &direction);
+    void setSearchQuery(const QString &query);
+
+Q_SIGNALS:
+    void loadingChanged();
+    void errorMessageChanged();
+    void totalItemsChanged();
+    void currentPageChanged();
+    void totalPagesChanged();
+    void sortFieldChanged();
+    void sortDirectionChanged();
+    void searchQueryChanged();
+    void hasCheckedItemsChanged();
+    void rowCountChanged();
+
+protected:
+    PaginatedModel(const QString &sortField, const QString &sortDirection, int checkedRole, QObject *parent);
+
+    // Id of the entity shown in row
+    virtual int rowId(int row) const = 0;
+
+    void setLoading(bool loading);
+    void setErrorMessage(const QString &message);
+    void updateHasCheckedItems();
+
+    // Totals and page numbers of a page shown on its own (the tables)
+    void setPageInfo(int total, int currentPage, int lastPage);
+    // Totals and page numbers after a page was received for an infinite
+    // scroll list, appended or not. Cursor pages carry no totals, so with
+    // lastPage 0 there is one more page for as long as there is a cursor.
+    void setFetchedPageInfo(int total, int currentPage, int lastPage, const QString &nextCursor, bool appended);
+    // Keyset pagination for infinite scroll lists: page 1 starts from an
+    // empty cursor, every further page from the next_cursor of the last one
+    // received. Falls back to page numbers when the server sends no cursors.
+    std::optional<QString> cursorFor(int page) const;
+
+    bool m_loading = false;
+    QString m_errorMessage;
+    int m_totalItems = 0;
+    int m_currentPage = 1;
+    int m_totalPages = 1;
+    QString m_sortField;
+    QString m_sortDirection;
+    QString m_searchQuery;
+    QString m_nextCursor;
+    // Set by loadPage() of infinite scroll lists while the next page is on its way
+    bool m_appending = false;
+    int m_checkedRole;
+    RowSelection m_selection; // checked rows
+
+private:
+    bool m_hasCheckedItems = false;
+};
+
+} // namespace NetworkApi
+
+#endif // PAGINATEDMODEL_H
@@ -1,18 +1,73 @@
-
 #include "productmodel.h"
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+QVariant productUnitName(const Product &product)
+{
+    return product.unit.name;
+}
+
+QVariant productPackages(const Product &product)
+{
+    // Delegates read this on every rebind while scrolling
+    if (product.packagesValue.isValid())
+        return product.packagesValue;
+    QVariantList packages;
+    packages.reserve(product.packages.size());
+    for (const auto &package : product.packages) {
+        QVariantMap packageMap;
+        packageMap["id"_L1] = package.id;
+        packageMap["name"_L1] = package.name;
+        packageMap["pieces_per_package"_L1] = package.pieces_per_package;
+        packageMap["purchase_price"_L1] = package.purchase_price;
+        packageMap["selling_price"_L1] = package.selling_price;
+        packageMap["barcode"_L1] = package.barcode;
+        packages.append(packageMap);
+    }
+    product.packagesValue = packages;
+    return product.packagesValue;
+}
+
+constexpr ModelRole<Product> ProductRoleTable[] = {
+    memberRole<&Product::id>(ProductModel::IdRole, "id"),
+    memberRole<&Product::reference>(ProductModel::ReferenceRole, "reference"),
+    memberRole<&Product::name>(ProductModel::NameRole, "name"),
+    memberRole<&Product::description>(ProductModel::DescriptionRole, "description"),
+    memberRole<&Product::price>(ProductModel::PriceRole, "price"),
+    memberRole<&Product::purchase_price>(ProductModel::Purchase_PriceRole, "purchase_price"),
+    memberRole<&Product::expiredDate>(ProductModel::ExpiredDateRole, "expiredDate"),
+    memberRole<&Product::quantity>(ProductModel::QuantityRole, "quantity"),
+    {ProductModel::ProductUnitRole, "productUnit", &productUnitName},
+    memberRole<&Product::sku>(ProductModel::SkuRole, "sku"),
+    memberRole<&Product::minStockLevel>(ProductModel::MinStockLevelRole, "minStockLevel"),
+    {ProductModel::PackagesRole, "packages", &productPackages},
+};
+
+constexpr ModelColumn<Product> ProductColumns[] = {
+    memberColumn<&Product::id>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "ID")),
+    memberColumn<&Product::reference>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Reference")),
+    memberColumn<&Product::name>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Name")),
+    memberColumn<&Product::description>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Description")),
+    memberColumn<&Product::price>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Price")),
+    memberColumn<&Product::purchase_price>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Purchase Price")),
+    memberColumn<&Product::expiredDate>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Expired Date")),
+    memberColumn<&Product::quantity>(QT_TRANSLATE_NOOP("NetworkApi::ProductModel", "Quantity")),
+};
+
+} // namespace
+
 ProductModel::ProductModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<Product>(ProductRoleTable, ProductColumns, CheckedRole,
+                                    QStringLiteral("created_at"), QStringLiteral("desc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("created_at"))
-    , m_sortDirection(QStringLiteral("desc"))
     , m_lowStockFilter(false)
+    , m_visibleRoles({QStringLiteral("id"), QStringLiteral("checked"), QStringLiteral("reference"),
+                      QStringLiteral("name"), QStringLiteral("description"), QStringLiteral("price"),
+                      QStringLiteral("quantity"), QStringLiteral("minStockLevel"), QStringLiteral("productUnit")})
 {
 }
 
@@ -27,202 +82,59 @@ void ProductModel::setApi(ProductApi* api)
         connect(m_api, &ProductApi::productUpdated, this, &ProductModel::handleProductUpdated);
         connect(m_api, &ProductApi::productDeleted, this, &ProductModel::handleProductDeleted);
         connect(m_api, &ProductApi::stockUpdated, this, &ProductModel::handleStockUpdated);
+        connect(m_api, &ProductApi::productDetailsReceived, this, &ProductModel::handleProductDetails);
 
 
     }
      refresh();
 }
 
-int ProductModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_products.count();
-}
-
-int ProductModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 8; // Number of columns in our data
-}
-// QVariant ProductModel::data(const QModelIndex &index, int role) const
-// {
-//     if (!index.isValid() || index.row() >= m_products.count())
-//         return QVariant();
-
-//     const Product &product = m_products.at(index.row());
-
-//     switch (role) {
-//     case IdRole: return product.id;
-//     case ReferenceRole: return product.reference;
-//     case NameRole: return product.name;
-//     case DescriptionRole: return product.description;
-//     case PriceRole: return product.price;
-//     case ExpiredDateRole: return product.expiredDate;
-//     case QuantityRole: return product.quantity;
-//     case ProductUnitRole: return product.unit.name;
-//     case SkuRole: return product.sku;
-//     case BarcodeRole: return product.barcode;
-//     case MinStockLevelRole: return product.minStockLevel;
-//     case MaxStockLevelRole: return product.maxStockLevel;
-//     case ReorderPointRole: return product.reorderPoint;
-//     case LocationRole: return product.location;
-//     default: return QVariant();
-//     }
-// }
-QVariant ProductModel::data(const QModelIndex &index, int role) const
+void ProductModel::refresh()
 {
-    if (!index.isValid() || index.row() >= m_products.count())
-        return QVariant();
-
-    const Product &product = m_products.at(index.row());
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return product.id;
-        case 1: return product.reference;
-        case 2: return product.name;
-        case 3: return product.description;
-        case 4: return product.price;
-        case 5: return product.purchase_price;
-        case 6: return product.expiredDate;
-        case 7: return product.quantity;
-        case 8: return product.unit.name;
-        case 9: return product.sku;
-            // case 9: return product.barcode;
-        case 10: return product.minStockLevel;
-            // case 11: return product.maxStockLevel;
-            // case 12: return product.reorderPoint;
-            // case 13: return product.location;
-        }
-    } else if (role >= IdRole) {
-        switch (role) {
-        case IdRole: return product.id;
-        case ReferenceRole: return product.reference;
-        case NameRole: return product.name;
-        case DescriptionRole: return product.description;
-        case PriceRole: return product.price;
-        case Purchase_PriceRole : return product.purchase_price;
-        case ExpiredDateRole: return product.expiredDate;
-        case QuantityRole: return product.quantity;
-        case ProductUnitRole: return product.unit.name;
-        case SkuRole: return product.sku;
-            // case BarcodeRole: return product.barcode;
-        case MinStockLevelRole: return product.minStockLevel;
-        case PackagesRole: {
-            QVariantList packages;
-            for (const auto &package : product.packages) {
-                QVariantMap packageMap;
-                packageMap["id"_L1] = package.id;
-                packageMap["name"_L1] = package.name;
-                packageMap["pieces_per_package"_L1] = package.pieces_per_package;
-                packageMap["purchase_price"_L1] = package.purchase_price;
-                packageMap["selling_price"_L1] = package.selling_price;
-                packageMap["barcode"_L1] = package.barcode;
-                packages.append(packageMap);
-            }
-            return packages;
-        }
-            // case MaxStockLevelRole: return product.maxStockLevel;
-            // case ReorderPointRole: return product.reorderPoint;
-            // case LocationRole: return product.location;
-        }
-    }
-    if (role == CheckedRole) {
-        if (index.row() < m_products.count()) {
-            return m_products[index.row()].checked;
-        }
-    }
-
-
-    return QVariant();
+    if (!m_api)
+        return;
+    setLoading(true);
+    m_api->getProducts(m_searchQuery, m_sortField, m_sortDirection,m_currentPage, m_lowStockFilter,
+                       false, QString(), listFieldset());
 }
 
-// QHash<int, QByteArray> ProductModel::roleNames() const
-// {
-//     QHash<int, QByteArray> roles;
-//     roles[IdRole] = "id";
-//     roles[ReferenceRole] = "reference";
-//     roles[NameRole] = "name";
-//     roles[DescriptionRole] = "description";
-//     roles[PriceRole] = "price";
-//     roles[ExpiredDateRole] = "expiredDate";
-//     roles[QuantityRole] = "quantity";
-//     roles[ProductUnitRole] = "productUnit";
-//     roles[SkuRole] = "sku";
-//     roles[BarcodeRole] = "barcode";
-//     roles[MinStockLevelRole] = "minStockLevel";
-//     roles[MaxStockLevelRole] = "maxStockLevel";
-//     roles[ReorderPointRole] = "reorderPoint";
-//     roles[LocationRole] = "location";
-//     roles[Qt::DisplayRole] = "display"; // Add this line
-//     return roles;
-// }
-QHash<int, QByteArray> ProductModel::roleNames() const
+void ProductModel::setVisibleRoles(const QStringList &roles)
 {
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[ReferenceRole] = "reference";
-    roles[NameRole] = "name";
-    roles[DescriptionRole] = "description";
-    roles[PriceRole] = "price";
-    roles[Purchase_PriceRole] = "purchase_price";
-    roles[ExpiredDateRole] = "expiredDate";
-    roles[QuantityRole] = "quantity";
-    roles[ProductUnitRole] = "productUnit";
-    roles[SkuRole] = "sku";
-    //roles[BarcodeRole] = "barcode";
-    roles[MinStockLevelRole] = "minStockLevel";
-    roles[PackagesRole] = "packages";
-    roles[CheckedRole] = "checked";
-    // roles[MaxStockLevelRole] = "maxStockLevel";
-    // roles[ReorderPointRole] = "reorderPoint";
-    // roles[LocationRole] = "location";
-    return roles;
+    if (m_visibleRoles == roles)
+        return;
+    m_visibleRoles = roles;
+    Q_EMIT visibleRolesChanged();
+    refresh();
 }
 
-QVariant ProductModel::headerData(int section, Qt::Orientation orientation, int role) const
+Fieldset ProductModel::listFieldset() const
 {
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("ID");
-        case 1: return tr("Reference");
-        case 2: return tr("Name");
-        case 3: return tr("Description");
-        case 4: return tr("Price");
-        case 5: return tr("Purchase Price");
-        case 6: return tr("Expired Date");
-        case 7: return tr("Quantity");
-        case 8: return tr("Unit");
-        case 9: return tr("SKU");
-            //  case 9: return tr("Barcode");
-        case 10: return tr("Min Stock");
-            // case 11: return tr("Max Stock");
-            // case 12: return tr("Reorder Point");
-            // case 13: return tr("Location");
-        }
-    }
-    return QVariant();
+    return fieldsetForRoles(m_visibleRoles, {
+        {"reference"_L1, "reference"_L1, {}},
+        {"name"_L1, "name"_L1, {}},
+        {"description"_L1, "description"_L1, {}},
+        {"price"_L1, "price"_L1, {}},
+        {"purchase_price"_L1, "purchase_price"_L1, {}},
+        {"expiredDate"_L1, "expired_date"_L1, {}},
+        {"quantity"_L1, "quantity"_L1, {}},
+        {"productUnit"_L1, "product_unit_id"_L1, "unit"_L1},
+        {"sku"_L1, "sku"_L1, {}},
+        {"minStockLevel"_L1, "min_stock_level"_L1, {}},
+        {"packages"_L1, {}, "packages"_L1},
+    });
 }
 
-void ProductModel::refresh()
+void ProductModel::fetchDetails(int row)
 {
-    if (!m_api)
+    if (!m_api || row < 0 || row >= m_rows.count())
         return;
-    setLoading(true);
-    m_api->getProducts(m_searchQuery, m_sortField, m_sortDirection,m_currentPage, m_lowStockFilter);
+    m_api->getProduct(m_rows.at(row).id);
 }
 
-void ProductModel::loadPage(int page)
+void ProductModel::handleProductDetails(const Product &product)
 {
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
+    m_editBases.insert(product.id, product);
+    replaceEntity(product);
 }
 
 void ProductModel::createProduct(const QVariantMap &productData)
@@ -240,7 +152,16 @@ void ProductModel::updateProduct(int id, const QVariantMap &productData)
         return;
 
     setLoading(true);
-    m_api->updateProduct(id, productFromVariantMap(productData));
+    Product product = productFromVariantMap(productData);
+    product.id = id;
+
+    // Only the members the user changed, so that edits made meanwhile on
+    // other tills are kept; a product never loaded in full is sent whole
+    const auto base = m_editBases.constFind(id);
+    if (base != m_editBases.cend())
+        m_api->patchProduct(*base, product);
+    else
+        m_api->updateProduct(id, product);
 }
 
 void ProductModel::deleteProduct(int id)
@@ -264,10 +185,10 @@ void ProductModel::updateStock(int id, int quantity, const QString &operation)
 
 QVariantMap ProductModel::getProduct(int row) const
 {
-    if (row < 0 || row >= m_products.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return productToVariantMap(m_products.at(row));
+    return productToVariantMap(m_rows.at(row));
 }
 
 void ProductModel::filterLowStock(bool enabled)
@@ -277,71 +198,12 @@ void ProductModel::filterLowStock(bool enabled)
         refresh();
     }
 }
-void ProductModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();  // Refresh data if needed after sort field changes
-    }
-}
-void ProductModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();  // Refresh data if needed after sort direction changes
-    }
-}
 
-void ProductModel::setSearchQuery(const QString &query)
+void ProductModel::handleProductsReceived(const PaginatedProducts &products)
 {
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();  // Refresh data based on search query
-    }
+    receivePage(products);
 }
-// void ProductModel::handleProductsReceived(const PaginatedProducts &products)
-// {
-//     beginResetModel();
-//     m_products = products.data;
-//     endResetModel();
-
-//     m_totalItems = products.total;
-//     Q_EMIT totalItemsChanged();
-
-//     m_currentPage = products.currentPage;
-//     Q_EMIT currentPageChanged();
-
-//     m_totalPages = products.lastPage;
-//     Q_EMIT totalPagesChanged();
-
-//     setLoading(false);
-//     setErrorMessage(QString());
-// }
-void ProductModel::handleProductsReceived(const PaginatedProducts& products)
-{
-    beginResetModel();
 
-    m_products = products.data;
-    endResetModel();
-
-    m_totalItems = products.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = products.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = products.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    // Q_EMIT a signal to notify the view that the data has changed
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
-}
 void ProductModel::handleProductError(const QString &message, ApiStatus status)
 {
     setLoading(false);
@@ -350,9 +212,7 @@ void ProductModel::handleProductError(const QString &message, ApiStatus status)
 
 void ProductModel::handleProductCreated(const Product &product)
 {
-    beginInsertRows(QModelIndex(), m_products.count(), m_products.count());
-    m_products.append(product);
-    endInsertRows();
+    appendEntity(product);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -361,14 +221,9 @@ void ProductModel::handleProductCreated(const Product &product)
 
 void ProductModel::handleProductUpdated(const Product &product)
 {
-    for (int i = 0; i < m_products.count(); ++i) {
-        if (m_products[i].id == product.id) {
-            m_products[i] = product;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    if (m_editBases.contains(product.id))
+        m_editBases.insert(product.id, product);
+    replaceEntity(product);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -377,14 +232,8 @@ void ProductModel::handleProductUpdated(const Product &product)
 
 void ProductModel::handleProductDeleted(int id)
 {
-    for (int i = 0; i < m_products.count(); ++i) {
-        if (m_products[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_products.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    m_editBases.remove(id);
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -393,37 +242,13 @@ void ProductModel::handleProductDeleted(int id)
 
 void ProductModel::handleStockUpdated(const Product &product)
 {
-    for (int i = 0; i < m_products.count(); ++i) {
-        if (m_products[i].id == product.id) {
-            m_products[i] = product;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    replaceEntity(product);
 
     setLoading(false);
     setErrorMessage(QString());
     Q_EMIT stockUpdated();
 }
 
-// Private methods implementation
-void ProductModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void ProductModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 Product ProductModel::productFromVariantMap(const QVariantMap &map) const
 {
     Product product;
@@ -504,91 +329,5 @@ QVariantMap ProductModel::productToVariantMap(const Product &product) const
     map["packages"_L1] = packagesList;
     return map;
 }
-// Add setData method to support checking
-bool ProductModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_products.count()) {
-            m_products[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            return true;
-        }
-    }
-    return false;
-}
-
-// Implement new methods
-void ProductModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_products.count()) {
-        m_products[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList ProductModel::getCheckedProductIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &product : m_products) {
-        if (product.checked) {
-            checkedIds.append(product.id);
-        }
-    }
-    return checkedIds;
-}
-
-void ProductModel::clearAllChecked()
-{
-    for (int i = 0; i < m_products.count(); ++i) {
-        if (m_products[i].checked) {
-            m_products[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-void ProductModel::toggleAllProductsChecked()
-{
-    // Check if all are currently checked
-    bool allCurrentlyChecked = true;
-    for (const auto &product : m_products) {
-        if (!product.checked) {
-            allCurrentlyChecked = false;
-            break;
-        }
-    }
-
-    // Toggle all products' checked state
-    for (int i = 0; i < m_products.count(); ++i) {
-        m_products[i].checked = !allCurrentlyChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
-
-// bool ProductModel::hasCheckedItems() const
-// {
-//     return m_hasCheckedItems;
-// }
-
-void ProductModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &product : m_products) {
-        if (product.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
 
 } // namespace NetworkApi
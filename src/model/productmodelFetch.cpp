@@ -6,6 +6,8 @@ using namespace Qt::StringLiterals;
 ProductModelFetch::ProductModelFetch(QObject *parent)
     : ProductModel(parent)
 {
+    // Rows are handed whole to the sale and purchase forms, packages included
+    m_visibleRoles.clear();
 }
 
 void ProductModelFetch::loadPage(int page)
@@ -16,7 +18,9 @@ void ProductModelFetch::loadPage(int page)
 
     if (page > 0 && page <= m_totalPages && !m_loading) {
         setLoading(true);
-        m_api->getProducts(m_searchQuery, m_sortField, m_sortDirection, page, m_lowStockFilter);
+        m_appending = page > 1;
+        m_api->getProducts(m_searchQuery, m_sortField, m_sortDirection, page, m_lowStockFilter,
+                           false, QString(), listFieldset(), cursorFor(page));
     }
 }
 
@@ -25,9 +29,11 @@ void ProductModelFetch::refresh()
     if (!m_api)
         return;
 
-    // Don't reset to first page on refresh
+    // A cursor only leads forward, so refreshing starts over from the first page
     setLoading(true);
-    m_api->getProducts(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_lowStockFilter);
+    m_appending = false;
+    m_api->getProducts(m_searchQuery, m_sortField, m_sortDirection, 1, m_lowStockFilter,
+                       false, QString(), listFieldset(), cursorFor(1));
 }
 
 void ProductModelFetch::handleProductsReceived(const PaginatedProducts& products)
@@ -36,36 +42,13 @@ void ProductModelFetch::handleProductsReceived(const PaginatedProducts& products
              << products.currentPage << "of" << products.lastPage
              << "Items count:" << products.data.count();
 
-    if (products.currentPage == 1) {
-        // Only clear for first page
-        beginResetModel();
-        m_products.clear();
-        endResetModel();
-    }
-
-    // Insert new rows
-    if (!products.data.isEmpty()) {
-        beginInsertRows(QModelIndex(), m_products.count(),
-                       m_products.count() + products.data.count() - 1);
-        m_products.append(products.data);
-        endInsertRows();
-    }
-
-    m_totalItems = products.total;
-    m_currentPage = products.currentPage;
-    m_totalPages = products.lastPage;
-
-    Q_EMIT totalItemsChanged();
-    Q_EMIT currentPageChanged();
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
+    // The first page replaces the rows, matched by id; the others are appended
+    receiveFetchedPage(products);
 
     qDebug() << "ProductModelFetch::handleProductsReceived - After update:"
              << "Current page:" << m_currentPage
              << "Total items:" << m_totalItems
-             << "Total products in model:" << m_products.count();
+             << "Total products in model:" << m_rows.count();
 }
 
 } // namespace NetworkApi
@@ -4,16 +4,46 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+QVariant supplierName(const Purchase &purchase)
+{
+    return purchase.supplier.value("name"_L1).toString();
+}
+
+constexpr ModelRole<Purchase> PurchaseRoleTable[] = {
+    memberRole<&Purchase::id>(PurchaseModel::IdRole, "id"),
+    memberRole<&Purchase::reference_number>(PurchaseModel::ReferenceNumberRole, "referenceNumber"),
+    memberRole<&Purchase::purchase_date>(PurchaseModel::PurchaseDateRole, "purchaseDate"),
+    memberRole<&Purchase::supplier_id>(PurchaseModel::SupplierIdRole, "supplierId"),
+    memberRole<&Purchase::supplier>(PurchaseModel::SupplierRole, "supplier"),
+    memberRole<&Purchase::status>(PurchaseModel::StatusRole, "status"),
+    memberRole<&Purchase::payment_status>(PurchaseModel::PaymentStatusRole, "paymentStatus"),
+    memberRole<&Purchase::total_amount>(PurchaseModel::TotalAmountRole, "totalAmount"),
+    memberRole<&Purchase::paid_amount>(PurchaseModel::PaidAmountRole, "paidAmount"),
+    memberRole<&Purchase::notes>(PurchaseModel::NotesRole, "notes"),
+    memberRole<&Purchase::items>(PurchaseModel::ItemsRole, "items"),
+};
+
+constexpr ModelColumn<Purchase> PurchaseColumns[] = {
+    memberColumn<&Purchase::id>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "ID")),
+    memberColumn<&Purchase::reference_number>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Reference")),
+    memberColumn<&Purchase::purchase_date>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Date")),
+    {QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Supplier"), &supplierName},
+    memberColumn<&Purchase::status>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Status")),
+    memberColumn<&Purchase::payment_status>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Payment Status")),
+    memberColumn<&Purchase::total_amount>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Total")),
+    memberColumn<&Purchase::paid_amount>(QT_TRANSLATE_NOOP("NetworkApi::PurchaseModel", "Paid")),
+};
+
+} // namespace
+
 PurchaseModel::PurchaseModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<Purchase>(PurchaseRoleTable, PurchaseColumns, CheckedRole,
+                                     QStringLiteral("purchase_date"), QStringLiteral("desc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("purchase_date"))
-    , m_sortDirection(QStringLiteral("desc"))
-    , m_hasCheckedItems(false)
 {
 }
 
@@ -36,108 +66,6 @@ void PurchaseModel::setApi(PurchaseApi* api)
       refresh();
 }
 
-int PurchaseModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_purchases.count();
-}
-
-int PurchaseModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 8; // Number of columns to display
-}
-
-QVariant PurchaseModel::data(const QModelIndex &index, int role) const
-{
-    if (!index.isValid() || index.row() >= m_purchases.count())
-        return QVariant();
-
-    const Purchase &purchase = m_purchases.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return purchase.id;
-        case 1: return purchase.reference_number;
-        case 2: return purchase.purchase_date;
-        case 3: return purchase.supplier.value("name"_L1).toString();
-        case 4: return purchase.status;
-        case 5: return purchase.payment_status;
-        case 6: return purchase.total_amount;
-        case 7: return purchase.paid_amount;
-        }
-    } else {
-        switch (role) {
-        case IdRole: return purchase.id;
-        case ReferenceNumberRole: return purchase.reference_number;
-        case PurchaseDateRole: return purchase.purchase_date;
-        case SupplierIdRole: return purchase.supplier_id;
-        case SupplierRole: return purchase.supplier;
-        case StatusRole: return purchase.status;
-        case PaymentStatusRole: return purchase.payment_status;
-        case TotalAmountRole: return purchase.total_amount;
-        case PaidAmountRole: return purchase.paid_amount;
-        case NotesRole: return purchase.notes;
-        case ItemsRole: return QVariant::fromValue(purchase.items);
-        case CheckedRole: return purchase.checked;
-        }
-    }
-
-    return QVariant();
-}
-QHash<int, QByteArray> PurchaseModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[ReferenceNumberRole] = "referenceNumber";
-    roles[PurchaseDateRole] = "purchaseDate";
-    roles[SupplierIdRole] = "supplierId";
-    roles[SupplierRole] = "supplier";
-    roles[StatusRole] = "status";
-    roles[PaymentStatusRole] = "paymentStatus";
-    roles[TotalAmountRole] = "totalAmount";
-    roles[PaidAmountRole] = "paidAmount";
-    roles[NotesRole] = "notes";
-    roles[ItemsRole] = "items";
-    roles[CheckedRole] = "checked";
-    return roles;
-}
-
-QVariant PurchaseModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("ID");
-        case 1: return tr("Reference");
-        case 2: return tr("Date");
-        case 3: return tr("Supplier");
-        case 4: return tr("Status");
-        case 5: return tr("Payment Status");
-        case 6: return tr("Total");
-        case 7: return tr("Paid");
-        }
-    }
-    return QVariant();
-}
-
-bool PurchaseModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_purchases.count()) {
-            m_purchases[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
-}
-
 void PurchaseModel::refresh()
 {
     if (!m_api)
@@ -147,15 +75,6 @@ void PurchaseModel::refresh()
     m_api->getPurchases(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_status, m_paymentStatus);
 }
 
-void PurchaseModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void PurchaseModel::createPurchase(const QVariantMap &purchaseData)
 {
     if (!m_api)
@@ -185,10 +104,10 @@ void PurchaseModel::deletePurchase(int id)
 
 QVariantMap PurchaseModel::getPurchase(int row) const
 {
-    if (row < 0 || row >= m_purchases.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return purchaseToVariantMap(m_purchases.at(row));
+    return purchaseToVariantMap(m_rows.at(row));
 }
 
 void PurchaseModel::addPayment(int id, const QVariantMap &paymentData)
@@ -226,86 +145,7 @@ void PurchaseModel::getSummary(const QString &period)
     m_api->getSummary(period);
 }
 
-// Selection methods
-void PurchaseModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_purchases.count()) {
-        m_purchases[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList PurchaseModel::getCheckedPurchaseIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &purchase : m_purchases) {
-        if (purchase.checked) {
-            checkedIds.append(purchase.id);
-        }
-    }
-    return checkedIds;
-}
-
-void PurchaseModel::clearAllChecked()
-{
-    for (int i = 0; i < m_purchases.count(); ++i) {
-        if (m_purchases[i].checked) {
-            m_purchases[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void PurchaseModel::toggleAllPurchasesChecked()
-{
-    bool allChecked = true;
-    for (const auto &purchase : m_purchases) {
-        if (!purchase.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_purchases.count(); ++i) {
-        m_purchases[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
-
 // Slots
-void PurchaseModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void PurchaseModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void PurchaseModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();
-    }
-}
-
 void PurchaseModel::setStatus(const QString &status)
 {
     if (m_status != status) {
@@ -327,24 +167,7 @@ void PurchaseModel::setPaymentStatus(const QString &paymentStatus)
 // Private slots
 void PurchaseModel::handlePurchasesReceived(const PaginatedPurchases &purchases)
 {
-    beginResetModel();
-    m_purchases = purchases.data;
-    endResetModel();
-
-    m_totalItems = purchases.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = purchases.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = purchases.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    updateHasCheckedItems();
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
+    receivePage(purchases);
 }
 
 void PurchaseModel::handlePurchaseError(const QString &message, ApiStatus status)
@@ -355,9 +178,7 @@ void PurchaseModel::handlePurchaseError(const QString &message, ApiStatus status
 
 void PurchaseModel::handlePurchaseCreated(const Purchase &purchase)
 {
-    beginInsertRows(QModelIndex(), m_purchases.count(), m_purchases.count());
-    m_purchases.append(purchase);
-    endInsertRows();
+    appendEntity(purchase);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -366,14 +187,7 @@ void PurchaseModel::handlePurchaseCreated(const Purchase &purchase)
 
 void PurchaseModel::handlePurchaseUpdated(const Purchase &purchase)
 {
-    for (int i = 0; i < m_purchases.count(); ++i) {
-        if (m_purchases[i].id == purchase.id) {
-            m_purchases[i] = purchase;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    replaceEntity(purchase);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -382,14 +196,7 @@ void PurchaseModel::handlePurchaseUpdated(const Purchase &purchase)
 
 void PurchaseModel::handlePurchaseDeleted(int id)
 {
-    for (int i = 0; i < m_purchases.count(); ++i) {
-        if (m_purchases[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_purchases.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -419,22 +226,6 @@ void PurchaseModel::handleSummaryReceived(const QVariantMap &summary)
 }
 
 // Private methods
-void PurchaseModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void PurchaseModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 Purchase PurchaseModel::purchaseFromVariantMap(const QVariantMap &map) const
 {
     Purchase purchase;
@@ -544,20 +335,5 @@ QVariantMap PurchaseModel::purchaseToVariantMap(const Purchase &purchase) const
 
     return map;
 }
-void PurchaseModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &purchase : m_purchases) {
-        if (purchase.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
 
 } // namespace NetworkApi
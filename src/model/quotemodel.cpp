@@ -35,7 +35,8 @@ void QuoteModel::refresh()
 
     setLoading(true);
     // Explicitly use "quote" instead of m_type
-    m_api->getSales(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_status, m_paymentStatus, QStringLiteral("quote"));
+    m_api->getSales(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_status, m_paymentStatus, QStringLiteral("quote"),
+                    listFieldset());
 }
 
 } // namespace NetworkApi
@@ -0,0 +1,134 @@
+// rowdiff.h
+#ifndef ROWDIFF_H
+#define ROWDIFF_H
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QVariant>
+#include <utility>
+
+namespace NetworkApi {
+
+// Replaces the rows of a list model with a freshly received page, matching
+// rows by id: rows that went away are removed, new ones inserted, reordered
+// ones moved, and rows that stayed report only the roles whose data()
+// changed. Delegates, scroll position and checked state survive a refresh,
+// and an unchanged page emits nothing.
+//
+// A page sharing no rows with the current one (another page, a new search)
+// and a reordering that would take many moves (another sort) reset instead.
+//
+// The model declares `friend struct RowDiff<Model>;` so the diff can call its
+// begin/end row functions; rows are structs with an `id` member.
+template<typename Model>
+struct RowDiff
+{
+    template<typename Row>
+    static void apply(Model &model, QList<Row> &rows, QList<Row> incoming)
+    {
+        QHash<int, qsizetype> wanted;
+        wanted.reserve(incoming.size());
+        for (qsizetype i = 0; i < incoming.size(); ++i)
+            wanted.insert(incoming.at(i).id, i);
+
+        // Target positions of the rows that stay, in their current order;
+        // every step down is (at least) one move
+        qsizetype kept = 0;
+        qsizetype steps = 0;
+        qsizetype previous = -1;
+        for (const Row &row : std::as_const(rows)) {
+            const auto it = wanted.constFind(row.id);
+            if (it == wanted.cend())
+                continue;
+            ++kept;
+            if (it.value() < previous)
+                ++steps;
+            previous = it.value();
+        }
+
+        if (wanted.size() != incoming.size() || (kept == 0 && !rows.isEmpty()) || steps > kept / 4) {
+            model.beginResetModel();
+            rows = std::move(incoming);
+            model.endResetModel();
+            return;
+        }
+
+        // Removals, a contiguous run at a time from the end
+        for (qsizetype last = rows.size() - 1; last >= 0; --last) {
+            if (wanted.contains(rows.at(last).id))
+                continue;
+            qsizetype first = last;
+            while (first > 0 && !wanted.contains(rows.at(first - 1).id))
+                --first;
+            model.beginRemoveRows(QModelIndex(), int(first), int(last));
+            rows.remove(first, last - first + 1);
+            model.endRemoveRows();
+            last = first;
+        }
+
+        QSet<int> present;
+        present.reserve(rows.size());
+        for (const Row &row : std::as_const(rows))
+            present.insert(row.id);
+        if (present.size() != rows.size()) {
+            // The same id twice (pages that overlapped while appending)
+            model.beginResetModel();
+            rows = std::move(incoming);
+            model.endResetModel();
+            return;
+        }
+
+        const QList<int> roles = model.roleNames().keys();
+        QList<QVariant> before(roles.size());
+
+        // Rows before i are final: row i is either the incoming one already,
+        // somewhere further down, or the first of a run of new rows
+        for (qsizetype i = 0; i < incoming.size(); ++i) {
+            const int id = incoming.at(i).id;
+
+            if (!present.contains(id)) {
+                qsizetype last = i;
+                while (last + 1 < incoming.size() && !present.contains(incoming.at(last + 1).id))
+                    ++last;
+                model.beginInsertRows(QModelIndex(), int(i), int(last));
+                for (qsizetype k = i; k <= last; ++k)
+                    rows.insert(k, std::move(incoming[k]));
+                model.endInsertRows();
+                i = last;
+                continue;
+            }
+
+            if (rows.at(i).id != id) {
+                qsizetype from = i + 1;
+                while (rows.at(from).id != id)
+                    ++from;
+                model.beginMoveRows(QModelIndex(), int(from), int(from), QModelIndex(), int(i));
+                rows.move(from, i);
+                model.endMoveRows();
+            }
+
+            const QModelIndex index = model.index(int(i), 0);
+            for (qsizetype r = 0; r < roles.size(); ++r)
+                before[r] = model.data(index, roles.at(r));
+
+            rows[i] = std::move(incoming[i]);
+
+            QList<int> changed;
+            for (qsizetype r = 0; r < roles.size(); ++r) {
+                if (model.data(index, roles.at(r)) != before.at(r))
+                    changed.append(roles.at(r));
+            }
+            if (!changed.isEmpty()) {
+                // The table columns show the same members through DisplayRole
+                changed.append(Qt::DisplayRole);
+                Q_EMIT model.dataChanged(index, model.index(int(i), model.columnCount() - 1), changed);
+            }
+        }
+    }
+};
+
+} // namespace NetworkApi
+
+#endif // ROWDIFF_H
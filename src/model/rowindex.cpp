@@ -0,0 +1,62 @@
+// rowindex.cpp
+#include "rowindex.h"
+
+namespace NetworkApi {
+
+RowIndex::RowIndex(QAbstractItemModel *model, std::function<int(int row)> rowId)
+    : m_model(model)
+    , m_rowId(std::move(rowId))
+{
+    QObject::connect(model, &QAbstractItemModel::rowsInserted, model, [this](const QModelIndex &, int first, int last) {
+        rowsInserted(first, last);
+    });
+    QObject::connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, model, [this](const QModelIndex &, int first, int last) {
+        rowsAboutToBeRemoved(first, last);
+    });
+    QObject::connect(model, &QAbstractItemModel::rowsMoved, model, [this]() { invalidate(); });
+    QObject::connect(model, &QAbstractItemModel::modelReset, model, [this]() { invalidate(); });
+    QObject::connect(model, &QAbstractItemModel::layoutChanged, model, [this]() { invalidate(); });
+}
+
+int RowIndex::row(int id) const
+{
+    if (m_stale) {
+        const int rows = m_model->rowCount();
+        m_rows.clear();
+        m_rows.reserve(rows);
+        for (int row = 0; row < rows; ++row)
+            m_rows.insert(m_rowId(row), row);
+        m_stale = false;
+    }
+    return m_rows.value(id, -1);
+}
+
+void RowIndex::rowsInserted(int first, int last)
+{
+    if (m_stale)
+        return;
+    if (last != m_model->rowCount() - 1) {
+        // Every row after the insertion moved down
+        invalidate();
+        return;
+    }
+    for (int row = first; row <= last; ++row)
+        m_rows.insert(m_rowId(row), row);
+}
+
+void RowIndex::rowsAboutToBeRemoved(int first, int last)
+{
+    if (m_stale)
+        return;
+    if (last != m_model->rowCount() - 1) {
+        invalidate();
+        return;
+    }
+    for (int row = first; row <= last; ++row) {
+        const auto it = m_rows.constFind(m_rowId(row));
+        if (it != m_rows.cend() && it.value() == row)
+            m_rows.erase(it);
+    }
+}
+
+} // namespace NetworkApi
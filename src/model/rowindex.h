@@ -0,0 +1,38 @@
+// rowindex.h
+#ifndef ROWINDEX_H
+#define ROWINDEX_H
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <functional>
+
+namespace NetworkApi {
+
+// Row of each id in a list model, for lookups by id in constant time. It
+// follows the model's own row signals, so inserts, removals, moves and resets
+// keep it right without the model maintaining it: rows appended or removed at
+// the end update it in place, any other change has the next lookup rebuild it
+// once.
+class RowIndex
+{
+public:
+    // rowId gives the id of the entity in a row of model
+    RowIndex(QAbstractItemModel *model, std::function<int(int row)> rowId);
+
+    // The row holding id, -1 when there is none
+    int row(int id) const;
+
+private:
+    void rowsInserted(int first, int last);
+    void rowsAboutToBeRemoved(int first, int last);
+    void invalidate() { m_stale = true; }
+
+    QAbstractItemModel *m_model;
+    std::function<int(int)> m_rowId;
+    mutable QHash<int, int> m_rows;
+    mutable bool m_stale = true;
+};
+
+} // namespace NetworkApi
+
+#endif // ROWINDEX_H
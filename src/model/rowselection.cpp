@@ -0,0 +1,111 @@
+// rowselection.cpp
+#include "rowselection.h"
+#include <algorithm>
+
+namespace NetworkApi {
+
+RowSelection::RowSelection(QAbstractItemModel *model, std::function<void()> countChanged)
+    : m_model(model)
+    , m_countChanged(std::move(countChanged))
+{
+    QObject::connect(model, &QAbstractItemModel::rowsInserted, model, [this](const QModelIndex &, int first, int last) {
+        rowsInserted(first, last);
+    });
+    QObject::connect(model, &QAbstractItemModel::rowsRemoved, model, [this](const QModelIndex &, int first, int last) {
+        rowsRemoved(first, last);
+    });
+    QObject::connect(model, &QAbstractItemModel::rowsMoved, model,
+                     [this](const QModelIndex &, int first, int last, const QModelIndex &, int destination) {
+                         rowsMoved(first, last, destination);
+                     });
+    QObject::connect(model, &QAbstractItemModel::modelReset, model, [this]() { reset(); });
+    QObject::connect(model, &QAbstractItemModel::layoutChanged, model, [this]() { reset(); });
+}
+
+bool RowSelection::isSelected(int row) const
+{
+    return row >= 0 && row < int(m_bits.size()) && m_bits[row];
+}
+
+QList<int> RowSelection::rows() const
+{
+    QList<int> rows;
+    rows.reserve(m_count);
+    for (int row = 0; row < int(m_bits.size()) && rows.size() < m_count; ++row) {
+        if (m_bits[row])
+            rows.append(row);
+    }
+    return rows;
+}
+
+bool RowSelection::setSelected(int row, bool selected)
+{
+    if (row < 0 || row >= int(m_bits.size()) || m_bits[row] == selected)
+        return false;
+    m_bits[row] = selected;
+    m_count += selected ? 1 : -1;
+    return true;
+}
+
+RowSelection::Span RowSelection::selectAll()
+{
+    return fill(true);
+}
+
+RowSelection::Span RowSelection::clear()
+{
+    return fill(false);
+}
+
+RowSelection::Span RowSelection::fill(bool selected)
+{
+    const auto first = std::find(m_bits.cbegin(), m_bits.cend(), !selected);
+    if (first == m_bits.cend())
+        return {};
+    const auto last = std::find(m_bits.crbegin(), m_bits.crend(), !selected);
+
+    Span span;
+    span.first = int(first - m_bits.cbegin());
+    span.last = int(m_bits.size()) - 1 - int(last - m_bits.crbegin());
+    m_bits.assign(m_bits.size(), selected);
+    m_count = selected ? int(m_bits.size()) : 0;
+    return span;
+}
+
+void RowSelection::rowsInserted(int first, int last)
+{
+    m_bits.insert(m_bits.begin() + first, std::size_t(last - first + 1), false);
+}
+
+void RowSelection::rowsRemoved(int first, int last)
+{
+    const auto begin = m_bits.begin() + first;
+    const auto end = m_bits.begin() + last + 1;
+    const int removed = int(std::count(begin, end, true));
+    m_bits.erase(begin, end);
+    if (removed > 0) {
+        m_count -= removed;
+        m_countChanged();
+    }
+}
+
+void RowSelection::rowsMoved(int first, int last, int destination)
+{
+    // destination is the row the block goes before, counted before the move
+    const std::vector<bool> moved(m_bits.begin() + first, m_bits.begin() + last + 1);
+    m_bits.erase(m_bits.begin() + first, m_bits.begin() + last + 1);
+    if (destination > last)
+        destination -= last - first + 1;
+    m_bits.insert(m_bits.begin() + destination, moved.cbegin(), moved.cend());
+}
+
+void RowSelection::reset()
+{
+    const bool hadSelection = m_count > 0;
+    m_bits.assign(std::size_t(m_model->rowCount()), false);
+    m_count = 0;
+    if (hadSelection)
+        m_countChanged();
+}
+
+} // namespace NetworkApi
@@ -0,0 +1,58 @@
+// rowselection.h
+#ifndef ROWSELECTION_H
+#define ROWSELECTION_H
+
+#include <QAbstractItemModel>
+#include <QList>
+#include <functional>
+#include <vector>
+
+namespace NetworkApi {
+
+// Checked rows of a list model, one bit per row, and how many there are.
+// Like RowIndex it follows the model's row signals: inserted rows come in
+// unchecked, moved and removed rows take their bit with them, and a reset or
+// a layout change clears it.
+class RowSelection
+{
+public:
+    // The rows a change touched, for one ranged dataChanged; empty when
+    // nothing changed
+    struct Span {
+        int first = -1;
+        int last = -1;
+        bool isEmpty() const { return first < 0; }
+    };
+
+    // countChanged is called when rows leaving the model changed count()
+    RowSelection(QAbstractItemModel *model, std::function<void()> countChanged);
+
+    bool isSelected(int row) const;
+    int count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+    // Every row checked, and there is at least one
+    bool isFull() const { return m_count > 0 && m_count == int(m_bits.size()); }
+    // Checked rows, in order
+    QList<int> rows() const;
+
+    // Whether the row changed
+    bool setSelected(int row, bool selected);
+    Span selectAll();
+    Span clear();
+
+private:
+    Span fill(bool selected);
+    void rowsInserted(int first, int last);
+    void rowsRemoved(int first, int last);
+    void rowsMoved(int first, int last, int destination);
+    void reset();
+
+    QAbstractItemModel *m_model;
+    std::function<void()> m_countChanged;
+    std::vector<bool> m_bits;
+    int m_count = 0;
+};
+
+} // namespace NetworkApi
+
+#endif // ROWSELECTION_H
@@ -4,17 +4,61 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+QVariant saleClientName(const Sale &sale)
+{
+    return sale.client.value("name"_L1).toString();
+}
+
+QVariant saleItems(const Sale &sale)
+{
+    // Delegates read this on every rebind while scrolling
+    if (!sale.itemsValue.isValid())
+        sale.itemsValue = QVariant::fromValue(sale.items);
+    return sale.itemsValue;
+}
+
+constexpr ModelRole<Sale> SaleRoleTable[] = {
+    memberRole<&Sale::id>(SaleModel::IdRole, "id"),
+    memberRole<&Sale::reference_number>(SaleModel::ReferenceNumberRole, "reference_number"),
+    memberRole<&Sale::sale_date>(SaleModel::SaleDateRole, "sale_date"),
+    memberRole<&Sale::client_id>(SaleModel::ClientIdRole, "clientId"),
+    memberRole<&Sale::client>(SaleModel::ClientRole, "client"),
+    memberRole<&Sale::status>(SaleModel::StatusRole, "status"),
+    memberRole<&Sale::payment_status>(SaleModel::PaymentStatusRole, "payment_status"),
+    memberRole<&Sale::total_amount>(SaleModel::TotalAmountRole, "total_amount"),
+    memberRole<&Sale::paid_amount>(SaleModel::PaidAmountRole, "paid_amount"),
+    memberRole<&Sale::createdAt>(SaleModel::CreatedAtRole, "createdAt"),
+    memberRole<&Sale::notes>(SaleModel::NotesRole, "notes"),
+    {SaleModel::ItemsRole, "items", &saleItems},
+    memberRole<&Sale::type>(SaleModel::TypeRole, "type"),
+};
+
+constexpr ModelColumn<Sale> SaleColumns[] = {
+    memberColumn<&Sale::id>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "ID")),
+    memberColumn<&Sale::reference_number>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Reference")),
+    memberColumn<&Sale::sale_date>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Date")),
+    {QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Client"), &saleClientName},
+    memberColumn<&Sale::status>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Status")),
+    memberColumn<&Sale::payment_status>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Payment Status")),
+    memberColumn<&Sale::total_amount>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Total")),
+    memberColumn<&Sale::paid_amount>(QT_TRANSLATE_NOOP("NetworkApi::SaleModel", "Paid")),
+};
+
+} // namespace
+
 SaleModel::SaleModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<Sale>(SaleRoleTable, SaleColumns, CheckedRole,
+                                 QStringLiteral("sale_date"), QStringLiteral("desc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("sale_date"))
-    , m_sortDirection(QStringLiteral("desc"))
     , m_type(QStringLiteral("sale"))
-    , m_hasCheckedItems(false)
+    , m_visibleRoles({QStringLiteral("id"), QStringLiteral("checked"), QStringLiteral("reference_number"),
+                      QStringLiteral("client"), QStringLiteral("status"), QStringLiteral("payment_status"),
+                      QStringLiteral("total_amount"), QStringLiteral("paid_amount"), QStringLiteral("sale_date"),
+                      QStringLiteral("type")})
 {
 }
 
@@ -27,6 +71,7 @@ void SaleModel::setApi(SaleApi* api)
         connect(m_api, &SaleApi::errorSalesReceived, this, &SaleModel::handleSaleError);
         connect(m_api, &SaleApi::saleCreated, this, &SaleModel::handleSaleCreated);
         connect(m_api, &SaleApi::saleUpdated, this, &SaleModel::handleSaleUpdated);
+        connect(m_api, &SaleApi::saleDetailsReceived, this, &SaleModel::handleSaleDetails);
         connect(m_api, &SaleApi::saleDeleted, this, &SaleModel::handleSaleDeleted);
         connect(m_api, &SaleApi::paymentAdded, this, &SaleModel::handlePaymentAdded);
         connect(m_api, &SaleApi::invoiceGenerated, this, &SaleModel::handleInvoiceGenerated);
@@ -37,122 +82,48 @@ void SaleModel::setApi(SaleApi* api)
     refresh();
 }
 
-int SaleModel::rowCount(const QModelIndex &parent) const
+void SaleModel::refresh()
 {
-    if (parent.isValid())
-        return 0;
-    return m_sales.count();
-}
+    if (!m_api)
+        return;
 
-int SaleModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 8; // Adjust based on your needs
+    setLoading(true);
+    m_api->getSales(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_status, m_paymentStatus, m_type,
+                    listFieldset());
 }
 
-QVariant SaleModel::data(const QModelIndex &index, int role) const
+void SaleModel::setVisibleRoles(const QStringList &roles)
 {
-    if (!index.isValid() || index.row() >= m_sales.count())
-        return QVariant();
-
-    const Sale &sale = m_sales.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return sale.id;
-        case 1: return sale.reference_number;
-        case 2: return sale.sale_date;
-        case 3: return sale.client.value("name"_L1).toString();
-        case 4: return sale.status;
-        case 5: return sale.payment_status;
-        case 6: return sale.total_amount;
-        case 7: return sale.paid_amount;
-        }
-    } else {
-        switch (role) {
-        case IdRole: return sale.id;
-        case ReferenceNumberRole: return sale.reference_number;
-        case SaleDateRole: return sale.sale_date;
-        case ClientIdRole: return sale.client_id;
-        case ClientRole: return sale.client;
-        case StatusRole: return sale.status;
-        case PaymentStatusRole: return sale.payment_status;
-        case TotalAmountRole: return sale.total_amount;
-        case PaidAmountRole: return sale.paid_amount;
-        case NotesRole: return sale.notes;
-        case ItemsRole: return QVariant::fromValue(sale.items);
-        case CreatedAtRole: return sale.createdAt;
-        case CheckedRole: return sale.checked;
-        case TypeRole: return sale.type; // Add type role
-        }
-    }
-
-    return QVariant();
-}
-
-QHash<int, QByteArray> SaleModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[ReferenceNumberRole] = "reference_number";
-    roles[SaleDateRole] = "sale_date";
-    roles[ClientIdRole] = "clientId";
-    roles[ClientRole] = "client";
-    roles[StatusRole] = "status";
-    roles[PaymentStatusRole] = "payment_status";
-    roles[TotalAmountRole] = "total_amount";
-    roles[PaidAmountRole] = "paid_amount";
-    roles[CreatedAtRole] = "createdAt";
-    roles[NotesRole] = "notes";
-    roles[ItemsRole] = "items";
-    roles[CheckedRole] = "checked";
-    roles[TypeRole] = "type"; // Add type role
-    return roles;
-}
-
-
-QVariant SaleModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("ID");
-        case 1: return tr("Reference");
-        case 2: return tr("Date");
-        case 3: return tr("Client");
-        case 4: return tr("Status");
-        case 5: return tr("Payment Status");
-        case 6: return tr("Total");
-        case 7: return tr("Paid");
-        case 8: return tr("Created At");
-        }
-    }
-    return QVariant();
+    if (m_visibleRoles == roles)
+        return;
+    m_visibleRoles = roles;
+    Q_EMIT visibleRolesChanged();
+    refresh();
 }
 
-bool SaleModel::setData(const QModelIndex &index, const QVariant &value, int role)
+Fieldset SaleModel::listFieldset() const
 {
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_sales.count()) {
-            m_sales[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
+    return fieldsetForRoles(m_visibleRoles, {
+        {"reference_number"_L1, "reference_number"_L1, {}},
+        {"sale_date"_L1, "sale_date"_L1, {}},
+        {"clientId"_L1, "client_id"_L1, {}},
+        {"client"_L1, "client_id"_L1, "client"_L1},
+        {"status"_L1, "status"_L1, {}},
+        {"payment_status"_L1, "payment_status"_L1, {}},
+        {"total_amount"_L1, "total_amount"_L1, {}},
+        {"paid_amount"_L1, "paid_amount"_L1, {}},
+        {"createdAt"_L1, "created_at"_L1, {}},
+        {"notes"_L1, "notes"_L1, {}},
+        {"items"_L1, {}, "items"_L1},
+        {"type"_L1, "type"_L1, {}},
+    });
 }
 
-void SaleModel::refresh()
+void SaleModel::fetchDetails(int row)
 {
-    if (!m_api)
+    if (!m_api || row < 0 || row >= m_rows.count())
         return;
-
-    setLoading(true);
-    m_api->getSales(m_searchQuery, m_sortField, m_sortDirection, m_currentPage, m_status, m_paymentStatus, m_type);
+    m_api->getSale(m_rows.at(row).id);
 }
 void SaleModel::convertToSale(int id)
 {
@@ -171,15 +142,6 @@ void SaleModel::setType(const QString &type)
         refresh();
     }
 }
-void SaleModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void SaleModel::createSale(const QVariantMap &saleData)
 {
     if (!m_api)
@@ -203,13 +165,11 @@ void SaleModel::handleSaleConverted(const QVariantMap &sale)
     int id = sale["id"_L1].toInt();
 
     // Update the sale in the model
-    for (int i = 0; i < m_sales.count(); ++i) {
-        if (m_sales[i].id == id) {
-            m_sales[i].type = QStringLiteral("sale");
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
+    const int row = rowOf(id);
+    if (row >= 0) {
+        m_rows[row].type = QStringLiteral("sale");
+        QModelIndex index = createIndex(row, 0);
+        Q_EMIT dataChanged(index, index);
     }
 
     Q_EMIT saleConverted(id);
@@ -230,7 +190,14 @@ void SaleModel::updateSale(int id, const QVariantMap &saleData)
     setLoading(true);
     Sale sale = saleFromVariantMap(saleData);
     sale.id = id;
-    m_api->updateSale(id, sale);
+
+    // Only the members the user changed, so that edits made meanwhile on
+    // other tills are kept; a sale never loaded in full is sent whole
+    const auto base = m_editBases.constFind(id);
+    if (base != m_editBases.cend())
+        m_api->patchSale(*base, sale);
+    else
+        m_api->updateSale(id, sale);
 }
 void SaleModel::deleteSale(int id)
 {
@@ -243,10 +210,10 @@ void SaleModel::deleteSale(int id)
 
 QVariantMap SaleModel::getSale(int row) const
 {
-    if (row < 0 || row >= m_sales.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return saleToVariantMap(m_sales.at(row));
+    return saleToVariantMap(m_rows.at(row));
 }
 
 void SaleModel::addPayment(int id, const QVariantMap &paymentData)
@@ -285,104 +252,17 @@ void SaleModel::getSummary(const QString &period)
 }
 
 // Selection methods
-void SaleModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_sales.count()) {
-        m_sales[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList SaleModel::getCheckedSaleIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &sale : m_sales) {
-        if (sale.checked) {
-            checkedIds.append(sale.id);
-        }
-    }
-    return checkedIds;
-}
-
-void SaleModel::clearAllChecked()
-{
-    for (int i = 0; i < m_sales.count(); ++i) {
-        if (m_sales[i].checked) {
-            m_sales[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void SaleModel::toggleAllSalesChecked()
-{
-    bool allChecked = true;
-    for (const auto &sale : m_sales) {
-        if (!sale.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_sales.count(); ++i) {
-        m_sales[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
 void SaleModel::uncheckAllSales()
 {
     // Only perform the operation if there are actually checked items
-    if (!m_hasCheckedItems) {
+    if (!hasCheckedItems()) {
         return;
     }
 
-    for (int i = 0; i < m_sales.count(); ++i) {
-        if (m_sales[i].checked) {
-            m_sales[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-
-    // Update the checked items flag
-    m_hasCheckedItems = false;
-    Q_EMIT hasCheckedItemsChanged();
+    clearAllChecked();
 }
 
 // Slots
-void SaleModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void SaleModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void SaleModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();
-    }
-}
-
 void SaleModel::setStatus(const QString &status)
 {
     if (m_status != status) {
@@ -404,24 +284,7 @@ void SaleModel::setPaymentStatus(const QString &paymentStatus)
 // Private slots
 void SaleModel::handleSalesReceived(const PaginatedSales &sales)
 {
-    beginResetModel();
-    m_sales = sales.data;
-    endResetModel();
-
-    m_totalItems = sales.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = sales.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = sales.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    updateHasCheckedItems();
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
+    receivePage(sales);
 }
 
 void SaleModel::handleSaleError(const QString &message, ApiStatus status)
@@ -432,9 +295,7 @@ void SaleModel::handleSaleError(const QString &message, ApiStatus status)
 
 void SaleModel::handleSaleCreated(const Sale &sale)
 {
-    beginInsertRows(QModelIndex(), m_sales.count(), m_sales.count());
-    m_sales.append(sale);
-    endInsertRows();
+    appendEntity(sale);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -443,30 +304,25 @@ void SaleModel::handleSaleCreated(const Sale &sale)
 
 void SaleModel::handleSaleUpdated(const Sale &sale)
 {
-    for (int i = 0; i < m_sales.count(); ++i) {
-        if (m_sales[i].id == sale.id) {
-            m_sales[i] = sale;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    if (m_editBases.contains(sale.id))
+        m_editBases.insert(sale.id, sale);
+    replaceEntity(sale);
 
     setLoading(false);
     setErrorMessage(QString());
     Q_EMIT saleUpdated();
 }
 
+void SaleModel::handleSaleDetails(const Sale &sale)
+{
+    m_editBases.insert(sale.id, sale);
+    replaceEntity(sale);
+}
+
 void SaleModel::handleSaleDeleted(int id)
 {
-    for (int i = 0; i < m_sales.count(); ++i) {
-        if (m_sales[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_sales.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    m_editBases.remove(id);
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -496,22 +352,6 @@ void SaleModel::handleSummaryReceived(const QVariantMap &summary)
 }
 
 // Private methods
-void SaleModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void SaleModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 Sale SaleModel::saleFromVariantMap(const QVariantMap &map) const
 {
     Sale sale;
@@ -656,20 +496,4 @@ QVariantMap SaleModel::saleToVariantMap(const Sale &sale) const
     return map;
 }
 
-void SaleModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &sale : m_sales) {
-        if (sale.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
-
 } // namespace NetworkApi
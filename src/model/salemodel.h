@@ -2,28 +2,21 @@
 #define SALEMODEL_H
 
 #include "../api/saleapi.h"
-#include <QAbstractTableModel>
+#include "paginatedentitymodel.h"
 #include <QQmlEngine>
 
 namespace NetworkApi {
 
-class SaleModel : public QAbstractTableModel
+class SaleModel : public PaginatedEntityModel<Sale>
 {
     Q_OBJECT
 
-    Q_PROPERTY(bool loading READ loading NOTIFY loadingChanged)
-    Q_PROPERTY(QString errorMessage READ errorMessage NOTIFY errorMessageChanged)
-    Q_PROPERTY(int totalItems READ totalItems NOTIFY totalItemsChanged)
-    Q_PROPERTY(int currentPage READ currentPage NOTIFY currentPageChanged)
-    Q_PROPERTY(int totalPages READ totalPages NOTIFY totalPagesChanged)
-    Q_PROPERTY(QString sortField READ sortField WRITE setSortField NOTIFY sortFieldChanged)
-    Q_PROPERTY(QString sortDirection READ sortDirection WRITE setSortDirection NOTIFY sortDirectionChanged)
-    Q_PROPERTY(QString searchQuery READ searchQuery WRITE setSearchQuery NOTIFY searchQueryChanged)
     Q_PROPERTY(QString status READ status WRITE setStatus NOTIFY statusChanged)
     Q_PROPERTY(QString paymentStatus READ paymentStatus WRITE setPaymentStatus NOTIFY paymentStatusChanged)
     Q_PROPERTY(QString type READ type WRITE setType NOTIFY typeChanged)  // Add type property
-    Q_PROPERTY(bool hasCheckedItems READ hasCheckedItems NOTIFY hasCheckedItemsChanged)
-    Q_PROPERTY(int rowCount READ rowCount NOTIFY rowCountChanged)
+    // Role names the view shows; list requests only ask for what they need.
+    // Empty fetches full rows, items included.
+    Q_PROPERTY(QStringList visibleRoles READ visibleRoles WRITE setVisibleRoles NOTIFY visibleRolesChanged)
 
 public:
     enum SaleRoles {
@@ -48,77 +41,37 @@ public:
     explicit SaleModel(QObject *parent = nullptr);
     Q_INVOKABLE void setApi(SaleApi* api);
 
-    // QAbstractTableModel interface
-    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
-    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
-    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
-    QHash<int, QByteArray> roleNames() const override;
-    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
-    bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
-
     // Properties
-    bool loading() const { return m_loading; }
-    QString errorMessage() const { return m_errorMessage; }
-    int totalItems() const { return m_totalItems; }
-    int currentPage() const { return m_currentPage; }
-    int totalPages() const { return m_totalPages; }
-    QString sortField() const { return m_sortField; }
-    QString sortDirection() const { return m_sortDirection; }
-    QString searchQuery() const { return m_searchQuery; }
     QString status() const { return m_status; }
     QString paymentStatus() const { return m_paymentStatus; }
     QString type() const { return m_type; }  // Add type accessor
-    bool hasCheckedItems() const { return m_hasCheckedItems; }
+    QStringList visibleRoles() const { return m_visibleRoles; }
+    void setVisibleRoles(const QStringList &roles);
 
     // Q_INVOKABLE methods for QML
-    virtual  Q_INVOKABLE void refresh();
-    Q_INVOKABLE void loadPage(int page);
+    Q_INVOKABLE void refresh() override;
     Q_INVOKABLE void createSale(const QVariantMap &saleData);
     Q_INVOKABLE void updateSale(int id, const QVariantMap &saleData);
     Q_INVOKABLE void deleteSale(int id);
     Q_INVOKABLE QVariantMap getSale(int row) const;
+    // Loads the members a sparse row is missing (items); the row updates in place
+    Q_INVOKABLE void fetchDetails(int row);
     Q_INVOKABLE void addPayment(int id, const QVariantMap &paymentData);
     Q_INVOKABLE void generateInvoice(int id);
     Q_INVOKABLE void getSummary(const QString &period = QStringLiteral("month"));
     Q_INVOKABLE void convertToSale(int id); // Add convert method
 
     // Selection methods
-    Q_INVOKABLE void setChecked(int row, bool checked);
-    Q_INVOKABLE QVariantList getCheckedSaleIds() const;
-    Q_INVOKABLE void clearAllChecked();
-    Q_INVOKABLE void toggleAllSalesChecked();
+    Q_INVOKABLE QVariantList getCheckedSaleIds() const { return checkedIds(); }
+    Q_INVOKABLE void toggleAllSalesChecked() { toggleAllChecked(); }
     Q_INVOKABLE void uncheckAllSales();
-    SaleApi* m_api;
-    void setLoading(bool loading);
-    QString m_sortField;
-    QString m_sortDirection;
-    QString m_searchQuery;
-    QString m_status;
-    QString m_paymentStatus;
-    QString m_type; // Add type field
-    bool m_loading;
-    QString m_errorMessage;
-    int m_totalItems;
-    int m_currentPage;
-    int m_totalPages;
 
 public Q_SLOTS:
-    void setSortField(const QString &field);
-    void setSortDirection(const QString &direction);
-    void setSearchQuery(const QString &query);
     void setStatus(const QString &status);
     void setPaymentStatus(const QString &paymentStatus);
     void setType(const QString &type); // Add type setter
 
 Q_SIGNALS:
-    void loadingChanged();
-    void errorMessageChanged();
-    void totalItemsChanged();
-    void currentPageChanged();
-    void totalPagesChanged();
-    void sortFieldChanged();
-    void sortDirectionChanged();
-    void searchQueryChanged();
     void statusChanged();
     void paymentStatusChanged();
     void typeChanged(); // Add type changed signal
@@ -128,8 +81,7 @@ Q_SIGNALS:
     void paymentAdded();
     void invoiceGenerated(const QString &invoiceUrl);
     void summaryReceived(const QVariantMap &summary);
-    void hasCheckedItemsChanged();
-    void rowCountChanged();
+    void visibleRolesChanged();
     void saleConverted(int id); // Add conversion signal
     void saleConversionError(const QString &error); // Add error signal
 
@@ -138,6 +90,7 @@ private Q_SLOTS:
     void handleSaleError(const QString &message, ApiStatus status);
     void handleSaleCreated(const Sale &sale);
     void handleSaleUpdated(const Sale &sale);
+    void handleSaleDetails(const Sale &sale);
     void handleSaleDeleted(int id);
     void handlePaymentAdded(const QVariantMap &payment);
     void handleInvoiceGenerated(const QVariantMap &invoice);
@@ -145,17 +98,21 @@ private Q_SLOTS:
     void handleSaleConverted(const QVariantMap &sale); // Add handler for conversion
     void handleSaleConversionError(const QString &message, ApiStatus status); // Add error handler
 
-private:
-
-    QList<Sale> m_sales;
-
-    bool m_hasCheckedItems;
+protected:
+    Fieldset listFieldset() const;
 
+    SaleApi* m_api;
+    QString m_status;
+    QString m_paymentStatus;
+    QString m_type; // Add type field
+    QStringList m_visibleRoles;
+    // The records the edit forms were filled from, as the server sent them:
+    // updates only send what a form changed from its record.
+    QHash<int, Sale> m_editBases;
 
-    void setErrorMessage(const QString &message);
+private:
     Sale saleFromVariantMap(const QVariantMap &map) const;
     QVariantMap saleToVariantMap(const Sale &sale) const;
-    void updateHasCheckedItems();
 };
 
 } // namespace NetworkApi
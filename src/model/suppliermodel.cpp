@@ -4,16 +4,37 @@
 
 namespace NetworkApi {
 using namespace Qt::StringLiterals;
+namespace {
+
+using namespace ModelFields;
+
+constexpr ModelRole<Supplier> SupplierRoleTable[] = {
+    memberRole<&Supplier::id>(SupplierModel::IdRole, "id"),
+    memberRole<&Supplier::name>(SupplierModel::NameRole, "name"),
+    memberRole<&Supplier::email>(SupplierModel::EmailRole, "email"),
+    memberRole<&Supplier::phone>(SupplierModel::PhoneRole, "phone"),
+    memberRole<&Supplier::address>(SupplierModel::AddressRole, "address"),
+    memberRole<&Supplier::payment_terms>(SupplierModel::PaymentTermsRole, "paymentTerms"),
+    memberRole<&Supplier::tax_number>(SupplierModel::TaxNumberRole, "taxNumber"),
+    memberRole<&Supplier::notes>(SupplierModel::NotesRole, "notes"),
+    memberRole<&Supplier::status>(SupplierModel::StatusRole, "status"),
+    memberRole<&Supplier::balance>(SupplierModel::BalanceRole, "balance"),
+};
+
+constexpr ModelColumn<Supplier> SupplierColumns[] = {
+    memberColumn<&Supplier::id>(QT_TRANSLATE_NOOP("NetworkApi::SupplierModel", "ID")),
+    memberColumn<&Supplier::name>(QT_TRANSLATE_NOOP("NetworkApi::SupplierModel", "Name")),
+    memberColumn<&Supplier::email>(QT_TRANSLATE_NOOP("NetworkApi::SupplierModel", "Email")),
+    memberColumn<&Supplier::phone>(QT_TRANSLATE_NOOP("NetworkApi::SupplierModel", "Phone")),
+    memberColumn<&Supplier::status>(QT_TRANSLATE_NOOP("NetworkApi::SupplierModel", "Status")),
+};
+
+} // namespace
+
 SupplierModel::SupplierModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : PaginatedEntityModel<Supplier>(SupplierRoleTable, SupplierColumns, CheckedRole,
+                                     QStringLiteral("name"), QStringLiteral("asc"), parent)
     , m_api(nullptr)
-    , m_loading(false)
-    , m_totalItems(0)
-    , m_currentPage(1)
-    , m_totalPages(1)
-    , m_sortField(QStringLiteral("name"))
-    , m_sortDirection(QStringLiteral("asc"))
-    , m_hasCheckedItems(false)
 {
 }
 
@@ -33,103 +54,6 @@ void SupplierModel::setApi(SupplierApi* api)
      refresh();
 }
 
-int SupplierModel::rowCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return m_suppliers.count();
-}
-
-int SupplierModel::columnCount(const QModelIndex &parent) const
-{
-    if (parent.isValid())
-        return 0;
-    return 5; // Adjust based on your needs
-}
-
-QVariant SupplierModel::data(const QModelIndex &index, int role) const
-{
-    if (!index.isValid() || index.row() >= m_suppliers.count())
-        return QVariant();
-
-    const Supplier &supplier = m_suppliers.at(index.row());
-
-    if (role == Qt::DisplayRole || role == Qt::EditRole) {
-        switch (index.column()) {
-        case 0: return supplier.id;
-        case 1: return supplier.name;
-        case 2: return supplier.email;
-        case 3: return supplier.phone;
-        case 4: return supplier.status;
-        case 5: return supplier.balance;
-        }
-    } else {
-        switch (role) {
-        case IdRole: return supplier.id;
-        case NameRole: return supplier.name;
-        case EmailRole: return supplier.email;
-        case PhoneRole: return supplier.phone;
-        case AddressRole: return supplier.address;
-        case PaymentTermsRole: return supplier.payment_terms;
-        case TaxNumberRole: return supplier.tax_number;
-        case NotesRole: return supplier.notes;
-        case StatusRole: return supplier.status;
-        case BalanceRole: return supplier.balance;
-        case CheckedRole: return supplier.checked;
-        }
-    }
-
-    return QVariant();
-}
-
-QHash<int, QByteArray> SupplierModel::roleNames() const
-{
-    QHash<int, QByteArray> roles;
-    roles[IdRole] = "id";
-    roles[NameRole] = "name";
-    roles[EmailRole] = "email";
-    roles[PhoneRole] = "phone";
-    roles[AddressRole] = "address";
-    roles[PaymentTermsRole] = "paymentTerms";
-    roles[TaxNumberRole] = "taxNumber";
-    roles[NotesRole] = "notes";
-    roles[StatusRole] = "status";
-    roles[BalanceRole] = "balance";
-    roles[CheckedRole] = "checked";
-    return roles;
-}
-
-QVariant SupplierModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-    if (role != Qt::DisplayRole)
-        return QVariant();
-
-    if (orientation == Qt::Horizontal) {
-        switch (section) {
-        case 0: return tr("ID");
-        case 1: return tr("Name");
-        case 2: return tr("Email");
-        case 3: return tr("Phone");
-        case 4: return tr("Status");
-        case 5: return tr("Balance");
-        }
-    }
-    return QVariant();
-}
-
-bool SupplierModel::setData(const QModelIndex &index, const QVariant &value, int role)
-{
-    if (role == CheckedRole) {
-        if (index.isValid() && index.row() < m_suppliers.count()) {
-            m_suppliers[index.row()].checked = value.toBool();
-            Q_EMIT dataChanged(index, index, {role});
-            updateHasCheckedItems();
-            return true;
-        }
-    }
-    return false;
-}
-
 void SupplierModel::refresh()
 {
     if (!m_api)
@@ -139,15 +63,6 @@ void SupplierModel::refresh()
     m_api->getSuppliers(m_searchQuery, m_sortField, m_sortDirection, m_currentPage);
 }
 
-void SupplierModel::loadPage(int page)
-{
-    if (page != m_currentPage && page > 0 && page <= m_totalPages) {
-        m_currentPage = page;
-        Q_EMIT currentPageChanged();
-        refresh();
-    }
-}
-
 void SupplierModel::createSupplier(const QVariantMap &supplierData)
 {
     if (!m_api)
@@ -177,113 +92,16 @@ void SupplierModel::deleteSupplier(int id)
 
 QVariantMap SupplierModel::getSupplier(int row) const
 {
-    if (row < 0 || row >= m_suppliers.count())
+    if (row < 0 || row >= m_rows.count())
         return QVariantMap();
 
-    return supplierToVariantMap(m_suppliers.at(row));
-}
-
-// Selection methods
-void SupplierModel::setChecked(int row, bool checked)
-{
-    if (row >= 0 && row < m_suppliers.count()) {
-        m_suppliers[row].checked = checked;
-        QModelIndex index = createIndex(row, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-        updateHasCheckedItems();
-    }
-}
-
-QVariantList SupplierModel::getCheckedSupplierIds() const
-{
-    QVariantList checkedIds;
-    for (const auto &supplier : m_suppliers) {
-        if (supplier.checked) {
-            checkedIds.append(supplier.id);
-        }
-    }
-    return checkedIds;
-}
-
-void SupplierModel::clearAllChecked()
-{
-    for (int i = 0; i < m_suppliers.count(); ++i) {
-        if (m_suppliers[i].checked) {
-            m_suppliers[i].checked = false;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index, {CheckedRole});
-        }
-    }
-    updateHasCheckedItems();
-}
-
-void SupplierModel::toggleAllSuppliersChecked()
-{
-    bool allChecked = true;
-    for (const auto &supplier : m_suppliers) {
-        if (!supplier.checked) {
-            allChecked = false;
-            break;
-        }
-    }
-
-    for (int i = 0; i < m_suppliers.count(); ++i) {
-        m_suppliers[i].checked = !allChecked;
-        QModelIndex index = createIndex(i, 0);
-        Q_EMIT dataChanged(index, index, {CheckedRole});
-    }
-    updateHasCheckedItems();
-}
-
-// Slots
-void SupplierModel::setSortField(const QString &field)
-{
-    if (m_sortField != field) {
-        m_sortField = field;
-        Q_EMIT sortFieldChanged();
-        refresh();
-    }
-}
-
-void SupplierModel::setSortDirection(const QString &direction)
-{
-    if (m_sortDirection != direction) {
-        m_sortDirection = direction;
-        Q_EMIT sortDirectionChanged();
-        refresh();
-    }
-}
-
-void SupplierModel::setSearchQuery(const QString &query)
-{
-    if (m_searchQuery != query) {
-        m_searchQuery = query;
-        Q_EMIT searchQueryChanged();
-        refresh();
-    }
+    return supplierToVariantMap(m_rows.at(row));
 }
 
 // Private slots
 void SupplierModel::handleSuppliersReceived(const PaginatedSuppliers &suppliers)
 {
-    beginResetModel();
-    m_suppliers = suppliers.data;
-    endResetModel();
-
-    m_totalItems = suppliers.total;
-    Q_EMIT totalItemsChanged();
-
-    m_currentPage = suppliers.currentPage;
-    Q_EMIT currentPageChanged();
-
-    m_totalPages = suppliers.lastPage;
-    Q_EMIT totalPagesChanged();
-
-    setLoading(false);
-    setErrorMessage(QString());
-
-    updateHasCheckedItems();
-    Q_EMIT dataChanged(createIndex(0, 0), createIndex(rowCount() - 1, columnCount() - 1));
+    receivePage(suppliers);
 }
 
 void SupplierModel::handleSupplierError(const QString &message, ApiStatus status)
@@ -294,9 +112,7 @@ void SupplierModel::handleSupplierError(const QString &message, ApiStatus status
 
 void SupplierModel::handleSupplierCreated(const Supplier &supplier)
 {
-    beginInsertRows(QModelIndex(), m_suppliers.count(), m_suppliers.count());
-    m_suppliers.append(supplier);
-    endInsertRows();
+    appendEntity(supplier);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -305,14 +121,7 @@ void SupplierModel::handleSupplierCreated(const Supplier &supplier)
 
 void SupplierModel::handleSupplierUpdated(const Supplier &supplier)
 {
-    for (int i = 0; i < m_suppliers.count(); ++i) {
-        if (m_suppliers[i].id == supplier.id) {
-            m_suppliers[i] = supplier;
-            QModelIndex index = createIndex(i, 0);
-            Q_EMIT dataChanged(index, index);
-            break;
-        }
-    }
+    replaceEntity(supplier);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -321,14 +130,7 @@ void SupplierModel::handleSupplierUpdated(const Supplier &supplier)
 
 void SupplierModel::handleSupplierDeleted(int id)
 {
-    for (int i = 0; i < m_suppliers.count(); ++i) {
-        if (m_suppliers[i].id == id) {
-            beginRemoveRows(QModelIndex(), i, i);
-            m_suppliers.removeAt(i);
-            endRemoveRows();
-            break;
-        }
-    }
+    removeEntity(id);
 
     setLoading(false);
     setErrorMessage(QString());
@@ -336,22 +138,6 @@ void SupplierModel::handleSupplierDeleted(int id)
 }
 
 // Private methods
-void SupplierModel::setLoading(bool loading)
-{
-    if (m_loading != loading) {
-        m_loading = loading;
-        Q_EMIT loadingChanged();
-    }
-}
-
-void SupplierModel::setErrorMessage(const QString &message)
-{
-    if (m_errorMessage != message) {
-        m_errorMessage = message;
-        Q_EMIT errorMessageChanged();
-    }
-}
-
 Supplier SupplierModel::supplierFromVariantMap(const QVariantMap &map) const
 {
     Supplier supplier;
@@ -384,20 +170,4 @@ QVariantMap SupplierModel::supplierToVariantMap(const Supplier &supplier) const
     return map;
 }
 
-void SupplierModel::updateHasCheckedItems()
-{
-    bool hasChecked = false;
-    for (const auto &supplier : m_suppliers) {
-        if (supplier.checked) {
-            hasChecked = true;
-            break;
-        }
-    }
-
-    if (hasChecked != m_hasCheckedItems) {
-        m_hasCheckedItems = hasChecked;
-        Q_EMIT hasCheckedItemsChanged();
-    }
-}
-
 } // namespace NetworkApi